@@ -0,0 +1,230 @@
+// pthread_t n'est pas exposé en -std=c99 strict sans cela
+#define _POSIX_C_SOURCE 200112L
+
+#include "bench_framework.h"
+#include "cstash/concurrent_hashmap.h"
+#include "cstash/hashmap.h"
+#include <pthread.h>
+#include <stdio.h>
+
+// Travail total fixe, réparti entre les threads : le temps par op est l'inverse du débit global
+#define BENCH_KEYS (1u << 17)
+#define BENCH_GET_OPS (1u << 18)
+#define BENCH_ITERATIONS 20
+
+static char bench_keys[BENCH_KEYS][32];
+static size_t bench_threads = 1;
+
+// Référence : une CsHashMap derrière un unique mutex global
+typedef struct {
+    CsHashMap* map;
+    pthread_mutex_t lock;
+} LockedMap;
+
+typedef struct {
+    void* map;
+    size_t first;
+    size_t count;
+} Job;
+
+static void generate_keys(void) {
+    for (size_t i = 0; i < BENCH_KEYS; i++) {
+        snprintf(bench_keys[i], sizeof(bench_keys[i]), "key_%zu", i);
+    }
+}
+
+// Lance bench_threads threads sur des tranches égales de [0, total)
+static void run_threads(void* map, size_t total, void* (*worker)(void*)) {
+    pthread_t threads[64];
+    Job jobs[64];
+    size_t share = total / bench_threads;
+
+    for (size_t t = 0; t < bench_threads; t++) {
+        jobs[t] = (Job){map, t * share, share};
+        pthread_create(&threads[t], NULL, worker, &jobs[t]);
+    }
+    for (size_t t = 0; t < bench_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+}
+
+// ============================================================================
+// BENCHMARKS: CsConcurrentHashMap
+// ============================================================================
+
+void bench_concurrent_empty_setup(BenchContext* ctx) {
+    ctx->data = cs_concurrent_hashmap_create(sizeof(int));
+}
+
+static void fill_concurrent_map(CsConcurrentHashMap* map) {
+    for (size_t i = 0; i < BENCH_KEYS; i++) {
+        int value = (int)i;
+        cs_concurrent_hashmap_insert(map, bench_keys[i], &value);
+    }
+}
+
+void bench_concurrent_full_setup(BenchContext* ctx) {
+    CsConcurrentHashMap* map = cs_concurrent_hashmap_create(sizeof(int));
+    fill_concurrent_map(map);
+    ctx->data = map;
+}
+
+static CsConcurrentHashMap* create_lock_free_map(void) {
+    CsConcurrentHashMapOptions options = {.lock_free_reads = true};
+    return cs_concurrent_hashmap_create_with_options(sizeof(int), &options);
+}
+
+void bench_lock_free_empty_setup(BenchContext* ctx) {
+    ctx->data = create_lock_free_map();
+}
+
+void bench_lock_free_full_setup(BenchContext* ctx) {
+    CsConcurrentHashMap* map = create_lock_free_map();
+    fill_concurrent_map(map);
+    ctx->data = map;
+}
+
+static void* concurrent_get_worker(void* arg) {
+    Job* job = arg;
+    int value;
+    for (size_t i = job->first; i < job->first + job->count; i++) {
+        cs_concurrent_hashmap_get(job->map, bench_keys[(i * 7919) % BENCH_KEYS], &value);
+    }
+    return NULL;
+}
+
+static void* concurrent_insert_worker(void* arg) {
+    Job* job = arg;
+    for (size_t i = job->first; i < job->first + job->count; i++) {
+        int value = (int)i;
+        cs_concurrent_hashmap_insert(job->map, bench_keys[i], &value);
+    }
+    return NULL;
+}
+
+void bench_concurrent_get_bench(BenchContext* ctx) {
+    run_threads(ctx->data, ctx->ops_per_iteration, concurrent_get_worker);
+}
+
+void bench_concurrent_insert_bench(BenchContext* ctx) {
+    run_threads(ctx->data, ctx->ops_per_iteration, concurrent_insert_worker);
+}
+
+void bench_concurrent_teardown(BenchContext* ctx) {
+    cs_concurrent_hashmap_destroy(ctx->data);
+}
+
+// ============================================================================
+// BENCHMARKS: CsHashMap + mutex global
+// ============================================================================
+
+static LockedMap* locked_map_create(void) {
+    LockedMap* locked = malloc(sizeof(LockedMap));
+    locked->map = cs_hashmap_create(sizeof(int));
+    pthread_mutex_init(&locked->lock, NULL);
+    return locked;
+}
+
+void bench_locked_empty_setup(BenchContext* ctx) {
+    ctx->data = locked_map_create();
+}
+
+void bench_locked_full_setup(BenchContext* ctx) {
+    LockedMap* locked = locked_map_create();
+    for (size_t i = 0; i < BENCH_KEYS; i++) {
+        int value = (int)i;
+        cs_hashmap_insert(locked->map, bench_keys[i], &value);
+    }
+    ctx->data = locked;
+}
+
+static void* locked_get_worker(void* arg) {
+    Job* job = arg;
+    LockedMap* locked = job->map;
+    for (size_t i = job->first; i < job->first + job->count; i++) {
+        pthread_mutex_lock(&locked->lock);
+        volatile int* value = cs_hashmap_get(locked->map, bench_keys[(i * 7919) % BENCH_KEYS]);
+        (void)value;
+        pthread_mutex_unlock(&locked->lock);
+    }
+    return NULL;
+}
+
+static void* locked_insert_worker(void* arg) {
+    Job* job = arg;
+    LockedMap* locked = job->map;
+    for (size_t i = job->first; i < job->first + job->count; i++) {
+        int value = (int)i;
+        pthread_mutex_lock(&locked->lock);
+        cs_hashmap_insert(locked->map, bench_keys[i], &value);
+        pthread_mutex_unlock(&locked->lock);
+    }
+    return NULL;
+}
+
+void bench_locked_get_bench(BenchContext* ctx) {
+    run_threads(ctx->data, ctx->ops_per_iteration, locked_get_worker);
+}
+
+void bench_locked_insert_bench(BenchContext* ctx) {
+    run_threads(ctx->data, ctx->ops_per_iteration, locked_insert_worker);
+}
+
+void bench_locked_teardown(BenchContext* ctx) {
+    LockedMap* locked = ctx->data;
+    cs_hashmap_destroy(locked->map);
+    pthread_mutex_destroy(&locked->lock);
+    free(locked);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    generate_keys();
+
+    BenchDef benchmarks[] = {
+        {"concurrent get", bench_concurrent_full_setup, bench_concurrent_get_bench, bench_concurrent_teardown,
+         BENCH_ITERATIONS, BENCH_GET_OPS, BENCH_KEYS},
+
+        {"mutex + hashmap get", bench_locked_full_setup, bench_locked_get_bench, bench_locked_teardown,
+         BENCH_ITERATIONS, BENCH_GET_OPS, BENCH_KEYS},
+
+        {"lock-free get", bench_lock_free_full_setup, bench_concurrent_get_bench, bench_concurrent_teardown,
+         BENCH_ITERATIONS, BENCH_GET_OPS, BENCH_KEYS},
+
+        {"concurrent insert", bench_concurrent_empty_setup, bench_concurrent_insert_bench, bench_concurrent_teardown,
+         BENCH_ITERATIONS, BENCH_KEYS, BENCH_KEYS},
+
+        {"lock-free insert", bench_lock_free_empty_setup, bench_concurrent_insert_bench, bench_concurrent_teardown,
+         BENCH_ITERATIONS, BENCH_KEYS, BENCH_KEYS},
+
+        {"mutex + hashmap insert", bench_locked_empty_setup, bench_locked_insert_bench, bench_locked_teardown,
+         BENCH_ITERATIONS, BENCH_KEYS, BENCH_KEYS},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    // Même travail total de 1 à 64 threads : un temps par op qui baisse = un débit qui monte
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        for (bench_threads = 1; bench_threads <= 64; bench_threads *= 2) {
+            char name[64];
+            BenchDef def = benchmarks[i];
+            snprintf(name, sizeof(name), "%s (%zu thread%s)", def.name, bench_threads,
+                     bench_threads > 1 ? "s" : "");
+            def.name = name;
+
+            BenchResult result = bench_run(&def);
+            bench_print_result(&result);
+            printf("\n");
+        }
+    }
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
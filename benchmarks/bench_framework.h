@@ -1,6 +1,11 @@
 #ifndef BENCH_FRAMEWORK_H
 #define BENCH_FRAMEWORK_H
 
+// clock_gettime() n'est pas exposé en -std=c99 strict sans cela
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -0,0 +1,164 @@
+#include "bench_framework.h"
+#include "cstash/frozen_hashmap.h"
+#include "cstash/hashmap.h"
+#include <stdio.h>
+
+// ~1M entrées : les deux structures dépassent le dernier niveau de cache
+#define MAP_ENTRIES (1u << 20)
+#define LOOKUPS 1024
+#define FROZEN_FILE "bench_frozen_hashmap.tmp"
+
+static CsHashMap* source_map = NULL;
+static CsFrozenHashMap* frozen_map = NULL;
+static char lookup_keys[LOOKUPS][32];
+static volatile const void* lookup_sink;
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+static void generate_key(char* buffer, size_t index) {
+    snprintf(buffer, 32, "key_%zu", index);
+}
+
+static void build_maps(void) {
+    source_map = cs_hashmap_create(sizeof(int));
+    char key[32];
+    for (size_t i = 0; i < MAP_ENTRIES; i++) {
+        int value = (int)i;
+        generate_key(key, i);
+        cs_hashmap_insert(source_map, key, &value);
+    }
+    frozen_map = cs_hashmap_freeze(source_map);
+}
+
+// Mémoire de la map chaînée : tableau de buckets, tableau d'ordre et une allocation par entrée
+// (arrondie à 16 octets, plus l'en-tête de 8 octets de malloc)
+static size_t chained_memory(const CsHashMap* map) {
+    size_t total = map->capacity * sizeof(CsHashMapEntry*) + map->order_capacity * sizeof(CsHashMapEntry*);
+    for (size_t i = 0; i < map->order_len; i++) {
+        const CsHashMapEntry* entry = map->order[i];
+        if (entry) total += (sizeof(CsHashMapEntry) + map->value_size + entry->key_len + 1 + 8 + 15) & ~(size_t)15;
+    }
+    return total;
+}
+
+// Nouvelles clés aléatoires à chaque itération pour que le lot précédent ne chauffe pas le cache
+static void pick_keys(const char* prefix) {
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        snprintf(lookup_keys[i], sizeof(lookup_keys[i]), "%s_%zu", prefix, (size_t)(rng % MAP_ENTRIES));
+    }
+}
+
+void bench_hit_setup(BenchContext* ctx) {
+    (void)ctx;
+    pick_keys("key");
+}
+
+void bench_miss_setup(BenchContext* ctx) {
+    (void)ctx;
+    pick_keys("missing");
+}
+
+// ============================================================================
+// BENCHMARKS: recherche
+// ============================================================================
+
+void bench_hashmap_get_bench(BenchContext* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        lookup_sink = cs_hashmap_get(source_map, lookup_keys[i]);
+    }
+}
+
+void bench_frozen_get_bench(BenchContext* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        lookup_sink = cs_frozen_hashmap_get(frozen_map, lookup_keys[i]);
+    }
+}
+
+// ============================================================================
+// BENCHMARKS: construction
+// ============================================================================
+
+void bench_freeze_bench(BenchContext* ctx) {
+    (void)ctx;
+    cs_frozen_hashmap_destroy(cs_hashmap_freeze(source_map));
+}
+
+// ============================================================================
+// BENCHMARKS: démarrage à froid (reconstruction vs fichier projeté)
+// ============================================================================
+
+void bench_rebuild_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    char key[32];
+    for (size_t i = 0; i < MAP_ENTRIES; i++) {
+        int value = (int)i;
+        generate_key(key, i);
+        cs_hashmap_insert(map, key, &value);
+    }
+    lookup_sink = cs_hashmap_get(map, "key_42");
+    cs_hashmap_destroy(map);
+}
+
+// Ouverture, une recherche puis fermeture : seules les pages touchées sont chargées
+void bench_open_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsFrozenHashMap* opened = cs_frozen_hashmap_open(FROZEN_FILE, NULL);
+    lookup_sink = cs_frozen_hashmap_get(opened, "key_42");
+    cs_frozen_hashmap_destroy(opened);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    build_maps();
+    cs_frozen_hashmap_save(frozen_map, FROZEN_FILE);
+
+    BenchDef benchmarks[] = {
+        {"cs_hashmap_get (hit, 1M entries)", bench_hit_setup, bench_hashmap_get_bench, NULL, 100, LOOKUPS,
+         MAP_ENTRIES},
+
+        {"cs_frozen_hashmap_get (hit, 1M entries)", bench_hit_setup, bench_frozen_get_bench, NULL, 100, LOOKUPS,
+         MAP_ENTRIES},
+
+        {"cs_hashmap_get (miss, 1M entries)", bench_miss_setup, bench_hashmap_get_bench, NULL, 100, LOOKUPS,
+         MAP_ENTRIES},
+
+        {"cs_frozen_hashmap_get (miss, 1M entries)", bench_miss_setup, bench_frozen_get_bench, NULL, 100, LOOKUPS,
+         MAP_ENTRIES},
+
+        {"cs_hashmap_freeze (1M entries)", NULL, bench_freeze_bench, NULL, 3, MAP_ENTRIES, MAP_ENTRIES},
+
+        {"cold start: cs_hashmap_insert (1M entries)", NULL, bench_rebuild_bench, NULL, 3, 1, MAP_ENTRIES},
+
+        {"cold start: cs_frozen_hashmap_open (1M entries)", NULL, bench_open_bench, NULL, 100, 1, MAP_ENTRIES},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        BenchResult result = bench_run(&benchmarks[i]);
+        bench_print_result(&result);
+        printf("\n");
+    }
+
+    printf("Memory (1M entries): chained hashmap ~%zu bytes, frozen hashmap %zu bytes\n\n",
+           chained_memory(source_map), frozen_map->blob_size);
+
+    cs_frozen_hashmap_destroy(frozen_map);
+    cs_hashmap_destroy(source_map);
+    remove(FROZEN_FILE);
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
@@ -83,8 +83,9 @@ void bench_hashmap_get_hit_bench(BenchContext* ctx) {
     CsHashMap* map = (CsHashMap*)ctx->data;
     char key[32];
 
+    generate_key(key, 50); // Clé existante
+
     for (size_t i = 0; i < ctx->ops_per_iteration; i++) {
-        generate_key(key, 50); // Clé existante
         volatile int* value = (int*)cs_hashmap_get(map, key);
         (void)value;
     }
@@ -115,8 +116,9 @@ void bench_hashmap_get_miss_bench(BenchContext* ctx) {
     CsHashMap* map = (CsHashMap*)ctx->data;
     char key[32];
 
+    generate_key(key, 9999); // Clé inexistante
+
     for (size_t i = 0; i < ctx->ops_per_iteration; i++) {
-        generate_key(key, 9999); // Clé inexistante
         volatile int* value = (int*)cs_hashmap_get(map, key);
         (void)value;
     }
@@ -126,6 +128,50 @@ void bench_hashmap_get_miss_teardown(BenchContext* ctx) {
     cs_hashmap_destroy((CsHashMap*)ctx->data);
 }
 
+// ============================================================================
+// BENCHMARKS: cs_hashmap_get (swiss engine)
+// ============================================================================
+
+void bench_hashmap_swiss_setup(BenchContext* ctx) {
+    CsHashMapOptions options = {.engine = CS_HASHMAP_SWISS};
+    CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+    char key[32];
+
+    for (int i = 0; i < 100; i++) {
+        generate_key(key, i);
+        cs_hashmap_insert(map, key, &i);
+    }
+
+    ctx->data = map;
+}
+
+void bench_hashmap_swiss_insert_setup(BenchContext* ctx) {
+    CsHashMapOptions options = {.engine = CS_HASHMAP_SWISS};
+    ctx->data = cs_hashmap_create_with_options(sizeof(int), &options);
+}
+
+// ============================================================================
+// BENCHMARKS: cs_hashmap_get (robin hood engine)
+// ============================================================================
+
+void bench_hashmap_robin_hood_setup(BenchContext* ctx) {
+    CsHashMapOptions options = {.engine = CS_HASHMAP_ROBIN_HOOD};
+    CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+    char key[32];
+
+    for (int i = 0; i < 100; i++) {
+        generate_key(key, i);
+        cs_hashmap_insert(map, key, &i);
+    }
+
+    ctx->data = map;
+}
+
+void bench_hashmap_robin_hood_insert_setup(BenchContext* ctx) {
+    CsHashMapOptions options = {.engine = CS_HASHMAP_ROBIN_HOOD};
+    ctx->data = cs_hashmap_create_with_options(sizeof(int), &options);
+}
+
 // ============================================================================
 // BENCHMARKS: cs_hashmap_has (hit)
 // ============================================================================
@@ -146,8 +192,9 @@ void bench_hashmap_has_hit_bench(BenchContext* ctx) {
     CsHashMap* map = (CsHashMap*)ctx->data;
     char key[32];
 
+    generate_key(key, 50);
+
     for (size_t i = 0; i < ctx->ops_per_iteration; i++) {
-        generate_key(key, 50);
         volatile bool exists = cs_hashmap_has(map, key);
         (void)exists;
     }
@@ -195,6 +242,35 @@ void bench_hashmap_remove_teardown(BenchContext* ctx) {
     free(maps);
 }
 
+// ============================================================================
+// BENCHMARKS: cs_hashmap_take vs get + memcpy + remove (mêmes maps que remove)
+// ============================================================================
+
+void bench_hashmap_get_remove_bench(BenchContext* ctx) {
+    CsHashMap** maps = (CsHashMap**)ctx->data;
+    char key[32];
+    volatile int out;
+
+    for (size_t i = 0; i < ctx->ops_per_iteration; i++) {
+        generate_key(key, 50);
+        int* value = cs_hashmap_get(maps[i], key);
+        if (value) out = *value;
+        cs_hashmap_remove(maps[i], key);
+    }
+    (void)out;
+}
+
+void bench_hashmap_take_bench(BenchContext* ctx) {
+    CsHashMap** maps = (CsHashMap**)ctx->data;
+    char key[32];
+    int out;
+
+    for (size_t i = 0; i < ctx->ops_per_iteration; i++) {
+        generate_key(key, 50);
+        cs_hashmap_take(maps[i], key, &out);
+    }
+}
+
 // ============================================================================
 // BENCHMARKS: cs_hashmap_clear
 // ============================================================================
@@ -267,6 +343,313 @@ void bench_hashmap_resize_teardown(BenchContext* ctx) {
     free(maps);
 }
 
+// ============================================================================
+// BENCHMARKS: latence d'insertion (resize complet vs incrémental)
+// ============================================================================
+
+// Une seule map partagée entre les itérations : chaque mesure est une insertion, le max révèle les resize
+#define LATENCY_INSERTS 200000
+
+static CsHashMap* latency_map = NULL;
+static size_t latency_counter = 0;
+
+void bench_hashmap_latency_setup(BenchContext* ctx) {
+    (void)ctx;
+    if (!latency_map) latency_map = cs_hashmap_create(sizeof(int));
+}
+
+void bench_hashmap_latency_incremental_setup(BenchContext* ctx) {
+    (void)ctx;
+    CsHashMapOptions options = {.incremental = true};
+    if (!latency_map) latency_map = cs_hashmap_create_with_options(sizeof(int), &options);
+}
+
+void bench_hashmap_latency_bench(BenchContext* ctx) {
+    (void)ctx;
+    char key[32];
+    int value = 42;
+
+    generate_key(key, latency_counter++);
+    cs_hashmap_insert(latency_map, key, &value);
+}
+
+void bench_hashmap_latency_teardown(BenchContext* ctx) {
+    (void)ctx;
+    if (latency_counter == LATENCY_INSERTS) {
+        cs_hashmap_destroy(latency_map);
+        latency_map = NULL;
+        latency_counter = 0;
+    }
+}
+
+// ============================================================================
+// BENCHMARKS: fonctions de hash selon la longueur de clé
+// ============================================================================
+
+static void bench_hash_key_setup(BenchContext* ctx, size_t key_len) {
+    char* key = malloc(key_len);
+    for (size_t i = 0; i < key_len; i++) {
+        key[i] = (char)('a' + i % 26);
+    }
+    ctx->data = key;
+    ctx->data_size = key_len;
+}
+
+void bench_hash_key16_setup(BenchContext* ctx) {
+    bench_hash_key_setup(ctx, 16);
+}
+
+void bench_hash_key48_setup(BenchContext* ctx) {
+    bench_hash_key_setup(ctx, 48);
+}
+
+void bench_hash_key80_setup(BenchContext* ctx) {
+    bench_hash_key_setup(ctx, 80);
+}
+
+static void bench_hash_run(BenchContext* ctx, CsHashFunction hash) {
+    for (size_t i = 0; i < ctx->ops_per_iteration; i++) {
+        volatile uint64_t h = hash(ctx->data, ctx->data_size);
+        (void)h;
+    }
+}
+
+void bench_hash_fnv1a_bench(BenchContext* ctx) {
+    bench_hash_run(ctx, cs_hash_fnv1a);
+}
+
+void bench_hash_wy_bench(BenchContext* ctx) {
+    bench_hash_run(ctx, cs_hash_wy);
+}
+
+void bench_hash_crc32c_bench(BenchContext* ctx) {
+    bench_hash_run(ctx, cs_hash_crc32c);
+}
+
+void bench_hash_key_teardown(BenchContext* ctx) {
+    free(ctx->data);
+}
+
+// ============================================================================
+// BENCHMARKS: parcours complet
+// ============================================================================
+
+#define ITER_ENTRIES 10000
+
+void bench_hashmap_iter_setup(BenchContext* ctx) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    char key[32];
+
+    for (int i = 0; i < ITER_ENTRIES; i++) {
+        generate_key(key, i);
+        cs_hashmap_insert(map, key, &i);
+    }
+    // Une entrée sur quatre supprimée : des trous dans l'ordre d'insertion
+    for (int i = 0; i < ITER_ENTRIES; i += 4) {
+        generate_key(key, i);
+        cs_hashmap_remove(map, key);
+    }
+
+    ctx->data = map;
+}
+
+void bench_hashmap_iter_bench(BenchContext* ctx) {
+    CsHashMapIter iter = cs_hashmap_iter_begin(ctx->data);
+    void* value;
+    volatile int sum = 0;
+
+    while (cs_hashmap_iter_next(&iter, NULL, NULL, &value)) {
+        sum += *(int*)value;
+    }
+}
+
+// Parcours direct des buckets, comme le faisait le code client avant l'itérateur
+void bench_hashmap_bucket_walk_bench(BenchContext* ctx) {
+    CsHashMap* map = ctx->data;
+    volatile int sum = 0;
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        for (CsHashMapEntry* entry = map->buckets[i]; entry; entry = entry->next) {
+            sum += *(int*)entry->data;
+        }
+    }
+}
+
+// ============================================================================
+// BENCHMARKS: compteurs (get + insert vs get_or_insert)
+// ============================================================================
+
+// 64 mots distincts répétés : la majorité des mises à jour tombent sur une clé existante
+#define COUNTER_WORDS 64
+
+typedef struct {
+    CsHashMap* map;
+    char words[COUNTER_WORDS][32];
+} CounterData;
+
+void bench_hashmap_counter_setup(BenchContext* ctx) {
+    CounterData* data = malloc(sizeof(CounterData));
+    data->map = cs_hashmap_create(sizeof(int));
+    for (size_t i = 0; i < COUNTER_WORDS; i++) {
+        generate_key(data->words[i], i);
+    }
+    ctx->data = data;
+}
+
+void bench_hashmap_counter_get_insert_bench(BenchContext* ctx) {
+    CounterData* data = ctx->data;
+    for (size_t i = 0; i < ctx->ops_per_iteration; i++) {
+        const char* word = data->words[i % COUNTER_WORDS];
+        int* count = cs_hashmap_get(data->map, word);
+        if (count) {
+            (*count)++;
+        } else {
+            cs_hashmap_insert(data->map, word, &(int){1});
+        }
+    }
+}
+
+void bench_hashmap_counter_get_or_insert_bench(BenchContext* ctx) {
+    CounterData* data = ctx->data;
+    for (size_t i = 0; i < ctx->ops_per_iteration; i++) {
+        int* count = cs_hashmap_get_or_insert(data->map, data->words[i % COUNTER_WORDS], NULL, NULL);
+        (*count)++;
+    }
+}
+
+void bench_hashmap_counter_teardown(BenchContext* ctx) {
+    CounterData* data = ctx->data;
+    cs_hashmap_destroy(data->map);
+    free(data);
+}
+
+// ============================================================================
+// BENCHMARKS: lookups par lot sur une map bien plus grande que le cache
+// ============================================================================
+
+// ~2M entrées : buckets et entrées dépassent largement le dernier niveau de cache
+#define LARGE_MAP_ENTRIES (1u << 21)
+#define LARGE_LOOKUPS 1024
+
+static CsHashMap* large_chained_map = NULL;
+static CsHashMap* large_swiss_map = NULL;
+static char large_keys[LARGE_LOOKUPS][32];
+static const char* large_key_ptrs[LARGE_LOOKUPS];
+static void* large_values[LARGE_LOOKUPS];
+static uint64_t large_rng = 0x9E3779B97F4A7C15ULL;
+
+static CsHashMap* bench_large_map(CsHashMapEngine engine) {
+    CsHashMapOptions options = {.engine = engine};
+    CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+    char key[32];
+    for (size_t i = 0; i < LARGE_MAP_ENTRIES; i++) {
+        int value = (int)i;
+        generate_key(key, i);
+        cs_hashmap_insert(map, key, &value);
+    }
+    return map;
+}
+
+// Nouvelles clés aléatoires à chaque itération pour que le lot précédent ne chauffe pas le cache
+static void bench_large_pick_keys(BenchContext* ctx, CsHashMap* map) {
+    for (size_t i = 0; i < LARGE_LOOKUPS; i++) {
+        large_rng ^= large_rng << 13;
+        large_rng ^= large_rng >> 7;
+        large_rng ^= large_rng << 17;
+        generate_key(large_keys[i], large_rng % LARGE_MAP_ENTRIES);
+        large_key_ptrs[i] = large_keys[i];
+    }
+    ctx->data = map;
+}
+
+void bench_large_chained_setup(BenchContext* ctx) {
+    if (!large_chained_map) large_chained_map = bench_large_map(CS_HASHMAP_CHAINED);
+    bench_large_pick_keys(ctx, large_chained_map);
+}
+
+void bench_large_swiss_setup(BenchContext* ctx) {
+    if (!large_swiss_map) large_swiss_map = bench_large_map(CS_HASHMAP_SWISS);
+    bench_large_pick_keys(ctx, large_swiss_map);
+}
+
+void bench_large_get_loop_bench(BenchContext* ctx) {
+    CsHashMap* map = ctx->data;
+    for (size_t i = 0; i < LARGE_LOOKUPS; i++) {
+        large_values[i] = cs_hashmap_get(map, large_key_ptrs[i]);
+    }
+}
+
+void bench_large_get_batch_bench(BenchContext* ctx) {
+    cs_hashmap_get_batch(ctx->data, large_key_ptrs, LARGE_LOOKUPS, large_values);
+}
+
+static void bench_large_cleanup(void) {
+    cs_hashmap_destroy(large_chained_map);
+    cs_hashmap_destroy(large_swiss_map);
+    large_chained_map = NULL;
+    large_swiss_map = NULL;
+}
+
+// ============================================================================
+// BENCHMARKS: construction en masse
+// ============================================================================
+
+#define BULK_ENTRIES (1u << 18)
+
+static char bulk_key_storage[BULK_ENTRIES][32];
+static const char* bulk_keys[BULK_ENTRIES];
+static int bulk_values[BULK_ENTRIES];
+
+void bench_bulk_setup(BenchContext* ctx) {
+    (void)ctx;
+    if (bulk_keys[0]) return;
+    for (size_t i = 0; i < BULK_ENTRIES; i++) {
+        generate_key(bulk_key_storage[i], i);
+        bulk_keys[i] = bulk_key_storage[i];
+        bulk_values[i] = (int)i;
+    }
+}
+
+static void bench_insert_all(CsHashMap* map) {
+    for (size_t i = 0; i < BULK_ENTRIES; i++) {
+        cs_hashmap_insert(map, bulk_keys[i], &bulk_values[i]);
+    }
+    cs_hashmap_destroy(map);
+}
+
+// Sans indication : log2(256k / 8) redimensionnements complets
+void bench_bulk_insert_loop_bench(BenchContext* ctx) {
+    (void)ctx;
+    bench_insert_all(cs_hashmap_create(sizeof(int)));
+}
+
+// Capacité connue à la création : aucun redimensionnement
+void bench_bulk_insert_with_capacity_bench(BenchContext* ctx) {
+    (void)ctx;
+    bench_insert_all(cs_hashmap_create_with_capacity(sizeof(int), BULK_ENTRIES));
+}
+
+void bench_bulk_create_from_bench(BenchContext* ctx) {
+    (void)ctx;
+    cs_hashmap_destroy(cs_hashmap_create_from(sizeof(int), bulk_keys, bulk_values, BULK_ENTRIES));
+}
+
+static void bench_bulk_with(const CsHashMapBulkOptions* options) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    cs_hashmap_insert_bulk(map, bulk_keys, bulk_values, BULK_ENTRIES, options);
+    cs_hashmap_destroy(map);
+}
+
+void bench_bulk_unique_bench(BenchContext* ctx) {
+    (void)ctx;
+    bench_bulk_with(&(CsHashMapBulkOptions){.unique = true});
+}
+
+void bench_bulk_unique_threads_bench(BenchContext* ctx) {
+    (void)ctx;
+    bench_bulk_with(&(CsHashMapBulkOptions){.unique = true, .threads = 4});
+}
+
 // ============================================================================
 // MAIN
 // ============================================================================
@@ -290,17 +673,114 @@ int main(void) {
         {"cs_hashmap_get (miss)", bench_hashmap_get_miss_setup, bench_hashmap_get_miss_bench,
          bench_hashmap_get_miss_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
 
+        {"cs_hashmap_insert (swiss)", bench_hashmap_swiss_insert_setup, bench_hashmap_insert_bench,
+         bench_hashmap_insert_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 0},
+
+        {"cs_hashmap_get (hit, swiss)", bench_hashmap_swiss_setup, bench_hashmap_get_hit_bench,
+         bench_hashmap_get_hit_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
+
+        {"cs_hashmap_get (miss, swiss)", bench_hashmap_swiss_setup, bench_hashmap_get_miss_bench,
+         bench_hashmap_get_miss_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
+
+        {"cs_hashmap_insert (robin hood)", bench_hashmap_robin_hood_insert_setup, bench_hashmap_insert_bench,
+         bench_hashmap_insert_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 0},
+
+        {"cs_hashmap_get (hit, robin hood)", bench_hashmap_robin_hood_setup, bench_hashmap_get_hit_bench,
+         bench_hashmap_get_hit_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
+
+        {"cs_hashmap_get (miss, robin hood)", bench_hashmap_robin_hood_setup, bench_hashmap_get_miss_bench,
+         bench_hashmap_get_miss_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
+
         {"cs_hashmap_has (hit)", bench_hashmap_has_hit_setup, bench_hashmap_has_hit_bench,
          bench_hashmap_has_hit_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
 
         {"cs_hashmap_remove", bench_hashmap_remove_setup, bench_hashmap_remove_bench, bench_hashmap_remove_teardown,
          BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
 
+        {"cs_hashmap_get + remove", bench_hashmap_remove_setup, bench_hashmap_get_remove_bench,
+         bench_hashmap_remove_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
+
+        {"cs_hashmap_take", bench_hashmap_remove_setup, bench_hashmap_take_bench, bench_hashmap_remove_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
+
         {"cs_hashmap_clear", bench_hashmap_clear_setup, bench_hashmap_clear_bench, bench_hashmap_clear_teardown,
          BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 100},
 
         {"cs_hashmap_resize", bench_hashmap_resize_setup, bench_hashmap_resize_bench, bench_hashmap_resize_teardown,
          BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 50},
+
+        {"cs_hashmap_insert latency (full resize)", bench_hashmap_latency_setup, bench_hashmap_latency_bench,
+         bench_hashmap_latency_teardown, LATENCY_INSERTS, 1, LATENCY_INSERTS},
+
+        {"cs_hashmap_insert latency (incremental)", bench_hashmap_latency_incremental_setup,
+         bench_hashmap_latency_bench, bench_hashmap_latency_teardown, LATENCY_INSERTS, 1, LATENCY_INSERTS},
+
+        {"cs_hash_fnv1a (16 bytes)", bench_hash_key16_setup, bench_hash_fnv1a_bench, bench_hash_key_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 16},
+
+        {"cs_hash_wy (16 bytes)", bench_hash_key16_setup, bench_hash_wy_bench, bench_hash_key_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 16},
+
+        {"cs_hash_crc32c (16 bytes)", bench_hash_key16_setup, bench_hash_crc32c_bench, bench_hash_key_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 16},
+
+        {"cs_hash_fnv1a (48 bytes)", bench_hash_key48_setup, bench_hash_fnv1a_bench, bench_hash_key_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 48},
+
+        {"cs_hash_wy (48 bytes)", bench_hash_key48_setup, bench_hash_wy_bench, bench_hash_key_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 48},
+
+        {"cs_hash_crc32c (48 bytes)", bench_hash_key48_setup, bench_hash_crc32c_bench, bench_hash_key_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 48},
+
+        {"cs_hash_fnv1a (80 bytes)", bench_hash_key80_setup, bench_hash_fnv1a_bench, bench_hash_key_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 80},
+
+        {"cs_hash_wy (80 bytes)", bench_hash_key80_setup, bench_hash_wy_bench, bench_hash_key_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 80},
+
+        {"cs_hash_crc32c (80 bytes)", bench_hash_key80_setup, bench_hash_crc32c_bench, bench_hash_key_teardown,
+         BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, 80},
+
+        {"cs_hashmap_iter (7.5k entries)", bench_hashmap_iter_setup, bench_hashmap_iter_bench,
+         bench_hashmap_get_hit_teardown, 100, 1, ITER_ENTRIES},
+
+        {"bucket walk (7.5k entries)", bench_hashmap_iter_setup, bench_hashmap_bucket_walk_bench,
+         bench_hashmap_get_hit_teardown, 100, 1, ITER_ENTRIES},
+
+        {"counter (cs_hashmap_get + insert)", bench_hashmap_counter_setup, bench_hashmap_counter_get_insert_bench,
+         bench_hashmap_counter_teardown, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_OPS_PER_ITERATION, COUNTER_WORDS},
+
+        {"counter (cs_hashmap_get_or_insert)", bench_hashmap_counter_setup,
+         bench_hashmap_counter_get_or_insert_bench, bench_hashmap_counter_teardown, BENCH_DEFAULT_ITERATIONS,
+         BENCH_DEFAULT_OPS_PER_ITERATION, COUNTER_WORDS},
+
+        {"cs_hashmap_get loop (2M entries)", bench_large_chained_setup, bench_large_get_loop_bench, NULL, 100,
+         LARGE_LOOKUPS, LARGE_MAP_ENTRIES},
+
+        {"cs_hashmap_get_batch (2M entries)", bench_large_chained_setup, bench_large_get_batch_bench, NULL, 100,
+         LARGE_LOOKUPS, LARGE_MAP_ENTRIES},
+
+        {"cs_hashmap_get loop (2M entries, swiss)", bench_large_swiss_setup, bench_large_get_loop_bench, NULL, 100,
+         LARGE_LOOKUPS, LARGE_MAP_ENTRIES},
+
+        {"cs_hashmap_get_batch (2M entries, swiss)", bench_large_swiss_setup, bench_large_get_batch_bench, NULL,
+         100, LARGE_LOOKUPS, LARGE_MAP_ENTRIES},
+
+        {"cs_hashmap_insert loop (256k entries)", bench_bulk_setup, bench_bulk_insert_loop_bench, NULL, 10,
+         BULK_ENTRIES, BULK_ENTRIES},
+
+        {"cs_hashmap_insert loop, with capacity (256k entries)", bench_bulk_setup,
+         bench_bulk_insert_with_capacity_bench, NULL, 10, BULK_ENTRIES, BULK_ENTRIES},
+
+        {"cs_hashmap_create_from (256k entries)", bench_bulk_setup, bench_bulk_create_from_bench, NULL, 10,
+         BULK_ENTRIES, BULK_ENTRIES},
+
+        {"cs_hashmap_insert_bulk unique (256k entries)", bench_bulk_setup, bench_bulk_unique_bench, NULL, 10,
+         BULK_ENTRIES, BULK_ENTRIES},
+
+        {"cs_hashmap_insert_bulk unique, 4 threads (256k entries)", bench_bulk_setup, bench_bulk_unique_threads_bench,
+         NULL, 10, BULK_ENTRIES, BULK_ENTRIES},
     };
 
     size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
@@ -312,6 +792,8 @@ int main(void) {
         printf("\n");
     }
 
+    bench_large_cleanup();
+
     BENCH_SUMMARY();
 
     return 0;
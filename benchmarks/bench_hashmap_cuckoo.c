@@ -0,0 +1,154 @@
+#include "bench_framework.h"
+#include "cstash/hashmap.h"
+#include <stdio.h>
+
+// ~1M entrées : les tables dépassent le dernier niveau de cache, chaque sondage coûte un accès mémoire
+#define MAP_ENTRIES (1u << 20)
+#define LOOKUPS 1024
+#define LATENCY_SAMPLES 200000
+
+static CsHashMap* chained_map = NULL;
+static CsHashMap* cuckoo_map = NULL;
+static char lookup_keys[LOOKUPS][32];
+static volatile const void* lookup_sink;
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+static void generate_key(char* buffer, size_t index) {
+    snprintf(buffer, 32, "key_%zu", index);
+}
+
+static void build_maps(void) {
+    chained_map = cs_hashmap_create(sizeof(int));
+    CsHashMapOptions options = {.engine = CS_HASHMAP_CUCKOO};
+    cuckoo_map = cs_hashmap_create_with_options(sizeof(int), &options);
+
+    char key[32];
+    for (size_t i = 0; i < MAP_ENTRIES; i++) {
+        int value = (int)i;
+        generate_key(key, i);
+        cs_hashmap_insert(chained_map, key, &value);
+        cs_hashmap_insert(cuckoo_map, key, &value);
+    }
+}
+
+static size_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (size_t)(rng % MAP_ENTRIES);
+}
+
+// Nouvelles clés aléatoires à chaque itération pour que le lot précédent ne chauffe pas le cache
+static void pick_keys(const char* prefix) {
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        snprintf(lookup_keys[i], sizeof(lookup_keys[i]), "%s_%zu", prefix, next_random());
+    }
+}
+
+void bench_hit_setup(BenchContext* ctx) {
+    (void)ctx;
+    pick_keys("key");
+}
+
+void bench_miss_setup(BenchContext* ctx) {
+    (void)ctx;
+    pick_keys("missing");
+}
+
+// ============================================================================
+// BENCHMARKS: débit des recherches
+// ============================================================================
+
+void bench_chained_get_bench(BenchContext* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        lookup_sink = cs_hashmap_get(chained_map, lookup_keys[i]);
+    }
+}
+
+void bench_cuckoo_get_bench(BenchContext* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        lookup_sink = cs_hashmap_get(cuckoo_map, lookup_keys[i]);
+    }
+}
+
+// ============================================================================
+// Percentiles de latence, une recherche par mesure
+// ============================================================================
+
+static uint64_t latency_samples[LATENCY_SAMPLES];
+
+// Coût d'une paire de lectures d'horloge, retranché de chaque mesure
+static uint64_t timer_overhead(void) {
+    for (size_t i = 0; i < LATENCY_SAMPLES; i++) {
+        uint64_t start = bench_get_time_ns();
+        latency_samples[i] = bench_get_time_ns() - start;
+    }
+    qsort(latency_samples, LATENCY_SAMPLES, sizeof(uint64_t), compare_uint64);
+    return latency_samples[LATENCY_SAMPLES / 2];
+}
+
+static void print_latency_percentiles(const char* name, const CsHashMap* map, const char* prefix, uint64_t overhead) {
+    char key[32];
+    for (size_t i = 0; i < LATENCY_SAMPLES; i++) {
+        snprintf(key, sizeof(key), "%s_%zu", prefix, next_random());
+        uint64_t start = bench_get_time_ns();
+        lookup_sink = cs_hashmap_get(map, key);
+        uint64_t elapsed = bench_get_time_ns() - start;
+        latency_samples[i] = elapsed > overhead ? elapsed - overhead : 0;
+    }
+    qsort(latency_samples, LATENCY_SAMPLES, sizeof(uint64_t), compare_uint64);
+
+    printf("%-32s p50 %4llu ns | p90 %4llu ns | p99 %4llu ns | p99.9 %5llu ns\n", name,
+           (unsigned long long)latency_samples[LATENCY_SAMPLES / 2],
+           (unsigned long long)latency_samples[LATENCY_SAMPLES * 90 / 100],
+           (unsigned long long)latency_samples[LATENCY_SAMPLES * 99 / 100],
+           (unsigned long long)latency_samples[LATENCY_SAMPLES * 999 / 1000]);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    build_maps();
+
+    BenchDef benchmarks[] = {
+        {"cs_hashmap_get (hit, chained)", bench_hit_setup, bench_chained_get_bench, NULL, 100, LOOKUPS, MAP_ENTRIES},
+
+        {"cs_hashmap_get (hit, cuckoo)", bench_hit_setup, bench_cuckoo_get_bench, NULL, 100, LOOKUPS, MAP_ENTRIES},
+
+        {"cs_hashmap_get (miss, chained)", bench_miss_setup, bench_chained_get_bench, NULL, 100, LOOKUPS,
+         MAP_ENTRIES},
+
+        {"cs_hashmap_get (miss, cuckoo)", bench_miss_setup, bench_cuckoo_get_bench, NULL, 100, LOOKUPS, MAP_ENTRIES},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        BenchResult result = bench_run(&benchmarks[i]);
+        bench_print_result(&result);
+        printf("\n");
+    }
+
+    uint64_t overhead = timer_overhead();
+    printf("Latency per lookup (1M entries, %d samples, timer overhead %llu ns removed):\n", LATENCY_SAMPLES,
+           (unsigned long long)overhead);
+    print_latency_percentiles("cs_hashmap_get (hit, chained)", chained_map, "key", overhead);
+    print_latency_percentiles("cs_hashmap_get (hit, cuckoo)", cuckoo_map, "key", overhead);
+    print_latency_percentiles("cs_hashmap_get (miss, chained)", chained_map, "missing", overhead);
+    print_latency_percentiles("cs_hashmap_get (miss, cuckoo)", cuckoo_map, "missing", overhead);
+    printf("Cuckoo load factor: %.2f\n\n", (double)cuckoo_map->size / (double)cuckoo_map->capacity);
+
+    cs_hashmap_destroy(chained_map);
+    cs_hashmap_destroy(cuckoo_map);
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "bench_framework.h"
+#include "cstash/hashmap.h"
+#include <stdio.h>
+
+// Table robin hood de 1M slots remplie à 0.9, la map chaînée reçoit les mêmes clés à son propre load factor
+#define MAP_SLOTS (1u << 20)
+#define MAP_ENTRIES ((size_t)(MAP_SLOTS * HASHMAP_ROBIN_HOOD_MAX_LOAD_FACTOR) - 1)
+#define LOOKUPS 1024
+#define MAX_PROBES 256
+
+static CsHashMap* chained_map = NULL;
+static CsHashMap* robin_hood_map = NULL;
+static char lookup_keys[LOOKUPS][32];
+static volatile const void* lookup_sink;
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+static void generate_key(char* buffer, size_t index) {
+    snprintf(buffer, 32, "key_%zu", index);
+}
+
+static void build_maps(void) {
+    chained_map = cs_hashmap_create(sizeof(int));
+    CsHashMapOptions options = {.engine = CS_HASHMAP_ROBIN_HOOD};
+    robin_hood_map = cs_hashmap_create_with_options(sizeof(int), &options);
+    cs_hashmap_resize(robin_hood_map, MAP_SLOTS);
+
+    char key[32];
+    for (size_t i = 0; i < MAP_ENTRIES; i++) {
+        int value = (int)i;
+        generate_key(key, i);
+        cs_hashmap_insert(chained_map, key, &value);
+        cs_hashmap_insert(robin_hood_map, key, &value);
+    }
+}
+
+// Nouvelles clés aléatoires à chaque itération pour que le lot précédent ne chauffe pas le cache
+static void pick_keys(const char* prefix) {
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        snprintf(lookup_keys[i], sizeof(lookup_keys[i]), "%s_%zu", prefix, (size_t)(rng % MAP_ENTRIES));
+    }
+}
+
+void bench_hit_setup(BenchContext* ctx) {
+    (void)ctx;
+    pick_keys("key");
+}
+
+void bench_miss_setup(BenchContext* ctx) {
+    (void)ctx;
+    pick_keys("missing");
+}
+
+// ============================================================================
+// BENCHMARKS: recherche à forte charge
+// ============================================================================
+
+void bench_chained_get_bench(BenchContext* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        lookup_sink = cs_hashmap_get(chained_map, lookup_keys[i]);
+    }
+}
+
+void bench_robin_hood_get_bench(BenchContext* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        lookup_sink = cs_hashmap_get(robin_hood_map, lookup_keys[i]);
+    }
+}
+
+// ============================================================================
+// Longueurs de sondage des hits
+// ============================================================================
+
+// Histogramme des entrées visitées pour trouver chaque clé (position dans la chaîne, ou distance + 1)
+static void print_probe_lengths(const char* name, const size_t* histogram, size_t entries) {
+    size_t seen = 0;
+    size_t p50 = 0;
+    size_t p99 = 0;
+    size_t max = 0;
+    for (size_t probes = 1; probes < MAX_PROBES; probes++) {
+        if (!histogram[probes]) continue;
+        seen += histogram[probes];
+        if (!p50 && seen * 2 >= entries) p50 = probes;
+        if (!p99 && seen * 100 >= entries * 99) p99 = probes;
+        max = probes;
+    }
+    printf("%-12s probes per hit: p50 %zu | p99 %zu | max %zu\n", name, p50, p99, max);
+}
+
+static void report_probe_lengths(void) {
+    static size_t histogram[MAX_PROBES];
+
+    for (size_t i = 0; i < chained_map->capacity; i++) {
+        size_t position = 1;
+        for (CsHashMapEntry* entry = chained_map->buckets[i]; entry; entry = entry->next) {
+            histogram[position < MAX_PROBES ? position : MAX_PROBES - 1]++;
+            position++;
+        }
+    }
+    print_probe_lengths("chained", histogram, chained_map->size);
+
+    memset(histogram, 0, sizeof(histogram));
+    for (size_t i = 0; i < robin_hood_map->capacity; i++) {
+        if (robin_hood_map->ctrl[i]) histogram[robin_hood_map->ctrl[i]]++;
+    }
+    print_probe_lengths("robin hood", histogram, robin_hood_map->size);
+
+    // Entrées de même taille des deux côtés, sauf le pointeur next du chaînage
+    double chained_bytes = (double)(chained_map->capacity * sizeof(CsHashMapEntry*)) / (double)chained_map->size;
+    double robin_hood_bytes = (double)(robin_hood_map->capacity * (sizeof(CsHashMapEntry*) + 2)) /
+                              (double)robin_hood_map->size;
+    printf("Table bytes per entry: chained %.1f (load %.2f), robin hood %.1f (load %.2f)\n\n", chained_bytes,
+           (double)chained_map->size / (double)chained_map->capacity, robin_hood_bytes,
+           (double)robin_hood_map->size / (double)robin_hood_map->capacity);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    build_maps();
+
+    BenchDef benchmarks[] = {
+        {"cs_hashmap_get (hit, chained)", bench_hit_setup, bench_chained_get_bench, NULL, 100, LOOKUPS, MAP_ENTRIES},
+
+        {"cs_hashmap_get (hit, robin hood, load 0.9)", bench_hit_setup, bench_robin_hood_get_bench, NULL, 100,
+         LOOKUPS, MAP_ENTRIES},
+
+        {"cs_hashmap_get (miss, chained)", bench_miss_setup, bench_chained_get_bench, NULL, 100, LOOKUPS,
+         MAP_ENTRIES},
+
+        {"cs_hashmap_get (miss, robin hood, load 0.9)", bench_miss_setup, bench_robin_hood_get_bench, NULL, 100,
+         LOOKUPS, MAP_ENTRIES},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        BenchResult result = bench_run(&benchmarks[i]);
+        bench_print_result(&result);
+        printf("\n");
+    }
+
+    report_probe_lengths();
+
+    cs_hashmap_destroy(chained_map);
+    cs_hashmap_destroy(robin_hood_map);
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
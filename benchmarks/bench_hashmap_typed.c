@@ -0,0 +1,144 @@
+#include "bench_framework.h"
+#include "cstash/hashmap.h"
+#include "cstash/hashmap_typed.h"
+#include <stdio.h>
+
+#define BENCH_ENTRIES (1u << 16)
+#define BENCH_LOOKUPS 1024
+
+static uint64_t hash_int(int key) {
+    return cs_hash_wy(&key, sizeof(key));
+}
+
+static bool eq_int(int a, int b) {
+    return a == b;
+}
+
+CS_HASHMAP_DEFINE(IntMap, int, int, hash_int, eq_int)
+
+static int lookup_keys[BENCH_LOOKUPS];
+static volatile int lookup_sink;
+
+// Clés pseudo-aléatoires, toutes présentes dans la map
+static void pick_keys(void) {
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        lookup_keys[i] = (int)(rng % BENCH_ENTRIES);
+    }
+}
+
+// ============================================================================
+// BENCHMARKS: CsHashMap, clés int en binaire
+// ============================================================================
+
+void bench_generic_insert_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    for (int i = 0; i < (int)BENCH_ENTRIES; i++) {
+        cs_hashmap_insert_n(map, &i, sizeof(i), &i);
+    }
+    cs_hashmap_destroy(map);
+}
+
+void bench_generic_get_setup(BenchContext* ctx) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    for (int i = 0; i < (int)BENCH_ENTRIES; i++) {
+        cs_hashmap_insert_n(map, &i, sizeof(i), &i);
+    }
+    pick_keys();
+    ctx->data = map;
+}
+
+void bench_generic_get_bench(BenchContext* ctx) {
+    CsHashMap* map = ctx->data;
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        lookup_sink = *(int*)cs_hashmap_get_n(map, &lookup_keys[i], sizeof(int));
+    }
+}
+
+void bench_generic_teardown(BenchContext* ctx) {
+    cs_hashmap_destroy(ctx->data);
+}
+
+// ============================================================================
+// BENCHMARKS: CS_HASHMAP_DEFINE(IntMap, int, int, ...)
+// ============================================================================
+
+void bench_typed_insert_bench(BenchContext* ctx) {
+    (void)ctx;
+    IntMap* map = IntMap_create();
+    for (int i = 0; i < (int)BENCH_ENTRIES; i++) {
+        IntMap_insert(map, i, i);
+    }
+    IntMap_destroy(map);
+}
+
+void bench_typed_get_setup(BenchContext* ctx) {
+    IntMap* map = IntMap_create();
+    for (int i = 0; i < (int)BENCH_ENTRIES; i++) {
+        IntMap_insert(map, i, i);
+    }
+    pick_keys();
+    ctx->data = map;
+}
+
+void bench_typed_get_bench(BenchContext* ctx) {
+    IntMap* map = ctx->data;
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        lookup_sink = *IntMap_get(map, lookup_keys[i]);
+    }
+}
+
+void bench_typed_teardown(BenchContext* ctx) {
+    IntMap_destroy(ctx->data);
+}
+
+// Copie dans l'ordre des slots, comme une union ou une boucle utilisateur sur IntMap_next
+void bench_typed_copy_bench(BenchContext* ctx) {
+    IntMap* source = ctx->data;
+    IntMap* copy = IntMap_create();
+    size_t cursor = 0;
+    int key;
+    int* value;
+    while (IntMap_next(source, &cursor, &key, &value)) IntMap_insert(copy, key, *value);
+    IntMap_destroy(copy);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    BenchDef benchmarks[] = {
+        {"cs_hashmap_insert_n (int keys)", NULL, bench_generic_insert_bench, NULL, 20, BENCH_ENTRIES, BENCH_ENTRIES},
+
+        {"IntMap_insert", NULL, bench_typed_insert_bench, NULL, 20, BENCH_ENTRIES, BENCH_ENTRIES},
+
+        {"cs_hashmap_get_n (int keys)", bench_generic_get_setup, bench_generic_get_bench, bench_generic_teardown, 100,
+         BENCH_LOOKUPS, BENCH_ENTRIES},
+
+        {"IntMap_get", bench_typed_get_setup, bench_typed_get_bench, bench_typed_teardown, 100, BENCH_LOOKUPS,
+         BENCH_ENTRIES},
+
+        {"IntMap copy via IntMap_next", bench_typed_get_setup, bench_typed_copy_bench, bench_typed_teardown, 20,
+         BENCH_ENTRIES, BENCH_ENTRIES},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        BenchResult result = bench_run(&benchmarks[i]);
+        bench_print_result(&result);
+        printf("\n");
+    }
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
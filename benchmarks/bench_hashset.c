@@ -0,0 +1,167 @@
+#include "bench_framework.h"
+#include "cstash/hashmap.h"
+#include "cstash/hashset.h"
+#include <stdio.h>
+
+// Deux ensembles de 64K clés qui se recouvrent à moitié
+#define SET_ENTRIES (1u << 16)
+#define SET_OFFSET (SET_ENTRIES / 2)
+
+static CsHashMap* map_a = NULL;
+static CsHashMap* map_b = NULL;
+static CsHashSet* set_a = NULL;
+static CsHashSet* set_b = NULL;
+static CsIntHashSet* int_set_a = NULL;
+static CsIntHashSet* int_set_b = NULL;
+static const char dummy = 0;
+
+static void generate_key(char* buffer, size_t index) {
+    snprintf(buffer, 32, "key_%zu", index);
+}
+
+static void build_sets(void) {
+    map_a = cs_hashmap_create(sizeof(char));
+    map_b = cs_hashmap_create(sizeof(char));
+    set_a = cs_hashset_create();
+    set_b = cs_hashset_create();
+    int_set_a = cs_int_hashset_create();
+    int_set_b = cs_int_hashset_create();
+
+    char key[32];
+    for (size_t i = 0; i < SET_ENTRIES; i++) {
+        generate_key(key, i);
+        cs_hashmap_insert(map_a, key, &dummy);
+        cs_hashset_add(set_a, key);
+        cs_int_hashset_add(int_set_a, cs_hash_u64(i));
+
+        generate_key(key, i + SET_OFFSET);
+        cs_hashmap_insert(map_b, key, &dummy);
+        cs_hashset_add(set_b, key);
+        cs_int_hashset_add(int_set_b, cs_hash_u64(i + SET_OFFSET));
+    }
+}
+
+// ============================================================================
+// BENCHMARKS: boucles clé par clé sur CsHashMap (valeur factice d'un octet)
+// ============================================================================
+
+void bench_loop_union_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsHashMap* result = cs_hashmap_create(sizeof(char));
+    const char* key;
+    size_t key_len;
+    CsHashMapIter iter = cs_hashmap_iter_begin(map_a);
+    while (cs_hashmap_iter_next(&iter, &key, &key_len, NULL)) cs_hashmap_insert_n(result, key, key_len, &dummy);
+    iter = cs_hashmap_iter_begin(map_b);
+    while (cs_hashmap_iter_next(&iter, &key, &key_len, NULL)) cs_hashmap_insert_n(result, key, key_len, &dummy);
+    cs_hashmap_destroy(result);
+}
+
+void bench_loop_intersection_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsHashMap* result = cs_hashmap_create(sizeof(char));
+    const char* key;
+    size_t key_len;
+    CsHashMapIter iter = cs_hashmap_iter_begin(map_a);
+    while (cs_hashmap_iter_next(&iter, &key, &key_len, NULL)) {
+        if (cs_hashmap_has_n(map_b, key, key_len)) cs_hashmap_insert_n(result, key, key_len, &dummy);
+    }
+    cs_hashmap_destroy(result);
+}
+
+void bench_loop_difference_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsHashMap* result = cs_hashmap_create(sizeof(char));
+    const char* key;
+    size_t key_len;
+    CsHashMapIter iter = cs_hashmap_iter_begin(map_a);
+    while (cs_hashmap_iter_next(&iter, &key, &key_len, NULL)) {
+        if (!cs_hashmap_has_n(map_b, key, key_len)) cs_hashmap_insert_n(result, key, key_len, &dummy);
+    }
+    cs_hashmap_destroy(result);
+}
+
+void bench_loop_int_union_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsIntHashSet* result = cs_int_hashset_create();
+    size_t cursor = 0;
+    uint64_t key;
+    while (cs_int_hashset_next(int_set_a, &cursor, &key)) cs_int_hashset_add(result, key);
+    cursor = 0;
+    while (cs_int_hashset_next(int_set_b, &cursor, &key)) cs_int_hashset_add(result, key);
+    cs_int_hashset_destroy(result);
+}
+
+// ============================================================================
+// BENCHMARKS: opérations ensemblistes en une passe
+// ============================================================================
+
+void bench_set_union_bench(BenchContext* ctx) {
+    (void)ctx;
+    cs_hashset_destroy(cs_hashset_union(set_a, set_b));
+}
+
+void bench_set_intersection_bench(BenchContext* ctx) {
+    (void)ctx;
+    cs_hashset_destroy(cs_hashset_intersection(set_a, set_b));
+}
+
+void bench_set_difference_bench(BenchContext* ctx) {
+    (void)ctx;
+    cs_hashset_destroy(cs_hashset_difference(set_a, set_b));
+}
+
+void bench_int_set_union_bench(BenchContext* ctx) {
+    (void)ctx;
+    cs_int_hashset_destroy(cs_int_hashset_union(int_set_a, int_set_b));
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    build_sets();
+
+    BenchDef benchmarks[] = {
+        {"union (per-key loop, CsHashMap)", NULL, bench_loop_union_bench, NULL, 20, 2 * SET_ENTRIES, SET_ENTRIES},
+
+        {"cs_hashset_union", NULL, bench_set_union_bench, NULL, 20, 2 * SET_ENTRIES, SET_ENTRIES},
+
+        {"intersection (per-key loop, CsHashMap)", NULL, bench_loop_intersection_bench, NULL, 20, SET_ENTRIES,
+         SET_ENTRIES},
+
+        {"cs_hashset_intersection", NULL, bench_set_intersection_bench, NULL, 20, SET_ENTRIES, SET_ENTRIES},
+
+        {"difference (per-key loop, CsHashMap)", NULL, bench_loop_difference_bench, NULL, 20, SET_ENTRIES,
+         SET_ENTRIES},
+
+        {"cs_hashset_difference", NULL, bench_set_difference_bench, NULL, 20, SET_ENTRIES, SET_ENTRIES},
+
+        {"int union (per-key loop)", NULL, bench_loop_int_union_bench, NULL, 20, 2 * SET_ENTRIES, SET_ENTRIES},
+
+        {"cs_int_hashset_union", NULL, bench_int_set_union_bench, NULL, 20, 2 * SET_ENTRIES, SET_ENTRIES},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        BenchResult result = bench_run(&benchmarks[i]);
+        bench_print_result(&result);
+        printf("\n");
+    }
+
+    cs_hashmap_destroy(map_a);
+    cs_hashmap_destroy(map_b);
+    cs_hashset_destroy(set_a);
+    cs_hashset_destroy(set_b);
+    cs_int_hashset_destroy(int_set_a);
+    cs_int_hashset_destroy(int_set_b);
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
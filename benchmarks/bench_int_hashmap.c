@@ -0,0 +1,139 @@
+#include "bench_framework.h"
+#include "cstash/hashmap.h"
+#include "cstash/int_hashmap.h"
+#include <stdio.h>
+
+#define BENCH_ENTRIES (1u << 16)
+#define BENCH_LOOKUPS 1024
+
+static uint64_t lookup_ids[BENCH_LOOKUPS];
+static volatile uint64_t lookup_sink;
+
+// IDs 64 bits pseudo-aléatoires : le cas réel des maps indexées par identifiant
+static uint64_t id_of(size_t index) {
+    return cs_hash_u64(index + 1);
+}
+
+// Ce que font aujourd'hui les appelants de CsHashMap : formater l'ID en chaîne
+static void generate_key(char* buffer, uint64_t id) {
+    snprintf(buffer, 32, "id_%llu", (unsigned long long)id);
+}
+
+static void pick_ids(void) {
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        lookup_ids[i] = id_of(rng % BENCH_ENTRIES);
+    }
+}
+
+// ============================================================================
+// BENCHMARKS: CsHashMap, IDs formatés en chaîne
+// ============================================================================
+
+void bench_string_insert_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsHashMap* map = cs_hashmap_create(sizeof(uint64_t));
+    char key[32];
+    for (size_t i = 0; i < BENCH_ENTRIES; i++) {
+        uint64_t id = id_of(i);
+        generate_key(key, id);
+        cs_hashmap_insert(map, key, &id);
+    }
+    cs_hashmap_destroy(map);
+}
+
+void bench_string_get_setup(BenchContext* ctx) {
+    CsHashMap* map = cs_hashmap_create(sizeof(uint64_t));
+    char key[32];
+    for (size_t i = 0; i < BENCH_ENTRIES; i++) {
+        uint64_t id = id_of(i);
+        generate_key(key, id);
+        cs_hashmap_insert(map, key, &id);
+    }
+    pick_ids();
+    ctx->data = map;
+}
+
+void bench_string_get_bench(BenchContext* ctx) {
+    CsHashMap* map = ctx->data;
+    char key[32];
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        generate_key(key, lookup_ids[i]);
+        lookup_sink = *(uint64_t*)cs_hashmap_get(map, key);
+    }
+}
+
+void bench_string_teardown(BenchContext* ctx) {
+    cs_hashmap_destroy(ctx->data);
+}
+
+// ============================================================================
+// BENCHMARKS: CsIntHashMap
+// ============================================================================
+
+void bench_int_insert_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(uint64_t));
+    for (size_t i = 0; i < BENCH_ENTRIES; i++) {
+        uint64_t id = id_of(i);
+        cs_int_hashmap_insert(map, id, &id);
+    }
+    cs_int_hashmap_destroy(map);
+}
+
+void bench_int_get_setup(BenchContext* ctx) {
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(uint64_t));
+    for (size_t i = 0; i < BENCH_ENTRIES; i++) {
+        uint64_t id = id_of(i);
+        cs_int_hashmap_insert(map, id, &id);
+    }
+    pick_ids();
+    ctx->data = map;
+}
+
+void bench_int_get_bench(BenchContext* ctx) {
+    CsIntHashMap* map = ctx->data;
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        lookup_sink = *(uint64_t*)cs_int_hashmap_get(map, lookup_ids[i]);
+    }
+}
+
+void bench_int_teardown(BenchContext* ctx) {
+    cs_int_hashmap_destroy(ctx->data);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    BenchDef benchmarks[] = {
+        {"snprintf + cs_hashmap_insert", NULL, bench_string_insert_bench, NULL, 20, BENCH_ENTRIES, BENCH_ENTRIES},
+
+        {"cs_int_hashmap_insert", NULL, bench_int_insert_bench, NULL, 20, BENCH_ENTRIES, BENCH_ENTRIES},
+
+        {"snprintf + cs_hashmap_get", bench_string_get_setup, bench_string_get_bench, bench_string_teardown, 100,
+         BENCH_LOOKUPS, BENCH_ENTRIES},
+
+        {"cs_int_hashmap_get", bench_int_get_setup, bench_int_get_bench, bench_int_teardown, 100, BENCH_LOOKUPS,
+         BENCH_ENTRIES},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        BenchResult result = bench_run(&benchmarks[i]);
+        bench_print_result(&result);
+        printf("\n");
+    }
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "bench_framework.h"
+#include "cstash/hashmap.h"
+#include "cstash/intern_table.h"
+#include <stdio.h>
+
+// Trace de 256K noms tirés parmi 16K noms d'hôtes distincts, comme des logs ou des métriques
+#define DISTINCT_NAMES (1u << 14)
+#define TRACE_LENGTH (1u << 18)
+
+static char names[DISTINCT_NAMES][48];
+static const char* trace[TRACE_LENGTH];
+static volatile const void* intern_sink;
+
+static void build_trace(void) {
+    for (size_t i = 0; i < DISTINCT_NAMES; i++) {
+        snprintf(names[i], sizeof(names[i]), "node-%zu.rack-%zu.eu-west.example.com", i, i % 64);
+    }
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        trace[i] = names[rng % DISTINCT_NAMES];
+    }
+}
+
+// Copie d'une chaîne par malloc, l'équivalent de strdup (hors C99)
+static char* copy_string(const char* str) {
+    size_t len = strlen(str) + 1;
+    char* copy = malloc(len);
+    if (copy) memcpy(copy, str, len);
+    return copy;
+}
+
+static void free_copy(void* value) {
+    free(*(char**)value);
+}
+
+// Ce que font les appelants aujourd'hui : une CsHashMap de la chaîne vers sa copie canonique
+static const char* map_intern(CsHashMap* map, const char* str) {
+    char** canonical = cs_hashmap_get(map, str);
+    if (canonical) return *canonical;
+    char* copy = copy_string(str);
+    cs_hashmap_insert(map, str, &copy);
+    return copy;
+}
+
+static CsHashMap* create_map(void) {
+    CsHashMapOptions options = {.destructor = free_copy};
+    return cs_hashmap_create_with_options(sizeof(char*), &options);
+}
+
+// ============================================================================
+// BENCHMARKS: déduplication d'une trace
+// ============================================================================
+
+void bench_map_intern_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsHashMap* map = create_map();
+    for (size_t i = 0; i < TRACE_LENGTH; i++) intern_sink = map_intern(map, trace[i]);
+    cs_hashmap_destroy(map);
+}
+
+void bench_intern_table_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsInternTable* table = cs_intern_table_create();
+    for (size_t i = 0; i < TRACE_LENGTH; i++) intern_sink = cs_intern_table_intern(table, trace[i], NULL);
+    cs_intern_table_destroy(table);
+}
+
+// ============================================================================
+// Mémoire par chaîne distincte
+// ============================================================================
+
+// Taille d'un bloc glibc : en-tête de 8 octets, arrondi à 16, 32 au minimum
+static size_t malloc_chunk(size_t bytes) {
+    size_t chunk = (bytes + 8 + 15) & ~(size_t)15;
+    return chunk < 32 ? 32 : chunk;
+}
+
+static void report_memory(void) {
+    CsHashMap* map = create_map();
+    CsInternTable* table = cs_intern_table_create();
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        map_intern(map, trace[i]);
+        cs_intern_table_intern(table, trace[i], NULL);
+    }
+
+    size_t map_bytes = map->capacity * sizeof(CsHashMapEntry*) + map->order_capacity * sizeof(CsHashMapEntry*);
+    size_t string_bytes = 0;
+    for (size_t i = 0; i < map->order_len; i++) {
+        const CsHashMapEntry* entry = map->order[i];
+        map_bytes += malloc_chunk(sizeof(CsHashMapEntry) + sizeof(char*) + entry->key_len + 1);
+        map_bytes += malloc_chunk(entry->key_len + 1);
+        string_bytes += entry->key_len + 1;
+    }
+
+    printf("Memory for %zu distinct names (%zu string bytes):\n", table->size, string_bytes);
+    printf("  cs_hashmap + copy per string  %8zu bytes (%.1f per name, %zu allocations)\n", map_bytes,
+           (double)map_bytes / (double)map->size, 2 * map->size + 2);
+    printf("  cs_intern_table               %8zu bytes (%.1f per name, %zu allocations)\n\n",
+           cs_intern_table_memory(table), (double)cs_intern_table_memory(table) / (double)table->size,
+           table->chunk_count + 3);
+
+    cs_hashmap_destroy(map);
+    cs_intern_table_destroy(table);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    build_trace();
+
+    BenchDef benchmarks[] = {
+        {"cs_hashmap + copy per string", NULL, bench_map_intern_bench, NULL, 20, TRACE_LENGTH, DISTINCT_NAMES},
+
+        {"cs_intern_table_intern", NULL, bench_intern_table_bench, NULL, 20, TRACE_LENGTH, DISTINCT_NAMES},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        BenchResult result = bench_run(&benchmarks[i]);
+        bench_print_result(&result);
+        printf("\n");
+    }
+
+    report_memory();
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
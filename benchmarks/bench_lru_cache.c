@@ -0,0 +1,121 @@
+#include "bench_framework.h"
+#include "cstash/hashmap.h"
+#include "cstash/linkedlist.h"
+#include "cstash/lru_cache.h"
+#include <stdio.h>
+
+// Trace biaisée vers les petites clés : 64K accès sur 16K clés, cache de 1024 entrées
+#define KEY_SPACE (1u << 14)
+#define TRACE_LENGTH (1u << 16)
+#define CACHE_ENTRIES 1024
+
+static char trace[TRACE_LENGTH][32];
+static volatile const void* cache_sink;
+
+static void build_trace(void) {
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        double u = (double)(rng % 1000000) / 1000000.0;
+        snprintf(trace[i], sizeof(trace[i]), "object_%zu", (size_t)(u * u * u * KEY_SPACE));
+    }
+}
+
+// ============================================================================
+// BENCHMARKS: CsHashMap + CsLinkedList, déplacement par index en O(n)
+// ============================================================================
+
+static double list_hit_rate = 0;
+
+void bench_list_lru_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    CsLinkedList* recency = cs_linkedlist_create(32); // clés, la plus récente en tête
+    size_t hits = 0;
+
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        const char* key = trace[i];
+        int* value = cs_hashmap_get(map, key);
+        if (value) {
+            hits++;
+            size_t index = 0;
+            for (CsNode* node = recency->head; strcmp(node->data, key) != 0; node = node->next) index++;
+            cs_linkedlist_remove_at(recency, index);
+            cs_linkedlist_push_front(recency, key);
+            cache_sink = value;
+            continue;
+        }
+
+        int loaded = (int)i;
+        cs_hashmap_insert(map, key, &loaded);
+        cs_linkedlist_push_front(recency, key);
+        if (cs_linkedlist_size(recency) > CACHE_ENTRIES) {
+            char* oldest = cs_linkedlist_pop_back(recency);
+            cs_hashmap_remove(map, oldest);
+            free(oldest);
+        }
+    }
+
+    list_hit_rate = (double)hits / TRACE_LENGTH;
+    cs_linkedlist_destroy(recency);
+    cs_hashmap_destroy(map);
+}
+
+// ============================================================================
+// BENCHMARKS: CsLruCache
+// ============================================================================
+
+static double lru_hit_rate = 0;
+
+void bench_lru_cache_bench(BenchContext* ctx) {
+    (void)ctx;
+    CsLruCacheOptions options = {.max_entries = CACHE_ENTRIES};
+    CsLruCache* cache = cs_lru_cache_create(sizeof(int), &options);
+
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        int* value = cs_lru_cache_get(cache, trace[i]);
+        if (value) {
+            cache_sink = value;
+            continue;
+        }
+        int loaded = (int)i;
+        cs_lru_cache_put(cache, trace[i], &loaded);
+    }
+
+    lru_hit_rate = cs_lru_cache_hit_rate(cache);
+    cs_lru_cache_destroy(cache);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    build_trace();
+
+    BenchDef benchmarks[] = {
+        {"LRU (hashmap + linkedlist remove_at)", NULL, bench_list_lru_bench, NULL, 5, TRACE_LENGTH, CACHE_ENTRIES},
+
+        {"cs_lru_cache get/put", NULL, bench_lru_cache_bench, NULL, 20, TRACE_LENGTH, CACHE_ENTRIES},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        BenchResult result = bench_run(&benchmarks[i]);
+        bench_print_result(&result);
+        printf("\n");
+    }
+
+    // Même politique des deux côtés : les taux de succès doivent être identiques
+    printf("Hit rate: linkedlist %.3f, cs_lru_cache %.3f\n\n", list_hit_rate, lru_hit_rate);
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "bench_framework.h"
+#include "cstash/lru_cache.h"
+#include "cstash/s3fifo_cache.h"
+#include <stdio.h>
+
+// Trace biaisée vers les petites clés : 64K accès sur 16K clés, cache de 1024 entrées
+#define KEY_SPACE (1u << 14)
+#define TRACE_LENGTH (1u << 16)
+#define CACHE_ENTRIES 1024
+
+// Trace avec parcours : toutes les 8K requêtes, un parcours de 4K clés jamais relues
+#define SCAN_PERIOD 8192
+#define SCAN_LENGTH 4096
+
+static char skewed_trace[TRACE_LENGTH][32];
+static char scan_trace[TRACE_LENGTH][32];
+static char hit_trace[TRACE_LENGTH][32]; // clés toutes en cache : ne mesure que le chemin d'un succès
+static volatile const void* cache_sink;
+
+static void build_traces(void) {
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    size_t scanned = 0;
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        double u = (double)(rng % 1000000) / 1000000.0;
+        snprintf(skewed_trace[i], sizeof(skewed_trace[i]), "object_%zu", (size_t)(u * u * u * KEY_SPACE));
+
+        if (i % SCAN_PERIOD >= SCAN_PERIOD - SCAN_LENGTH) {
+            snprintf(scan_trace[i], sizeof(scan_trace[i]), "scan_%zu", scanned++);
+        } else {
+            memcpy(scan_trace[i], skewed_trace[i], sizeof(scan_trace[i]));
+        }
+        snprintf(hit_trace[i], sizeof(hit_trace[i]), "object_%zu", (size_t)(rng % CACHE_ENTRIES));
+    }
+}
+
+// ============================================================================
+// BENCHMARKS: CsLruCache
+// ============================================================================
+
+static double lru_hit_rate[2] = {0, 0};
+
+static void replay_lru(char (*trace)[32], double* hit_rate) {
+    CsLruCacheOptions options = {.max_entries = CACHE_ENTRIES};
+    CsLruCache* cache = cs_lru_cache_create(sizeof(int), &options);
+
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        int* value = cs_lru_cache_get(cache, trace[i]);
+        if (value) {
+            cache_sink = value;
+            continue;
+        }
+        int loaded = (int)i;
+        cs_lru_cache_put(cache, trace[i], &loaded);
+    }
+
+    *hit_rate = cs_lru_cache_hit_rate(cache);
+    cs_lru_cache_destroy(cache);
+}
+
+void bench_lru_skewed_bench(BenchContext* ctx) {
+    (void)ctx;
+    replay_lru(skewed_trace, &lru_hit_rate[0]);
+}
+
+void bench_lru_scan_bench(BenchContext* ctx) {
+    (void)ctx;
+    replay_lru(scan_trace, &lru_hit_rate[1]);
+}
+
+static CsLruCache* lru_hits_cache = NULL;
+
+void bench_lru_hits_setup(BenchContext* ctx) {
+    (void)ctx;
+    CsLruCacheOptions options = {.max_entries = CACHE_ENTRIES};
+    lru_hits_cache = cs_lru_cache_create(sizeof(int), &options);
+    for (size_t i = 0; i < TRACE_LENGTH; i++) cs_lru_cache_put(lru_hits_cache, hit_trace[i], &(int){0});
+}
+
+void bench_lru_hits_bench(BenchContext* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < TRACE_LENGTH; i++) cache_sink = cs_lru_cache_get(lru_hits_cache, hit_trace[i]);
+}
+
+void bench_lru_hits_teardown(BenchContext* ctx) {
+    (void)ctx;
+    cs_lru_cache_destroy(lru_hits_cache);
+}
+
+// ============================================================================
+// BENCHMARKS: CsS3FifoCache
+// ============================================================================
+
+static double s3fifo_hit_rate[2] = {0, 0};
+
+static void replay_s3fifo(char (*trace)[32], double* hit_rate) {
+    CsS3FifoCacheOptions options = {.max_entries = CACHE_ENTRIES};
+    CsS3FifoCache* cache = cs_s3fifo_cache_create(sizeof(int), &options);
+
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        int* value = cs_s3fifo_cache_get(cache, trace[i]);
+        if (value) {
+            cache_sink = value;
+            continue;
+        }
+        int loaded = (int)i;
+        cs_s3fifo_cache_put(cache, trace[i], &loaded);
+    }
+
+    *hit_rate = cs_s3fifo_cache_hit_rate(cache);
+    cs_s3fifo_cache_destroy(cache);
+}
+
+void bench_s3fifo_skewed_bench(BenchContext* ctx) {
+    (void)ctx;
+    replay_s3fifo(skewed_trace, &s3fifo_hit_rate[0]);
+}
+
+void bench_s3fifo_scan_bench(BenchContext* ctx) {
+    (void)ctx;
+    replay_s3fifo(scan_trace, &s3fifo_hit_rate[1]);
+}
+
+static CsS3FifoCache* s3fifo_hits_cache = NULL;
+
+void bench_s3fifo_hits_setup(BenchContext* ctx) {
+    (void)ctx;
+    CsS3FifoCacheOptions options = {.max_entries = CACHE_ENTRIES};
+    s3fifo_hits_cache = cs_s3fifo_cache_create(sizeof(int), &options);
+    for (size_t i = 0; i < TRACE_LENGTH; i++) cs_s3fifo_cache_put(s3fifo_hits_cache, hit_trace[i], &(int){0});
+}
+
+void bench_s3fifo_hits_bench(BenchContext* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < TRACE_LENGTH; i++) cache_sink = cs_s3fifo_cache_get(s3fifo_hits_cache, hit_trace[i]);
+}
+
+void bench_s3fifo_hits_teardown(BenchContext* ctx) {
+    (void)ctx;
+    cs_s3fifo_cache_destroy(s3fifo_hits_cache);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    BENCH_INIT();
+
+    build_traces();
+
+    BenchDef benchmarks[] = {
+        {"cs_lru_cache skewed trace", NULL, bench_lru_skewed_bench, NULL, 20, TRACE_LENGTH, CACHE_ENTRIES},
+        {"cs_s3fifo_cache skewed trace", NULL, bench_s3fifo_skewed_bench, NULL, 20, TRACE_LENGTH, CACHE_ENTRIES},
+
+        {"cs_lru_cache skewed trace + scans", NULL, bench_lru_scan_bench, NULL, 20, TRACE_LENGTH, CACHE_ENTRIES},
+        {"cs_s3fifo_cache skewed trace + scans", NULL, bench_s3fifo_scan_bench, NULL, 20, TRACE_LENGTH,
+         CACHE_ENTRIES},
+
+        {"cs_lru_cache get, all hits", bench_lru_hits_setup, bench_lru_hits_bench, bench_lru_hits_teardown, 20,
+         TRACE_LENGTH, CACHE_ENTRIES},
+        {"cs_s3fifo_cache get, all hits", bench_s3fifo_hits_setup, bench_s3fifo_hits_bench, bench_s3fifo_hits_teardown,
+         20, TRACE_LENGTH, CACHE_ENTRIES},
+    };
+
+    size_t num_benchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    printf("\n");
+    for (size_t i = 0; i < num_benchmarks; i++) {
+        BenchResult result = bench_run(&benchmarks[i]);
+        bench_print_result(&result);
+        printf("\n");
+    }
+
+    printf("Hit rate, skewed trace: cs_lru_cache %.3f, cs_s3fifo_cache %.3f\n", lru_hit_rate[0], s3fifo_hit_rate[0]);
+    printf("Hit rate, with scans:   cs_lru_cache %.3f, cs_s3fifo_cache %.3f\n\n", lru_hit_rate[1], s3fifo_hit_rate[1]);
+
+    BENCH_SUMMARY();
+
+    return 0;
+}
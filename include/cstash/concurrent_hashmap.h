@@ -0,0 +1,211 @@
+#ifndef CONCURRENT_HASHMAP_H
+#define CONCURRENT_HASHMAP_H
+
+#include "hash.h"
+#include "hashmap.h"
+#include "result.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define CONCURRENT_HASHMAP_DEFAULT_SHARDS 64
+#define CONCURRENT_HASHMAP_CACHE_LINE 64
+
+// One CsHashMap and its reader-writer lock, defined in concurrent_hashmap.c
+typedef struct cs_concurrent_shard CsConcurrentShard;
+
+// Thread-safe hashmap: keys are striped over independent CsHashMap shards, each behind its own lock,
+// so threads working on different shards never wait on each other
+typedef struct {
+    CsConcurrentShard* shards;
+    size_t shard_count; // power of two
+    size_t value_size;
+    CsHashFunction hash; // shared with the shards, so every key is hashed once
+    bool lock_free_reads;
+    struct cs_epoch_domain* epoch; // reclamation state of the lock-free read mode, NULL otherwise
+} CsConcurrentHashMap;
+
+/**
+ * Creation options, zero-initialize to get the defaults
+ * @param shards Number of shards, rounded up to a power of two (default CONCURRENT_HASHMAP_DEFAULT_SHARDS)
+ * @param map Options of every shard
+ * @param lock_free_reads get/has take no lock and perform no atomic read-modify-write: shards become
+ * copy-on-write chained tables read through atomic loads, writers still serialize on the shard lock and
+ * memory they unlink is freed once no reader can hold it (epoch-based reclamation).
+ * Upserts and resizes copy entries, so this suits read-mostly workloads. Rejected with any engine other than
+ * CS_HASHMAP_CHAINED, with incremental resizing or with a destructor
+ */
+typedef struct {
+    size_t shards;
+    CsHashMapOptions map;
+    bool lock_free_reads;
+} CsConcurrentHashMapOptions;
+
+/**
+ * Creates a new ConcurrentHashMap (takes ownership)
+ * @param value_size Size in bytes of each value that will be stored in the map
+ * @return
+ *  the newly created ConcurrentHashMap
+ *  | NULL if value_size == 0 or if it failed
+ */
+CsConcurrentHashMap* cs_concurrent_hashmap_create(size_t value_size);
+
+/**
+ * Creates a new ConcurrentHashMap with explicit options (takes ownership)
+ * @param value_size Size in bytes of each value that will be stored in the map
+ * @param options Creation options, NULL for the defaults
+ * @return
+ *  the newly created ConcurrentHashMap
+ *  | NULL if value_size == 0, if the shard options are invalid (see cs_hashmap_create_with_options), if
+ *  lock_free_reads is combined with any engine other than CS_HASHMAP_CHAINED, incremental resizing or a
+ *  destructor, or if it failed
+ */
+CsConcurrentHashMap* cs_concurrent_hashmap_create_with_options(size_t value_size,
+                                                               const CsConcurrentHashMapOptions* options);
+
+/**
+ * Destroy the given ConcurrentHashMap, no other thread may use it anymore
+ * @param map ConcurrentHashMap to destroy
+ */
+void cs_concurrent_hashmap_destroy(CsConcurrentHashMap* map);
+
+/**
+ * Copy the value of a key
+ * Values are copied out under the shard lock (or inside an epoch read section with lock_free_reads):
+ * a pointer into a shard would not survive a concurrent remove
+ * @param map ConcurrentHashMap to retrieve the value from
+ * @param key Associated key
+ * @param out_value Buffer of value_size bytes receiving the value
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_concurrent_hashmap_get(CsConcurrentHashMap* map, const char* key, void* out_value);
+
+/**
+ * Copy the value of a key of explicit length
+ * @param map ConcurrentHashMap to retrieve the value from
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @param out_value Buffer of value_size bytes receiving the value
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_concurrent_hashmap_get_n(CsConcurrentHashMap* map, const void* key, size_t key_len, void* out_value);
+
+/**
+ * Check if a key exists
+ * @param map ConcurrentHashMap to check
+ * @param key Key to look for
+ * @return
+ *  true if the key exists
+ *  | false otherwise
+ */
+bool cs_concurrent_hashmap_has(CsConcurrentHashMap* map, const char* key);
+
+/**
+ * Check if a key of explicit length exists
+ * @param map ConcurrentHashMap to check
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  true if the key exists
+ *  | false otherwise
+ */
+bool cs_concurrent_hashmap_has_n(CsConcurrentHashMap* map, const void* key, size_t key_len);
+
+/**
+ * Insert a value
+ * @param map ConcurrentHashMap to insert to
+ * @param key String key
+ * @param value The value associated to the given key
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ *  | CS_CONFLICT
+ */
+CsResult cs_concurrent_hashmap_insert(CsConcurrentHashMap* map, const char* key, const void* value);
+
+/**
+ * Insert a value using a key of explicit length
+ * @param map ConcurrentHashMap to insert to
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @param value The value associated to the given key
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ *  | CS_CONFLICT
+ */
+CsResult cs_concurrent_hashmap_insert_n(CsConcurrentHashMap* map, const void* key, size_t key_len,
+                                        const void* value);
+
+/**
+ * Insert a value, or overwrite the value of an existing key
+ * @param map ConcurrentHashMap to insert to
+ * @param key String key
+ * @param value The value associated to the given key
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ */
+CsResult cs_concurrent_hashmap_upsert(CsConcurrentHashMap* map, const char* key, const void* value);
+
+/**
+ * Insert or overwrite a value using a key of explicit length
+ * @param map ConcurrentHashMap to insert to
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @param value The value associated to the given key
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ */
+CsResult cs_concurrent_hashmap_upsert_n(CsConcurrentHashMap* map, const void* key, size_t key_len,
+                                        const void* value);
+
+/**
+ * Remove a value associated to a given key
+ * @param map Targeted ConcurrentHashMap
+ * @param key String key associated to the value to remove
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_concurrent_hashmap_remove(CsConcurrentHashMap* map, const char* key);
+
+/**
+ * Remove a value associated to a key of explicit length
+ * @param map Targeted ConcurrentHashMap
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_concurrent_hashmap_remove_n(CsConcurrentHashMap* map, const void* key, size_t key_len);
+
+/**
+ * Count the entries, shard by shard
+ * Not a snapshot: concurrent inserts and removes on other shards may or may not be counted
+ * @param map ConcurrentHashMap to count
+ * @return the number of entries, 0 if map is NULL
+ */
+size_t cs_concurrent_hashmap_size(CsConcurrentHashMap* map);
+
+/**
+ * Clear all tuples <key, value>, shard by shard
+ * @param map ConcurrentHashMap to clear
+ */
+void cs_concurrent_hashmap_clear(CsConcurrentHashMap* map);
+
+#endif // CONCURRENT_HASHMAP_H
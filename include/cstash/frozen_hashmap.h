@@ -0,0 +1,119 @@
+#ifndef FROZEN_HASHMAP_H
+#define FROZEN_HASHMAP_H
+
+#include "hash.h"
+#include "hashmap.h"
+#include "result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define FROZEN_HASHMAP_BUCKET_SIZE 4 // average keys per displacement bucket
+#define FROZEN_HASHMAP_MAX_SEEDS 16  // construction attempts before giving up
+
+// Immutable map built by cs_hashmap_freeze()
+// A minimal perfect hash (hash and displace) sends every key of the map to its own slot, so a lookup is
+// one pilot read, one slot read and one key comparison. Everything lives in a single contiguous blob:
+// header, pilots (one uint32_t per bucket), slots (one uint64_t per key: record offset and hash
+// fingerprint) then the records (hash, key length, value, key bytes) in slot order
+// The blob is position independent and is also the file format of cs_frozen_hashmap_save()
+typedef struct {
+    void* blob;
+    size_t blob_size;
+    size_t size;
+    size_t value_size;
+    size_t bucket_count;
+    uint64_t seed;
+    CsHashFunction hash;
+    const uint32_t* pilots;  // into blob
+    const uint64_t* offsets; // into blob, record offset of each slot, top 16 bits of its hash above
+    const char* records;     // into blob
+    bool mapped;             // blob is a read-only mapping of a file rather than a malloc'd copy
+} CsFrozenHashMap;
+
+/**
+ * Compile a hashmap into an immutable perfect-hash table (takes ownership of the result)
+ * The map is left untouched, values and keys are copied
+ * @param hashmap Map to freeze
+ * @return
+ *  the newly created FrozenHashMap
+ *  | NULL if hashmap is NULL, if two of its keys have the same 64-bit hash or if it failed
+ */
+CsFrozenHashMap* cs_hashmap_freeze(const CsHashMap* hashmap);
+
+/**
+ * Destroy the given FrozenHashMap
+ * @param frozen FrozenHashMap to destroy
+ */
+void cs_frozen_hashmap_destroy(CsFrozenHashMap* frozen);
+
+/**
+ * Write a FrozenHashMap to a file that cs_frozen_hashmap_open() can map back
+ * The file is the blob as is: it can only be opened on a platform with the same endianness
+ * @param frozen FrozenHashMap to save
+ * @param path Destination file, replaced if it exists
+ * @return
+ *  CS_SUCCESS on success
+ *  | CS_NULL_POINTER if frozen or path is NULL
+ *  | CS_IO_ERROR if the file could not be written
+ */
+CsResult cs_frozen_hashmap_save(const CsFrozenHashMap* frozen, const char* path);
+
+/**
+ * Open a file written by cs_frozen_hashmap_save() without copying or parsing it (takes ownership of the result)
+ * The file is mapped read-only and only its header is checked, so opening is O(1) whatever the size:
+ * pages are loaded on first access. The file must not be modified while the map is open
+ * @param path File to open
+ * @param hash Hash function the map was built with, NULL for the default
+ * @return
+ *  the newly created FrozenHashMap
+ *  | NULL if path is NULL, if the file cannot be mapped, is not a frozen hashmap of this version and
+ *    endianness, or was built with another hash function
+ */
+CsFrozenHashMap* cs_frozen_hashmap_open(const char* path, CsHashFunction hash);
+
+/**
+ * Get a value using the given key
+ * Values are 16-byte aligned, as in a CsHashMap
+ * @param frozen FrozenHashMap to retrieve the value from
+ * @param key Associated key
+ * @return
+ *  the value associated to the given key
+ *  | NULL if the key is not in the map
+ */
+const void* cs_frozen_hashmap_get(const CsFrozenHashMap* frozen, const char* key);
+
+/**
+ * Get a value using a key of explicit length
+ * @param frozen FrozenHashMap to retrieve the value from
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  the value associated to the given key
+ *  | NULL if the key is not in the map
+ */
+const void* cs_frozen_hashmap_get_n(const CsFrozenHashMap* frozen, const void* key, size_t key_len);
+
+/**
+ * Check if a key exists
+ * @param frozen FrozenHashMap to check
+ * @param key Key to look for
+ * @return
+ *  true if the key exists
+ *  | false otherwise
+ */
+bool cs_frozen_hashmap_has(const CsFrozenHashMap* frozen, const char* key);
+
+/**
+ * Check if a key of explicit length exists
+ * @param frozen FrozenHashMap to check
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  true if the key exists
+ *  | false otherwise
+ */
+bool cs_frozen_hashmap_has_n(const CsFrozenHashMap* frozen, const void* key, size_t key_len);
+
+#endif // FROZEN_HASHMAP_H
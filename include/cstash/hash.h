@@ -0,0 +1,67 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Hash function over a byte string, used by the hash based containers
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return 64-bit hash of the key
+ */
+typedef uint64_t (*CsHashFunction)(const void* key, size_t key_len);
+
+/**
+ * 64-bit FNV-1a, one byte per multiply
+ * Simple and stable across platforms but slow on long keys
+ */
+uint64_t cs_hash_fnv1a(const void* key, size_t key_len);
+
+/**
+ * wyhash-style hash consuming 8 to 48 bytes per step with 64x64->128 bit multiplies
+ * Default hash of the containers
+ */
+uint64_t cs_hash_wy(const void* key, size_t key_len);
+
+/**
+ * CRC32C of the key spread over 64 bits
+ * Uses the SSE4.2 crc32 instruction when the running CPU supports it (detected at runtime),
+ * a portable bitwise loop otherwise. Only 32 bits of the result are independent
+ */
+uint64_t cs_hash_crc32c(const void* key, size_t key_len);
+
+/**
+ * Integer mixer (MurmurHash3 fmix64 finalizer) for containers keyed by integers
+ * A bijection on 64 bits in which every input bit affects every output bit, so sequential IDs spread over
+ * both the high bits (bucket index) and the low bits (hash fragments). Inline: it is a handful of instructions
+ * @param key Integer key, uint32_t keys convert losslessly
+ * @return 64-bit hash of the key
+ */
+static inline uint64_t cs_hash_u64(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+/**
+ * Raw CRC32C (Castagnoli) checksum
+ * @param data Bytes to checksum
+ * @param len Length of data in bytes
+ * @return the CRC32C of data, e.g. 0xE3069283 for "123456789"
+ */
+uint32_t cs_crc32c(const void* data, size_t len);
+
+/**
+ * Check whether cs_crc32c() runs on the hardware instruction
+ * @return
+ *  true if the CPU crc32 instruction is used
+ *  | false if the portable implementation is used
+ */
+bool cs_crc32c_is_hardware(void);
+
+#endif // HASH_H
@@ -1,27 +1,115 @@
 #ifndef HASHMAP_H
 #define HASHMAP_H
 
+#include "hash.h"
 #include "result.h"
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #define HASHMAP_DEFAULT_CAPACITY 8
 #define HASHMAP_MAX_LOAD_FACTOR 0.75
+#define HASHMAP_SWISS_GROUP_WIDTH 16
+#define HASHMAP_SWISS_MAX_LOAD_FACTOR 0.875
+#define HASHMAP_ROBIN_HOOD_MAX_LOAD_FACTOR 0.9
+#define HASHMAP_ROBIN_HOOD_MAX_DISTANCE 128 // farthest an entry may sit from its home slot (robin hood)
+#define HASHMAP_CUCKOO_BUCKET_SIZE 4         // slots per bucket (cuckoo)
+#define HASHMAP_CUCKOO_MAX_LOAD_FACTOR 0.9
+#define HASHMAP_BATCH_SIZE 16       // lookups kept in flight by cs_hashmap_get_batch
+#define HASHMAP_INCREMENTAL_STEP 8 // old buckets migrated per insert/remove during an incremental resize
+#define HASHMAP_BULK_MIN_PER_THREAD 4096 // smallest share of keys worth a thread in cs_hashmap_insert_bulk
 
+typedef enum {
+    CS_HASHMAP_CHAINED = 0,    // separate chaining, one linked list per bucket
+    CS_HASHMAP_SWISS = 1,      // open addressing with SwissTable-style control bytes
+    CS_HASHMAP_ROBIN_HOOD = 2, // open addressing, linear probing with Robin Hood displacement
+    CS_HASHMAP_CUCKOO = 3,     // bucketized cuckoo hashing, two candidate buckets of 4 slots per key
+} CsHashMapEngine;
+
+// Entries are a single allocation: header, value (data), then the key bytes and a NUL byte
 typedef struct cs_hashmap_entry {
     struct cs_hashmap_entry* next;
-    char* key;
+    char* key;      // points right after the value, always followed by a NUL byte
+    size_t key_len; // length of key in bytes, without the NUL byte
+    uint64_t hash;  // full hash of key, reused on resize and checked before comparing keys
+    size_t order;   // position in the insertion-order array of the map
+    uint64_t pad;   // keeps the header a multiple of 16 bytes, so values stay 16-byte aligned
     char data[];
 } CsHashMapEntry;
 
+// Compile-time check: a negative array size if a header change breaks the alignment of the values
+typedef char cs_hashmap_entry_data_aligned[offsetof(CsHashMapEntry, data) % 16 == 0 ? 1 : -1];
+
 typedef struct {
     size_t capacity;
     size_t size;
     size_t value_size;
-    CsHashMapEntry** buckets;
+    CsHashMapEntry** buckets; // chains (chained) or one entry per slot (other engines)
+    CsHashMapEngine engine;
+    uint8_t* ctrl;     // per-slot bytes: control (swiss), fingerprint (cuckoo), distances + fingerprints (robin hood)
+    size_t tombstones; // deleted slots not yet reclaimed (swiss)
+    CsHashFunction hash;
+    unsigned int shift; // 64 - log2(capacity), chained bucket = (hash * 2^64/phi) >> shift
+    bool incremental;
+    CsHashMapEntry** old_buckets; // previous bucket array while an incremental resize is in progress
+    size_t old_capacity;
+    unsigned int old_shift;
+    size_t migrate_index; // old buckets below this index have been migrated
+    CsHashMapEntry** order; // every entry in insertion order, NULL holes left by removals
+    size_t order_len;       // used positions in order, holes included
+    size_t order_capacity;
+    void (*destructor)(void*); // called on a value when the map drops it, NULL for none
 } CsHashMap;
 
+// Cursor over the entries of a hashmap in insertion order, lives on the stack
+typedef struct {
+    const CsHashMap* hashmap;
+    size_t index; // next position to visit in hashmap->order
+} CsHashMapIter;
+
+/**
+ * Callback of cs_hashmap_for_each()
+ * @param key Key of the entry (NUL terminated)
+ * @param key_len Length of key in bytes
+ * @param value Value of the entry
+ * @param user_data Pointer passed to cs_hashmap_for_each()
+ * @return
+ *  true to continue the traversal
+ *  | false to stop it
+ */
+typedef bool (*CsHashMapVisitor)(const char* key, size_t key_len, void* value, void* user_data);
+
+/**
+ * Creation options, zero-initialize to get the defaults
+ * @param engine Storage engine (default CS_HASHMAP_CHAINED)
+ * @param hash Hash function applied to keys (default cs_hash_wy)
+ * @param incremental Grow the chained engine incrementally: the bucket array is doubled without rehashing,
+ * then each insert/remove migrates HASHMAP_INCREMENTAL_STEP old buckets, so no single insert pays for
+ * a full rehash. Lookups check both arrays until the migration ends (chained engine only)
+ * @param destructor Optional destructor called on a value (pointer to its slot) when the map drops it: remove,
+ * overwrite by upsert, clear and destroy. Not called by cs_hashmap_take(), which hands the value to the caller
+ */
+typedef struct {
+    CsHashMapEngine engine;
+    CsHashFunction hash;
+    bool incremental;
+    void (*destructor)(void*);
+} CsHashMapOptions;
+
+/**
+ * Bulk insertion options, zero-initialize to get the defaults
+ * @param unique Trust the keys to be distinct from each other and from the map: the duplicate checks are skipped
+ * and a duplicate key would end up stored twice
+ * @param threads Hash the keys and build the entries on up to this many threads, linking them into the map
+ * stays on the calling thread (0 or 1: calling thread only)
+ */
+typedef struct {
+    bool unique;
+    size_t threads;
+} CsHashMapBulkOptions;
+
 /**
  * Creates a new HashMap (takes ownership)
  * @param value_size Size in bytes of each value that will be stored in the HashMap
@@ -31,6 +119,50 @@ typedef struct {
  */
 CsHashMap* cs_hashmap_create(size_t value_size);
 
+/**
+ * Creates a new HashMap sized for a known number of entries (takes ownership)
+ * The bucket count is chosen from HASHMAP_MAX_LOAD_FACTOR so that inserting expected_entries never resizes
+ * @param value_size Size in bytes of each value that will be stored in the HashMap
+ * @param expected_entries Number of entries the map will hold, 0 for the default capacity
+ * @return
+ *  the newly created HashMap
+ *  | NULL if value_size == 0 or if it failed
+ */
+CsHashMap* cs_hashmap_create_with_capacity(size_t value_size, size_t expected_entries);
+
+/**
+ * Creates a new HashMap with explicit options (takes ownership)
+ * The swiss engine keeps a flat array of 7-bit hash fragments probed 16 slots at a time (SSE2 when available),
+ * so most lookups touch one control group and the matching entry only
+ * The robin hood engine probes linearly from the home slot and keeps every run ordered by distance to home:
+ * an insertion takes the slot of a resident closer to its home, a removal shifts the rest of the run back
+ * (no tombstones). Probe lengths stay short and even up to HASHMAP_ROBIN_HOOD_MAX_LOAD_FACTOR, and a miss
+ * stops as soon as it passes where the key would be
+ * The cuckoo engine stores a key in one of two buckets of HASHMAP_CUCKOO_BUCKET_SIZE slots, both derived from
+ * its hash, moving other keys to their alternate bucket to make room. A lookup, hit or miss, never reads more
+ * than those two buckets: 8 fingerprint bytes and at most 8 key comparisons, whatever the load
+ * @param value_size Size in bytes of each value that will be stored in the HashMap
+ * @param options Creation options, NULL for the defaults
+ * @return
+ *  the newly created HashMap
+ *  | NULL if value_size == 0, if the engine is unknown, if incremental is requested for another engine than
+ *  CS_HASHMAP_CHAINED or if it failed
+ */
+CsHashMap* cs_hashmap_create_with_options(size_t value_size, const CsHashMapOptions* options);
+
+/**
+ * Creates a new HashMap holding n key/value pairs (takes ownership)
+ * Same result as cs_hashmap_insert() in a loop, but the table is sized once (see cs_hashmap_insert_bulk())
+ * @param value_size Size in bytes of each value
+ * @param keys n string keys, for a repeated key the first occurrence wins
+ * @param values n values stored contiguously, value_size bytes each
+ * @param n Number of pairs
+ * @return
+ *  the newly created HashMap
+ *  | NULL if value_size == 0, if keys or values is NULL (with n > 0), if a key is NULL or if it failed
+ */
+CsHashMap* cs_hashmap_create_from(size_t value_size, const char* const* keys, const void* values, size_t n);
+
 /**
  * Destroy the given HashMap
  * @param hashmap HashMap to destroy
@@ -47,6 +179,32 @@ void cs_hashmap_destroy(CsHashMap* hashmap);
  */
 void* cs_hashmap_get(const CsHashMap* hashmap, const char* key);
 
+/**
+ * Get a value using a key of explicit length
+ * The key may contain any byte, including NUL, and does not need to be NUL-terminated
+ * @param hashmap Hashmap to retrieve the value from
+ * @param key Associated key
+ * @param key_len Length of key in bytes
+ * @return
+ *  the value associated to the given key
+ *  | NULL if the tuple <key, value> does not exists
+ */
+void* cs_hashmap_get_n(const CsHashMap* hashmap, const void* key, size_t key_len);
+
+/**
+ * Get the values of several keys at once
+ * Keys are hashed and their buckets prefetched HASHMAP_BATCH_SIZE at a time before being resolved,
+ * so the cache misses of independent lookups overlap instead of being paid one after the other
+ * @param hashmap Hashmap to retrieve the values from
+ * @param keys Array of n keys
+ * @param n Number of keys
+ * @param out_values Array of n pointers, out_values[i] receives the value of keys[i] or NULL
+ * @return
+ *  the number of keys found
+ *  | 0 if a pointer is NULL
+ */
+size_t cs_hashmap_get_batch(const CsHashMap* hashmap, const char* const* keys, size_t n, void** out_values);
+
 /**
  * Check if a key exists
  * @param hashmap Hashmap to check
@@ -57,6 +215,17 @@ void* cs_hashmap_get(const CsHashMap* hashmap, const char* key);
  */
 bool cs_hashmap_has(const CsHashMap* hashmap, const char* key);
 
+/**
+ * Check if a key of explicit length exists
+ * @param hashmap Hashmap to check
+ * @param key Key to look for
+ * @param key_len Length of key in bytes
+ * @return
+ *  true if the key exists
+ *  | false otherwise
+ */
+bool cs_hashmap_has_n(const CsHashMap* hashmap, const void* key, size_t key_len);
+
 /**
  * Insert a value
  * @param hashmap Hashmap to insert to
@@ -67,9 +236,98 @@ bool cs_hashmap_has(const CsHashMap* hashmap, const char* key);
  *  | CS_NULL_POINTER
  *  | CS_ALLOCATION_FAILED
  *  | CS_CONFLICT
+ *  | CS_OUT_OF_BOUNDS if the robin hood engine cannot place the key within HASHMAP_ROBIN_HOOD_MAX_DISTANCE
+ *    of its home slot, or the cuckoo engine in its two buckets, which only happens to keys sharing their hash
  */
 CsResult cs_hashmap_insert(CsHashMap* hashmap, const char* key, const void* value);
 
+/**
+ * Insert a value using a key of explicit length
+ * The key bytes are copied, "ab" and "ab\0" are two distinct keys
+ * @param hashmap Hashmap to insert to
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @param value The value associated to the given key
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ *  | CS_CONFLICT
+ *  | CS_OUT_OF_BOUNDS if the robin hood engine cannot place the key within HASHMAP_ROBIN_HOOD_MAX_DISTANCE
+ *    of its home slot, or the cuckoo engine in its two buckets, which only happens to keys sharing their hash
+ */
+CsResult cs_hashmap_insert_n(CsHashMap* hashmap, const void* key, size_t key_len, const void* value);
+
+/**
+ * Insert n key/value pairs at once
+ * The table and the insertion-order array grow once for the whole batch instead of doubling log2(n) times,
+ * entries are built before any of them is linked and bucket loads are prefetched ahead of the links.
+ * Keys that are already present (or repeated in the batch) are skipped, as with cs_hashmap_insert()
+ * @param hashmap Hashmap to insert to
+ * @param keys n string keys
+ * @param values n values stored contiguously, hashmap->value_size bytes each
+ * @param n Number of pairs
+ * @param options Bulk options, NULL for the defaults
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER if hashmap, keys, values or one of the keys is NULL (nothing is inserted)
+ *  | CS_ALLOCATION_FAILED (nothing is inserted)
+ *  | CS_CONFLICT if some keys were skipped, the others are inserted
+ *  | CS_OUT_OF_BOUNDS as cs_hashmap_insert(), the keys before the failing one are inserted
+ */
+CsResult cs_hashmap_insert_bulk(CsHashMap* hashmap, const char* const* keys, const void* values, size_t n,
+                                const CsHashMapBulkOptions* options);
+
+/**
+ * Get the value slot of a key, inserting a default value first if the key is absent
+ * The key is hashed once, e.g. a counter is updated with ++*(int*)cs_hashmap_get_or_insert(...)
+ * @param hashmap Hashmap to look up / insert to
+ * @param key Key to look for
+ * @param default_value Value copied in when the key is absent, NULL for a zero-filled value
+ * @param inserted Set to true if the key was inserted, false if it already existed (may be NULL)
+ * @return
+ *  pointer to the value slot, valid until the key is removed
+ *  | NULL if a pointer is NULL or the allocation failed
+ */
+void* cs_hashmap_get_or_insert(CsHashMap* hashmap, const char* key, const void* default_value, bool* inserted);
+
+/**
+ * cs_hashmap_get_or_insert() with a key of explicit length
+ * @param hashmap Hashmap to look up / insert to
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @param default_value Value copied in when the key is absent, NULL for a zero-filled value
+ * @param inserted Set to true if the key was inserted, false if it already existed (may be NULL)
+ * @return
+ *  pointer to the value slot, valid until the key is removed
+ *  | NULL if a pointer is NULL or the allocation failed
+ */
+void* cs_hashmap_get_or_insert_n(CsHashMap* hashmap, const void* key, size_t key_len, const void* default_value,
+                                 bool* inserted);
+
+/**
+ * Insert a value, or overwrite the value of an existing key
+ * @param hashmap Hashmap to insert to
+ * @param key Key of the value
+ * @param value The value associated to the given key
+ * @return
+ *  pointer to the value slot, valid until the key is removed
+ *  | NULL if a pointer is NULL or the allocation failed
+ */
+void* cs_hashmap_upsert(CsHashMap* hashmap, const char* key, const void* value);
+
+/**
+ * cs_hashmap_upsert() with a key of explicit length
+ * @param hashmap Hashmap to insert to
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @param value The value associated to the given key
+ * @return
+ *  pointer to the value slot, valid until the key is removed
+ *  | NULL if a pointer is NULL or the allocation failed
+ */
+void* cs_hashmap_upsert_n(CsHashMap* hashmap, const void* key, size_t key_len, const void* value);
+
 /**
  * Remove a value associated to a given key
  * @param hashmap Targeted Hashmap
@@ -82,7 +340,45 @@ CsResult cs_hashmap_insert(CsHashMap* hashmap, const char* key, const void* valu
 CsResult cs_hashmap_remove(CsHashMap* hashmap, const char* key);
 
 /**
- * Clear all tuples <key, value>
+ * Remove a value associated to a key of explicit length
+ * @param hashmap Targeted Hashmap
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_hashmap_remove_n(CsHashMap* hashmap, const void* key, size_t key_len);
+
+/**
+ * Remove a key and move its value into caller storage, with a single lookup
+ * The destructor is not called: the caller now owns the value
+ * @param hashmap Targeted Hashmap
+ * @param key Key to remove
+ * @param out_value Buffer of hashmap->value_size bytes receiving the value
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND (out_value is left untouched)
+ */
+CsResult cs_hashmap_take(CsHashMap* hashmap, const char* key, void* out_value);
+
+/**
+ * cs_hashmap_take() with a key of explicit length
+ * @param hashmap Targeted Hashmap
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @param out_value Buffer of hashmap->value_size bytes receiving the value
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND (out_value is left untouched)
+ */
+CsResult cs_hashmap_take_n(CsHashMap* hashmap, const void* key, size_t key_len, void* out_value);
+
+/**
+ * Clear all tuples <key, value>, calling the destructor on every value
  * @param hashmap Hashmap to clear
  */
 void cs_hashmap_clear(CsHashMap* hashmap);
@@ -90,7 +386,8 @@ void cs_hashmap_clear(CsHashMap* hashmap);
 /**
  * Resize the hashmap
  * @param hashmap Hashmap to resize
- * @param new_capacity New capacity (number of buckets)
+ * @param new_capacity New capacity (number of buckets), rounded up to a power of two
+ * The open-addressing engines also round it up to hold the current entries
  * @return
  *  CS_SUCCESS
  *  | CS_NULL_POINTER
@@ -98,4 +395,33 @@ void cs_hashmap_clear(CsHashMap* hashmap);
  */
 CsResult cs_hashmap_resize(CsHashMap* hashmap, size_t new_capacity);
 
+/**
+ * Start an iteration over the entries in insertion order
+ * Entries can be removed while iterating, an insertion invalidates the iterator
+ * @param hashmap Hashmap to iterate over
+ * @return an iterator positioned before the first entry
+ */
+CsHashMapIter cs_hashmap_iter_begin(const CsHashMap* hashmap);
+
+/**
+ * Advance an iterator to the next entry
+ * @param iter Iterator returned by cs_hashmap_iter_begin()
+ * @param key Receives the key of the entry (may be NULL)
+ * @param key_len Receives the length of the key in bytes (may be NULL)
+ * @param value Receives the value of the entry (may be NULL)
+ * @return
+ *  true if an entry was produced
+ *  | false at the end of the map or if iter is NULL
+ */
+bool cs_hashmap_iter_next(CsHashMapIter* iter, const char** key, size_t* key_len, void** value);
+
+/**
+ * Call visitor on every entry in insertion order
+ * @param hashmap Hashmap to iterate over
+ * @param visitor Callback, returning false stops the traversal
+ * @param user_data Pointer forwarded to visitor
+ * @return the number of entries visited
+ */
+size_t cs_hashmap_for_each(const CsHashMap* hashmap, CsHashMapVisitor visitor, void* user_data);
+
 #endif // HASHMAP_H
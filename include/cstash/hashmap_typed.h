@@ -0,0 +1,237 @@
+#ifndef HASHMAP_TYPED_H
+#define HASHMAP_TYPED_H
+
+#include "hashmap.h"
+#include "result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Control byte of a slot: the top 7 bits of the hash when full, one of these (high bit set) otherwise
+#define CS_TYPED_HASHMAP_EMPTY 0x80
+#define CS_TYPED_HASHMAP_DELETED 0xFE
+
+/**
+ * Define a hashmap specialized for KeyT -> ValT, every function is static inline
+ * Keys and values are stored by value in one flat slot array (open addressing, linear probing) next to a
+ * control byte array, so copies, comparisons and slot sizes are compile-time constants the compiler can inline.
+ * Pointer keys (e.g. const char*) are stored as is: the map does not copy what they point to
+ * @param name Name of the generated type, functions are prefixed with name_
+ * @param KeyT Key type
+ * @param ValT Value type
+ * @param hash_fn uint64_t hash_fn(KeyT key), its low bits pick the slot and its top 7 bits the control byte, so
+ * every bit must be mixed. Wrap a cs_hash_* function to the key type, e.g.
+ * static uint64_t hash_int(int key) { return cs_hash_u64((uint64_t)key); }
+ * static uint64_t hash_string(const char* key) { return cs_hash_wy(key, strlen(key)); }
+ * @param eq_fn bool eq_fn(KeyT a, KeyT b)
+ *
+ * Generated API (map is a name*):
+ *  name* name_create(void)                                   | NULL if it failed
+ *  name* name_create_with_capacity(size_t expected_entries)  | NULL if it failed
+ *  void name_destroy(name* map)
+ *  ValT* name_get(const name* map, KeyT key)                 | NULL if absent
+ *  bool name_has(const name* map, KeyT key)
+ *  CsResult name_insert(name* map, KeyT key, ValT value)     CS_SUCCESS | CS_NULL_POINTER | CS_ALLOCATION_FAILED
+ *                                                            | CS_CONFLICT
+ *  ValT* name_upsert(name* map, KeyT key, ValT value)        | NULL if it failed
+ *  CsResult name_remove(name* map, KeyT key)                 CS_SUCCESS | CS_NULL_POINTER | CS_NOT_FOUND
+ *  void name_clear(name* map)
+ *  size_t name_size(const name* map)
+ *  bool name_next(const name* map, size_t* cursor, KeyT* key, ValT** value)
+ *      iterate with a cursor starting at 0, in slot order; false once every entry has been visited
+ */
+#define CS_HASHMAP_DEFINE(name, KeyT, ValT, hash_fn, eq_fn)                                                            \
+    typedef struct {                                                                                                   \
+        KeyT key;                                                                                                      \
+        ValT value;                                                                                                    \
+    } name##Slot;                                                                                                      \
+                                                                                                                       \
+    typedef struct {                                                                                                   \
+        name##Slot* slots;                                                                                             \
+        uint8_t* ctrl;                                                                                                 \
+        size_t capacity; /* power of two */                                                                            \
+        size_t size;                                                                                                   \
+        size_t tombstones;                                                                                             \
+    } name;                                                                                                            \
+                                                                                                                       \
+    /* Index from the low bits, tag from the top 7: slot order is not hash order, so copying a map through */          \
+    /* name_next() into a smaller, growing one spreads the keys instead of piling them into one cluster */             \
+    static inline size_t name##_index_(const name* map, uint64_t hash) {                                               \
+        return (size_t)(hash & (map->capacity - 1));                                                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline uint8_t name##_h2_(uint64_t hash) {                                                                  \
+        return (uint8_t)(hash >> 57);                                                                                  \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline CsResult name##_init_(name* map, size_t capacity) {                                                  \
+        map->ctrl = malloc(capacity);                                                                                  \
+        map->slots = malloc(capacity * sizeof(name##Slot));                                                            \
+        if (!map->ctrl || !map->slots) {                                                                               \
+            free(map->ctrl);                                                                                           \
+            free(map->slots);                                                                                          \
+            return CS_ALLOCATION_FAILED;                                                                               \
+        }                                                                                                              \
+        memset(map->ctrl, CS_TYPED_HASHMAP_EMPTY, capacity);                                                           \
+        map->capacity = capacity;                                                                                      \
+        map->size = 0;                                                                                                 \
+        map->tombstones = 0;                                                                                           \
+        return CS_SUCCESS;                                                                                             \
+    }                                                                                                                  \
+                                                                                                                       \
+    /* Power of two holding entries under HASHMAP_MAX_LOAD_FACTOR, 0 if too large */                                   \
+    static inline size_t name##_capacity_for_(size_t entries) {                                                        \
+        size_t capacity = HASHMAP_DEFAULT_CAPACITY;                                                                    \
+        while ((double)entries >= capacity * HASHMAP_MAX_LOAD_FACTOR) {                                                \
+            if (capacity > SIZE_MAX / 2 / sizeof(name##Slot)) return 0;                                                \
+            capacity *= 2;                                                                                             \
+        }                                                                                                              \
+        return capacity;                                                                                               \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline name* name##_create_with_capacity(size_t expected_entries) {                                         \
+        size_t capacity = name##_capacity_for_(expected_entries);                                                      \
+        if (capacity == 0) return NULL;                                                                                \
+                                                                                                                       \
+        name* map = malloc(sizeof(name));                                                                              \
+        if (!map) return NULL;                                                                                         \
+        if (name##_init_(map, capacity) != CS_SUCCESS) {                                                               \
+            free(map);                                                                                                 \
+            return NULL;                                                                                               \
+        }                                                                                                              \
+        return map;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline name* name##_create(void) {                                                                          \
+        return name##_create_with_capacity(0);                                                                         \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline void name##_destroy(name* map) {                                                                     \
+        if (!map) return;                                                                                              \
+        free(map->ctrl);                                                                                               \
+        free(map->slots);                                                                                              \
+        free(map);                                                                                                     \
+    }                                                                                                                  \
+                                                                                                                       \
+    /* Probe until the key or an empty slot: the load factor guarantees an empty slot exists */                        \
+    static inline name##Slot* name##_find_(const name* map, KeyT key, uint64_t hash) {                                 \
+        uint8_t h2 = name##_h2_(hash);                                                                                 \
+        size_t mask = map->capacity - 1;                                                                               \
+        for (size_t i = name##_index_(map, hash);; i = (i + 1) & mask) {                                               \
+            uint8_t ctrl = map->ctrl[i];                                                                               \
+            if (ctrl == CS_TYPED_HASHMAP_EMPTY) return NULL;                                                           \
+            if (ctrl == h2 && eq_fn(map->slots[i].key, key)) return &map->slots[i];                                    \
+        }                                                                                                              \
+    }                                                                                                                  \
+                                                                                                                       \
+    /* Store a key known to be absent in the first free slot of its probe sequence */                                  \
+    static inline name##Slot* name##_place_(name* map, KeyT key, ValT value, uint64_t hash) {                          \
+        size_t mask = map->capacity - 1;                                                                               \
+        size_t i = name##_index_(map, hash);                                                                           \
+        while (!(map->ctrl[i] & 0x80)) i = (i + 1) & mask;                                                             \
+        if (map->ctrl[i] == CS_TYPED_HASHMAP_DELETED) map->tombstones--;                                               \
+        map->ctrl[i] = name##_h2_(hash);                                                                               \
+        map->slots[i].key = key;                                                                                       \
+        map->slots[i].value = value;                                                                                   \
+        map->size++;                                                                                                   \
+        return &map->slots[i];                                                                                         \
+    }                                                                                                                  \
+                                                                                                                       \
+    /* Rehash before an insertion would push live entries and tombstones over the load factor */                       \
+    static inline CsResult name##_reserve_one_(name* map) {                                                            \
+        if ((double)(map->size + map->tombstones + 1) < map->capacity * HASHMAP_MAX_LOAD_FACTOR) return CS_SUCCESS;    \
+                                                                                                                       \
+        size_t capacity = name##_capacity_for_(map->size + 1);                                                         \
+        if (capacity == 0) return CS_ALLOCATION_FAILED;                                                                \
+        if (capacity < map->capacity) capacity = map->capacity;                                                        \
+                                                                                                                       \
+        name old = *map;                                                                                               \
+        if (name##_init_(map, capacity) != CS_SUCCESS) {                                                               \
+            *map = old;                                                                                                \
+            return CS_ALLOCATION_FAILED;                                                                               \
+        }                                                                                                              \
+        for (size_t i = 0; i < old.capacity; i++) {                                                                    \
+            if (!(old.ctrl[i] & 0x80)) {                                                                               \
+                name##_place_(map, old.slots[i].key, old.slots[i].value, hash_fn(old.slots[i].key));                   \
+            }                                                                                                          \
+        }                                                                                                              \
+        free(old.ctrl);                                                                                                \
+        free(old.slots);                                                                                               \
+        return CS_SUCCESS;                                                                                             \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline ValT* name##_get(const name* map, KeyT key) {                                                        \
+        if (!map) return NULL;                                                                                         \
+        name##Slot* slot = name##_find_(map, key, hash_fn(key));                                                       \
+        return slot ? &slot->value : NULL;                                                                             \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline bool name##_has(const name* map, KeyT key) {                                                         \
+        return name##_get(map, key) != NULL;                                                                           \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline CsResult name##_insert(name* map, KeyT key, ValT value) {                                            \
+        if (!map) return CS_NULL_POINTER;                                                                              \
+        uint64_t hash = hash_fn(key);                                                                                  \
+        if (name##_find_(map, key, hash)) return CS_CONFLICT;                                                          \
+        if (name##_reserve_one_(map) != CS_SUCCESS) return CS_ALLOCATION_FAILED;                                       \
+        name##_place_(map, key, value, hash);                                                                          \
+        return CS_SUCCESS;                                                                                             \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline ValT* name##_upsert(name* map, KeyT key, ValT value) {                                               \
+        if (!map) return NULL;                                                                                         \
+        uint64_t hash = hash_fn(key);                                                                                  \
+        name##Slot* slot = name##_find_(map, key, hash);                                                               \
+        if (!slot) {                                                                                                   \
+            if (name##_reserve_one_(map) != CS_SUCCESS) return NULL;                                                   \
+            slot = name##_place_(map, key, value, hash);                                                               \
+        }                                                                                                              \
+        slot->value = value;                                                                                           \
+        return &slot->value;                                                                                           \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline CsResult name##_remove(name* map, KeyT key) {                                                        \
+        if (!map) return CS_NULL_POINTER;                                                                              \
+        name##Slot* slot = name##_find_(map, key, hash_fn(key));                                                       \
+        if (!slot) return CS_NOT_FOUND;                                                                                \
+                                                                                                                       \
+        /* a slot followed by an empty one ends no probe sequence, it can become empty again */                        \
+        size_t i = (size_t)(slot - map->slots);                                                                        \
+        if (map->ctrl[(i + 1) & (map->capacity - 1)] == CS_TYPED_HASHMAP_EMPTY) {                                      \
+            map->ctrl[i] = CS_TYPED_HASHMAP_EMPTY;                                                                     \
+        } else {                                                                                                       \
+            map->ctrl[i] = CS_TYPED_HASHMAP_DELETED;                                                                   \
+            map->tombstones++;                                                                                         \
+        }                                                                                                              \
+        map->size--;                                                                                                   \
+        return CS_SUCCESS;                                                                                             \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline void name##_clear(name* map) {                                                                       \
+        if (!map) return;                                                                                              \
+        memset(map->ctrl, CS_TYPED_HASHMAP_EMPTY, map->capacity);                                                      \
+        map->size = 0;                                                                                                 \
+        map->tombstones = 0;                                                                                           \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline size_t name##_size(const name* map) {                                                                \
+        return map ? map->size : 0;                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline bool name##_next(const name* map, size_t* cursor, KeyT* key, ValT** value) {                         \
+        if (!map || !cursor) return false;                                                                             \
+        for (; *cursor < map->capacity; (*cursor)++) {                                                                 \
+            size_t i = *cursor;                                                                                        \
+            if (map->ctrl[i] & 0x80) continue;                                                                         \
+            (*cursor)++;                                                                                               \
+            if (key) *key = map->slots[i].key;                                                                         \
+            if (value) *value = &map->slots[i].value;                                                                  \
+            return true;                                                                                               \
+        }                                                                                                              \
+        return false;                                                                                                  \
+    }
+
+#endif // HASHMAP_TYPED_H
@@ -0,0 +1,294 @@
+#ifndef HASHSET_H
+#define HASHSET_H
+
+#include "hashmap.h"
+#include "int_hashmap.h"
+#include "result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Set of byte-string keys: a CsHashMap whose entries carry no value, only the header and the key bytes
+// Every set hashes with cs_hash_wy, so set operations reuse the hash cached in each entry instead of rehashing
+typedef struct {
+    CsHashMap* map;
+} CsHashSet;
+
+// Set of integer keys: a CsIntHashMap whose slots hold the key alone (8 bytes per slot)
+typedef struct {
+    CsIntHashMap* map;
+} CsIntHashSet;
+
+/**
+ * Create a HashSet (takes ownership of the result)
+ * @return
+ *  the newly created HashSet
+ *  | NULL if it failed
+ */
+CsHashSet* cs_hashset_create(void);
+
+/**
+ * Create a HashSet sized to hold expected_entries without resizing (takes ownership of the result)
+ * @param expected_entries Number of keys the set will hold
+ * @return
+ *  the newly created HashSet
+ *  | NULL if it failed
+ */
+CsHashSet* cs_hashset_create_with_capacity(size_t expected_entries);
+
+/**
+ * Destroy the given HashSet
+ * @param set HashSet to destroy
+ */
+void cs_hashset_destroy(CsHashSet* set);
+
+/**
+ * Add a string key, its bytes are copied
+ * @param set HashSet to add to
+ * @param key String key
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ *  | CS_CONFLICT if the key is already in the set
+ */
+CsResult cs_hashset_add(CsHashSet* set, const char* key);
+
+/**
+ * Add a key of explicit length, its bytes are copied
+ * @param set HashSet to add to
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ *  | CS_CONFLICT if the key is already in the set
+ */
+CsResult cs_hashset_add_n(CsHashSet* set, const void* key, size_t key_len);
+
+/**
+ * Check if the HashSet contains a string key
+ * @param set HashSet to check
+ * @param key String key
+ * @return
+ *  true if the key is in the set
+ *  | false otherwise or if set or key is NULL
+ */
+bool cs_hashset_contains(const CsHashSet* set, const char* key);
+
+/**
+ * Check if the HashSet contains a key of explicit length
+ * @param set HashSet to check
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  true if the key is in the set
+ *  | false otherwise or if set or key is NULL
+ */
+bool cs_hashset_contains_n(const CsHashSet* set, const void* key, size_t key_len);
+
+/**
+ * Remove a string key
+ * @param set HashSet to remove from
+ * @param key String key
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_hashset_remove(CsHashSet* set, const char* key);
+
+/**
+ * Remove a key of explicit length
+ * @param set HashSet to remove from
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_hashset_remove_n(CsHashSet* set, const void* key, size_t key_len);
+
+/**
+ * Get the number of keys
+ * @param set HashSet to query
+ * @return
+ *  the number of keys
+ *  | 0 if set is NULL
+ */
+size_t cs_hashset_size(const CsHashSet* set);
+
+/**
+ * Remove every key
+ * @param set HashSet to clear
+ */
+void cs_hashset_clear(CsHashSet* set);
+
+/**
+ * Visit the next key, in insertion order
+ * Keys can be removed while iterating, an insertion invalidates the cursor
+ * @param set HashSet to iterate
+ * @param cursor Position in the set, start at 0
+ * @param key Where to store the key (NUL terminated), may be NULL
+ * @param key_len Where to store the key length, may be NULL
+ * @return
+ *  true if a key was visited
+ *  | false once every key has been visited or if set or cursor is NULL
+ */
+bool cs_hashset_next(const CsHashSet* set, size_t* cursor, const char** key, size_t* key_len);
+
+/**
+ * Keys in a, in b or in both, as a new set (takes ownership of the result)
+ * The result is sized once for both inputs and filled in one pass over each, reusing their cached hashes:
+ * a's keys are copied without any lookup, b's keys are only looked up in a
+ * @param a First set
+ * @param b Second set
+ * @return
+ *  the newly created HashSet
+ *  | NULL if a or b is NULL or if it failed
+ */
+CsHashSet* cs_hashset_union(const CsHashSet* a, const CsHashSet* b);
+
+/**
+ * Keys in both a and b, as a new set (takes ownership of the result)
+ * One pass over the smaller set, each key looked up in the larger one with its cached hash
+ * @param a First set
+ * @param b Second set
+ * @return
+ *  the newly created HashSet
+ *  | NULL if a or b is NULL or if it failed
+ */
+CsHashSet* cs_hashset_intersection(const CsHashSet* a, const CsHashSet* b);
+
+/**
+ * Keys in a but not in b, as a new set (takes ownership of the result)
+ * One pass over a, each key looked up in b with its cached hash
+ * @param a Set to take keys from
+ * @param b Set of keys to leave out
+ * @return
+ *  the newly created HashSet
+ *  | NULL if a or b is NULL or if it failed
+ */
+CsHashSet* cs_hashset_difference(const CsHashSet* a, const CsHashSet* b);
+
+/**
+ * Create an IntHashSet (takes ownership of the result)
+ * @return
+ *  the newly created IntHashSet
+ *  | NULL if it failed
+ */
+CsIntHashSet* cs_int_hashset_create(void);
+
+/**
+ * Create an IntHashSet sized to hold expected_entries without resizing (takes ownership of the result)
+ * @param expected_entries Number of keys the set will hold
+ * @return
+ *  the newly created IntHashSet
+ *  | NULL if it failed
+ */
+CsIntHashSet* cs_int_hashset_create_with_capacity(size_t expected_entries);
+
+/**
+ * Destroy the given IntHashSet
+ * @param set IntHashSet to destroy
+ */
+void cs_int_hashset_destroy(CsIntHashSet* set);
+
+/**
+ * Add an integer key
+ * @param set IntHashSet to add to
+ * @param key Key to add
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ *  | CS_CONFLICT if the key is already in the set
+ */
+CsResult cs_int_hashset_add(CsIntHashSet* set, uint64_t key);
+
+/**
+ * Check if the IntHashSet contains a key
+ * @param set IntHashSet to check
+ * @param key Key to check
+ * @return
+ *  true if the key is in the set
+ *  | false otherwise or if set is NULL
+ */
+bool cs_int_hashset_contains(const CsIntHashSet* set, uint64_t key);
+
+/**
+ * Remove an integer key
+ * @param set IntHashSet to remove from
+ * @param key Key to remove
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_int_hashset_remove(CsIntHashSet* set, uint64_t key);
+
+/**
+ * Get the number of keys
+ * @param set IntHashSet to query
+ * @return
+ *  the number of keys
+ *  | 0 if set is NULL
+ */
+size_t cs_int_hashset_size(const CsIntHashSet* set);
+
+/**
+ * Remove every key
+ * @param set IntHashSet to clear
+ */
+void cs_int_hashset_clear(CsIntHashSet* set);
+
+/**
+ * Visit the next key, in slot order
+ * The set must not be modified during the iteration
+ * @param set IntHashSet to iterate
+ * @param cursor Position in the set, start at 0
+ * @param key Where to store the key, may be NULL
+ * @return
+ *  true if a key was visited
+ *  | false once every key has been visited or if set or cursor is NULL
+ */
+bool cs_int_hashset_next(const CsIntHashSet* set, size_t* cursor, uint64_t* key);
+
+/**
+ * Keys in a, in b or in both, as a new set (takes ownership of the result)
+ * The result is sized once for both inputs: when it gets a's capacity and a has no tombstones, a's slot arrays
+ * are copied as is, otherwise a's keys are placed without any lookup; b's keys are only looked up in the result
+ * @param a First set
+ * @param b Second set
+ * @return
+ *  the newly created IntHashSet
+ *  | NULL if a or b is NULL or if it failed
+ */
+CsIntHashSet* cs_int_hashset_union(const CsIntHashSet* a, const CsIntHashSet* b);
+
+/**
+ * Keys in both a and b, as a new set (takes ownership of the result)
+ * One pass over the smaller set, each key looked up in the larger one
+ * @param a First set
+ * @param b Second set
+ * @return
+ *  the newly created IntHashSet
+ *  | NULL if a or b is NULL or if it failed
+ */
+CsIntHashSet* cs_int_hashset_intersection(const CsIntHashSet* a, const CsIntHashSet* b);
+
+/**
+ * Keys in a but not in b, as a new set (takes ownership of the result)
+ * One pass over a, each key looked up in b
+ * @param a Set to take keys from
+ * @param b Set of keys to leave out
+ * @return
+ *  the newly created IntHashSet
+ *  | NULL if a or b is NULL or if it failed
+ */
+CsIntHashSet* cs_int_hashset_difference(const CsIntHashSet* a, const CsIntHashSet* b);
+
+#endif // HASHSET_H
@@ -0,0 +1,150 @@
+#ifndef INT_HASHMAP_H
+#define INT_HASHMAP_H
+
+#include "hash.h"
+#include "hashmap.h"
+#include "result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Control byte of a slot: the top 7 bits of the hash when full, one of these (high bit set) otherwise
+#define CS_INT_HASHMAP_EMPTY 0x80
+#define CS_INT_HASHMAP_DELETED 0xFE
+
+// Hashmap keyed by integers (uint32_t keys convert losslessly to uint64_t)
+// The key is stored in the slot next to its value and hashed with cs_hash_u64, so there is no key formatting,
+// no key allocation and no string comparison. Open addressing with linear probing over one flat slot array
+// and one control byte per slot. Slots move on resize: value pointers are only valid until the next insertion
+typedef struct {
+    char* slots;       // capacity slots of slot_size bytes: uint64_t key then the value
+    uint8_t* ctrl;     // one control byte per slot
+    size_t capacity;   // power of two
+    size_t size;
+    size_t tombstones; // deleted slots not yet reclaimed
+    size_t value_size;
+    size_t slot_size;  // sizeof(uint64_t) + value_size, rounded up to 8 bytes, slot = hash & (capacity - 1)
+} CsIntHashMap;
+
+/**
+ * Create an IntHashMap (takes ownership of the result)
+ * @param value_size Size of the values in bytes
+ * @return
+ *  the newly created IntHashMap
+ *  | NULL if it failed
+ */
+CsIntHashMap* cs_int_hashmap_create(size_t value_size);
+
+/**
+ * Create an IntHashMap sized to hold expected_entries without resizing (takes ownership of the result)
+ * @param value_size Size of the values in bytes
+ * @param expected_entries Number of entries the map will hold
+ * @return
+ *  the newly created IntHashMap
+ *  | NULL if it failed or if the capacity would overflow
+ */
+CsIntHashMap* cs_int_hashmap_create_with_capacity(size_t value_size, size_t expected_entries);
+
+/**
+ * Destroy the given IntHashMap
+ * @param map IntHashMap to destroy
+ */
+void cs_int_hashmap_destroy(CsIntHashMap* map);
+
+/**
+ * Get a value using the given key
+ * @param map IntHashMap to retrieve the value from
+ * @param key Associated key
+ * @return
+ *  a pointer to the value, valid until the next insertion
+ *  | NULL if map is NULL or if the key is absent
+ */
+void* cs_int_hashmap_get(const CsIntHashMap* map, uint64_t key);
+
+/**
+ * Check if the IntHashMap contains the given key
+ * @param map IntHashMap to check
+ * @param key Key to check
+ * @return
+ *  true if the map contains the key
+ *  | false otherwise or if map is NULL
+ */
+bool cs_int_hashmap_has(const CsIntHashMap* map, uint64_t key);
+
+/**
+ * Insert a key/value pair, the value is copied
+ * @param map IntHashMap to insert into
+ * @param key Key to insert
+ * @param value Value to copy
+ * @return
+ *  CS_SUCCESS on success
+ *  | CS_NULL_POINTER if map or value is NULL
+ *  | CS_CONFLICT if the key is already present
+ *  | CS_ALLOCATION_FAILED if growing the map failed
+ */
+CsResult cs_int_hashmap_insert(CsIntHashMap* map, uint64_t key, const void* value);
+
+/**
+ * Insert a key/value pair, or overwrite the value if the key is present
+ * @param map IntHashMap to insert into
+ * @param key Key to insert or update
+ * @param value Value to copy
+ * @return
+ *  a pointer to the stored value, valid until the next insertion
+ *  | NULL if map or value is NULL or if growing the map failed
+ */
+void* cs_int_hashmap_upsert(CsIntHashMap* map, uint64_t key, const void* value);
+
+/**
+ * Remove a key and its value
+ * @param map IntHashMap to remove from
+ * @param key Key to remove
+ * @return
+ *  CS_SUCCESS on success
+ *  | CS_NULL_POINTER if map is NULL
+ *  | CS_NOT_FOUND if the key is absent
+ */
+CsResult cs_int_hashmap_remove(CsIntHashMap* map, uint64_t key);
+
+/**
+ * Remove a key and copy its value out in a single probe
+ * @param map IntHashMap to remove from
+ * @param key Key to remove
+ * @param out_value Where to copy the value, NULL to drop it
+ * @return
+ *  CS_SUCCESS on success
+ *  | CS_NULL_POINTER if map is NULL
+ *  | CS_NOT_FOUND if the key is absent
+ */
+CsResult cs_int_hashmap_take(CsIntHashMap* map, uint64_t key, void* out_value);
+
+/**
+ * Remove every entry, the capacity is kept
+ * @param map IntHashMap to clear
+ */
+void cs_int_hashmap_clear(CsIntHashMap* map);
+
+/**
+ * Get the number of entries
+ * @param map IntHashMap to query
+ * @return
+ *  the number of entries
+ *  | 0 if map is NULL
+ */
+size_t cs_int_hashmap_size(const CsIntHashMap* map);
+
+/**
+ * Visit the next entry, in slot order
+ * The map must not be modified during the iteration
+ * @param map IntHashMap to iterate
+ * @param cursor Position in the map, start at 0
+ * @param key Where to store the key, may be NULL
+ * @param value Where to store a pointer to the value, may be NULL
+ * @return
+ *  true if an entry was visited
+ *  | false once every entry has been visited or if map or cursor is NULL
+ */
+bool cs_int_hashmap_next(const CsIntHashMap* map, size_t* cursor, uint64_t* key, void** value);
+
+#endif // INT_HASHMAP_H
@@ -0,0 +1,140 @@
+#ifndef INTERN_TABLE_H
+#define INTERN_TABLE_H
+
+#include "hash.h"
+#include "result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define INTERN_TABLE_CHUNK_SIZE 65536 // arena bytes allocated at a time, longer strings get a chunk of their own
+
+// ID of an interned string: dense, in interning order from 0
+typedef uint32_t CsInternId;
+
+typedef struct {
+    const char* str; // canonical copy in the arena, NUL terminated
+    size_t len;      // length in bytes, without the NUL byte
+    uint64_t hash;   // cs_hash_wy of the bytes, reused when the index grows
+} CsInternString;
+
+// Deduplicating string table: each distinct byte string is stored once and gets a canonical pointer and an ID
+// Bytes go to an append-only arena of INTERN_TABLE_CHUNK_SIZE chunks that never move or shrink, so canonical
+// pointers stay valid until the table is destroyed and equal strings compare by pointer or ID.
+// Lookups hash with cs_hash_wy into a flat open-addressing index of 8-byte slots (high hash bits + ID)
+typedef struct {
+    CsInternString* strings; // indexed by ID
+    size_t size;
+    size_t strings_capacity;
+    uint64_t* index;       // 0 = empty, otherwise (hash & 0xFFFFFFFF00000000) | (id + 1)
+    size_t index_capacity; // power of two
+    unsigned int shift;    // 64 - log2(index_capacity), slot = (hash * 2^64/phi) >> shift
+    char** chunks;         // every arena chunk, for destruction
+    size_t chunk_count;
+    size_t chunk_capacity;
+    char* cursor;       // next free byte of the current chunk
+    size_t remaining;   // free bytes left in the current chunk
+    size_t arena_bytes; // bytes allocated for the arena
+} CsInternTable;
+
+/**
+ * Create an InternTable (takes ownership of the result)
+ * @return
+ *  the newly created InternTable
+ *  | NULL if it failed
+ */
+CsInternTable* cs_intern_table_create(void);
+
+/**
+ * Create an InternTable sized to hold expected_strings distinct strings without growing its index
+ * (takes ownership of the result)
+ * @param expected_strings Number of distinct strings the table will hold
+ * @return
+ *  the newly created InternTable
+ *  | NULL if it failed
+ */
+CsInternTable* cs_intern_table_create_with_capacity(size_t expected_strings);
+
+/**
+ * Destroy the given InternTable, every canonical pointer it returned becomes invalid
+ * @param table InternTable to destroy
+ */
+void cs_intern_table_destroy(CsInternTable* table);
+
+/**
+ * Intern a string: look it up and copy it into the arena the first time it is seen
+ * @param table InternTable to intern into
+ * @param str String to intern
+ * @param out_id Where to store the ID of the string, may be NULL
+ * @return
+ *  the canonical copy of str, the same pointer for every equal string
+ *  | NULL if table or str is NULL, if the table holds UINT32_MAX strings or if it failed
+ */
+const char* cs_intern_table_intern(CsInternTable* table, const char* str, CsInternId* out_id);
+
+/**
+ * Intern a byte string of explicit length, the canonical copy is NUL terminated
+ * @param table InternTable to intern into
+ * @param str Bytes to intern
+ * @param len Length of str in bytes
+ * @param out_id Where to store the ID of the string, may be NULL
+ * @return
+ *  the canonical copy of str, the same pointer for every equal byte string
+ *  | NULL if table or str is NULL, if the table holds UINT32_MAX strings or if it failed
+ */
+const char* cs_intern_table_intern_n(CsInternTable* table, const void* str, size_t len, CsInternId* out_id);
+
+/**
+ * Look a string up without interning it
+ * @param table InternTable to search
+ * @param str String to look up
+ * @param out_id Where to store the ID of the string, may be NULL
+ * @return
+ *  the canonical copy of str
+ *  | NULL if str was never interned or if table or str is NULL
+ */
+const char* cs_intern_table_find(const CsInternTable* table, const char* str, CsInternId* out_id);
+
+/**
+ * Look a byte string of explicit length up without interning it
+ * @param table InternTable to search
+ * @param str Bytes to look up
+ * @param len Length of str in bytes
+ * @param out_id Where to store the ID of the string, may be NULL
+ * @return
+ *  the canonical copy of str
+ *  | NULL if str was never interned or if table or str is NULL
+ */
+const char* cs_intern_table_find_n(const CsInternTable* table, const void* str, size_t len, CsInternId* out_id);
+
+/**
+ * Get the canonical string of an ID
+ * @param table InternTable to query
+ * @param id ID returned when the string was interned
+ * @param out_len Where to store the length of the string, may be NULL
+ * @return
+ *  the canonical string
+ *  | NULL if id is unknown or if table is NULL
+ */
+const char* cs_intern_table_get(const CsInternTable* table, CsInternId id, size_t* out_len);
+
+/**
+ * Get the number of distinct strings
+ * @param table InternTable to query
+ * @return
+ *  the number of interned strings
+ *  | 0 if table is NULL
+ */
+size_t cs_intern_table_size(const CsInternTable* table);
+
+/**
+ * Get the memory held by the table: arena chunks, string records and index
+ * @param table InternTable to query
+ * @return
+ *  the number of bytes allocated by the table
+ *  | 0 if table is NULL
+ */
+size_t cs_intern_table_memory(const CsInternTable* table);
+
+#endif // INTERN_TABLE_H
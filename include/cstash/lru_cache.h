@@ -0,0 +1,188 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include "hashmap.h"
+#include "result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Recency links of a cached entry, stored in the hashmap entry right before the value: one allocation per entry,
+// and moving or evicting an entry touches no other memory than its neighbours
+typedef struct {
+    CsHashMapEntry* prev; // more recently used
+    CsHashMapEntry* next; // less recently used
+    size_t charge;        // bytes counted against max_bytes
+    char pad[16 - (2 * sizeof(CsHashMapEntry*) + sizeof(size_t)) % 16]; // keeps the value 16-byte aligned
+} CsLruLinks;
+
+// Compile-time check: a negative array size if the links would misalign the value that follows them
+typedef char cs_lru_links_aligned[sizeof(CsLruLinks) % 16 == 0 ? 1 : -1];
+
+/**
+ * Cost of an entry against the byte budget, see CsLruCacheOptions
+ * @param key Key of the entry
+ * @param key_len Length of key in bytes
+ * @param value Value of the entry
+ * @return the number of bytes the entry holds
+ */
+typedef size_t (*CsLruChargeFunction)(const void* key, size_t key_len, const void* value);
+
+/**
+ * Cache bounds and callbacks, zero-initialize to get the defaults; at least one bound must be set
+ * @param max_entries Evict once the cache holds more entries than this (0: no entry bound)
+ * @param max_bytes Evict once the summed charges of the entries exceed this (0: no byte budget)
+ * @param charge Cost of an entry against max_bytes (default key_len + value_size)
+ * @param destructor Optional destructor called on a value (pointer to its slot) when the cache drops it:
+ * eviction, remove, overwrite by put, clear and destroy
+ */
+typedef struct {
+    size_t max_entries;
+    size_t max_bytes;
+    CsLruChargeFunction charge;
+    void (*destructor)(void*);
+} CsLruCacheOptions;
+
+// Hashmap of entries threaded on a doubly linked recency list, most recently used first
+typedef struct {
+    CsHashMap* map;       // values are a CsLruLinks followed by the user value
+    CsHashMapEntry* head; // most recently used
+    CsHashMapEntry* tail; // least recently used, evicted first
+    size_t value_size;
+    size_t bytes; // summed charges of the entries
+    CsLruCacheOptions options;
+    uint64_t hits;      // cs_lru_cache_get() calls that found their key
+    uint64_t misses;    // cs_lru_cache_get() calls that did not
+    uint64_t evictions; // entries dropped to stay within the bounds
+} CsLruCache;
+
+/**
+ * Create an LruCache (takes ownership of the result)
+ * @param value_size Size in bytes of each value
+ * @param options Bounds and callbacks, max_entries or max_bytes must be non zero
+ * @return
+ *  the newly created LruCache
+ *  | NULL if value_size == 0, if options is NULL or sets no bound, or if it failed
+ */
+CsLruCache* cs_lru_cache_create(size_t value_size, const CsLruCacheOptions* options);
+
+/**
+ * Destroy the given LruCache
+ * @param cache LruCache to destroy
+ */
+void cs_lru_cache_destroy(CsLruCache* cache);
+
+/**
+ * Get the value of a string key and mark the entry as most recently used, counted as a hit or a miss
+ * @param cache LruCache to search
+ * @param key String key
+ * @return
+ *  pointer to the value, valid until the entry is evicted or removed
+ *  | NULL if the key is absent or if cache or key is NULL
+ */
+void* cs_lru_cache_get(CsLruCache* cache, const char* key);
+
+/**
+ * Get the value of a key of explicit length and mark the entry as most recently used
+ * @param cache LruCache to search
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  pointer to the value, valid until the entry is evicted or removed
+ *  | NULL if the key is absent or if cache or key is NULL
+ */
+void* cs_lru_cache_get_n(CsLruCache* cache, const void* key, size_t key_len);
+
+/**
+ * Get the value of a string key without touching its recency or the counters
+ * @param cache LruCache to search
+ * @param key String key
+ * @return
+ *  pointer to the value
+ *  | NULL if the key is absent or if cache or key is NULL
+ */
+void* cs_lru_cache_peek(const CsLruCache* cache, const char* key);
+
+/**
+ * Insert or overwrite a string key as the most recently used entry, evicting from the least recently used
+ * end until the bounds hold
+ * @param cache LruCache to insert into
+ * @param key String key
+ * @param value Value to copy
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ *  | CS_OUT_OF_BOUNDS if the charge of the entry alone exceeds max_bytes (the cache is left unchanged)
+ */
+CsResult cs_lru_cache_put(CsLruCache* cache, const char* key, const void* value);
+
+/**
+ * Insert or overwrite a key of explicit length as the most recently used entry
+ * @param cache LruCache to insert into
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @param value Value to copy
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ *  | CS_OUT_OF_BOUNDS if the charge of the entry alone exceeds max_bytes (the cache is left unchanged)
+ */
+CsResult cs_lru_cache_put_n(CsLruCache* cache, const void* key, size_t key_len, const void* value);
+
+/**
+ * Remove a string key
+ * @param cache LruCache to remove from
+ * @param key String key
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_lru_cache_remove(CsLruCache* cache, const char* key);
+
+/**
+ * Remove a key of explicit length
+ * @param cache LruCache to remove from
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_lru_cache_remove_n(CsLruCache* cache, const void* key, size_t key_len);
+
+/**
+ * Remove every entry, the counters are kept
+ * @param cache LruCache to clear
+ */
+void cs_lru_cache_clear(CsLruCache* cache);
+
+/**
+ * Get the number of entries
+ * @param cache LruCache to query
+ * @return
+ *  the number of entries
+ *  | 0 if cache is NULL
+ */
+size_t cs_lru_cache_size(const CsLruCache* cache);
+
+/**
+ * Get the share of cs_lru_cache_get() calls that found their key
+ * @param cache LruCache to query
+ * @return
+ *  hits / (hits + misses)
+ *  | 0 if there was no lookup yet or if cache is NULL
+ */
+double cs_lru_cache_hit_rate(const CsLruCache* cache);
+
+/**
+ * Reset the hit, miss and eviction counters
+ * @param cache LruCache to reset
+ */
+void cs_lru_cache_reset_stats(CsLruCache* cache);
+
+#endif // LRU_CACHE_H
@@ -8,6 +8,7 @@ typedef enum {
     CS_OUT_OF_BOUNDS = 3,
     CS_CONFLICT = 4,
     CS_NOT_FOUND = 5,
+    CS_IO_ERROR = 6,
 } CsResult;
 
 #endif // RESULT_H
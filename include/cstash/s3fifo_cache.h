@@ -0,0 +1,227 @@
+#ifndef S3FIFO_CACHE_H
+#define S3FIFO_CACHE_H
+
+#include "hashmap.h"
+#include "int_hashmap.h"
+#include "result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define S3FIFO_SMALL_FRACTION 0.1 // default share of the entries held by the small queue
+#define S3FIFO_MAX_FREQ 3         // access counts saturate here
+
+// Queue links of a cached entry, stored in the hashmap entry right before the value
+typedef struct {
+    CsHashMapEntry* older;
+    CsHashMapEntry* newer;
+    uint8_t freq;  // accesses since insertion or the last pass of eviction, 0 to S3FIFO_MAX_FREQ
+    uint8_t queue; // queue holding the entry, small or main
+    char pad[16 - (2 * sizeof(CsHashMapEntry*) + 2 * sizeof(uint8_t)) % 16]; // keeps the value 16-byte aligned
+} CsS3FifoLinks;
+
+// Compile-time check: a negative array size if the links would misalign the value that follows them
+typedef char cs_s3fifo_links_aligned[sizeof(CsS3FifoLinks) % 16 == 0 ? 1 : -1];
+
+typedef struct {
+    CsHashMapEntry* oldest; // next candidate for eviction
+    CsHashMapEntry* newest;
+    size_t size;
+} CsS3FifoQueue;
+
+/**
+ * Cache bound and callbacks, zero-initialize to get the defaults
+ * @param max_entries Number of entries the cache holds, required
+ * @param small_fraction Share of max_entries given to the small queue (default S3FIFO_SMALL_FRACTION)
+ * @param destructor Optional destructor called on a value (pointer to its slot) when the cache drops it:
+ * eviction, remove, overwrite by put, clear and destroy
+ */
+typedef struct {
+    size_t max_entries;
+    double small_fraction;
+    void (*destructor)(void*);
+} CsS3FifoCacheOptions;
+
+// Scan-resistant cache with S3-FIFO eviction: new keys enter a small FIFO queue, and only keys hit while in it
+// move on to the main queue, so a one-pass scan flushes the small queue but not the main one. The main queue is
+// a CLOCK: its oldest entry is reinserted with one access less while it has any. Keys evicted from the small
+// queue leave their hash in a ghost queue, a key coming back while its ghost is there goes straight to main.
+// A hit only bumps the access count stored in the entry, queue links are written by insertions and evictions
+typedef struct {
+    CsHashMap* map; // values are a CsS3FifoLinks followed by the user value
+    CsS3FifoQueue small;
+    CsS3FifoQueue main;
+    size_t small_capacity;
+    uint64_t* ghost_ring;  // hashes of the keys evicted from the small queue, oldest overwritten first
+    size_t ghost_capacity; // as many ghosts as the main queue has entries
+    uint64_t ghost_count;  // hashes pushed so far, the next one goes to ghost_ring[ghost_count % ghost_capacity]
+    CsIntHashMap* ghosts;  // hash -> position in the push sequence, for the ghosts still in the ring
+    size_t value_size;
+    CsS3FifoCacheOptions options;
+    uint64_t hits;      // cs_s3fifo_cache_get() calls that found their key
+    uint64_t misses;    // cs_s3fifo_cache_get() calls that did not
+    uint64_t evictions; // entries dropped to stay within max_entries
+} CsS3FifoCache;
+
+/**
+ * Create an S3FifoCache (takes ownership of the result)
+ * @param value_size Size in bytes of each value
+ * @param options Bound and callbacks, max_entries must be non zero
+ * @return
+ *  the newly created S3FifoCache
+ *  | NULL if value_size == 0, if options is NULL or max_entries == 0, or if it failed
+ */
+CsS3FifoCache* cs_s3fifo_cache_create(size_t value_size, const CsS3FifoCacheOptions* options);
+
+/**
+ * Destroy the given S3FifoCache
+ * @param cache S3FifoCache to destroy
+ */
+void cs_s3fifo_cache_destroy(CsS3FifoCache* cache);
+
+/**
+ * Get the value of a string key and count the access, counted as a hit or a miss
+ * @param cache S3FifoCache to search
+ * @param key String key
+ * @return
+ *  pointer to the value, valid until the entry is evicted or removed
+ *  | NULL if the key is absent or if cache or key is NULL
+ */
+void* cs_s3fifo_cache_get(CsS3FifoCache* cache, const char* key);
+
+/**
+ * Get the value of a key of explicit length and count the access
+ * @param cache S3FifoCache to search
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  pointer to the value, valid until the entry is evicted or removed
+ *  | NULL if the key is absent or if cache or key is NULL
+ */
+void* cs_s3fifo_cache_get_n(CsS3FifoCache* cache, const void* key, size_t key_len);
+
+/**
+ * Get the value of a string key and count the access, leaving the hit and miss counters alone
+ * The only write is a relaxed atomic store to the access count of the entry (skipped once it saturates), so
+ * several threads can call it at once while no thread modifies the cache, e.g. under the read side of a lock
+ * @param cache S3FifoCache to search
+ * @param key String key
+ * @return
+ *  pointer to the value
+ *  | NULL if the key is absent or if cache or key is NULL
+ */
+void* cs_s3fifo_cache_lookup(const CsS3FifoCache* cache, const char* key);
+
+/**
+ * Get the value of a key of explicit length, see cs_s3fifo_cache_lookup()
+ * @param cache S3FifoCache to search
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  pointer to the value
+ *  | NULL if the key is absent or if cache or key is NULL
+ */
+void* cs_s3fifo_cache_lookup_n(const CsS3FifoCache* cache, const void* key, size_t key_len);
+
+/**
+ * Check if a string key is cached, without counting an access
+ * @param cache S3FifoCache to search
+ * @param key String key
+ * @return
+ *  true if the key is cached
+ *  | false otherwise or if cache or key is NULL
+ */
+bool cs_s3fifo_cache_contains(const CsS3FifoCache* cache, const char* key);
+
+/**
+ * Check if a key of explicit length is cached, without counting an access
+ * @param cache S3FifoCache to search
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  true if the key is cached
+ *  | false otherwise or if cache or key is NULL
+ */
+bool cs_s3fifo_cache_contains_n(const CsS3FifoCache* cache, const void* key, size_t key_len);
+
+/**
+ * Insert or overwrite a string key. A new key enters the small queue, or the main queue if its ghost is
+ * still there; when the cache is full an entry is evicted first. An overwrite counts as an access
+ * @param cache S3FifoCache to insert into
+ * @param key String key
+ * @param value Value to copy
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ */
+CsResult cs_s3fifo_cache_put(CsS3FifoCache* cache, const char* key, const void* value);
+
+/**
+ * Insert or overwrite a key of explicit length, see cs_s3fifo_cache_put()
+ * @param cache S3FifoCache to insert into
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @param value Value to copy
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_ALLOCATION_FAILED
+ */
+CsResult cs_s3fifo_cache_put_n(CsS3FifoCache* cache, const void* key, size_t key_len, const void* value);
+
+/**
+ * Remove a string key
+ * @param cache S3FifoCache to remove from
+ * @param key String key
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_s3fifo_cache_remove(CsS3FifoCache* cache, const char* key);
+
+/**
+ * Remove a key of explicit length
+ * @param cache S3FifoCache to remove from
+ * @param key Key bytes
+ * @param key_len Length of key in bytes
+ * @return
+ *  CS_SUCCESS
+ *  | CS_NULL_POINTER
+ *  | CS_NOT_FOUND
+ */
+CsResult cs_s3fifo_cache_remove_n(CsS3FifoCache* cache, const void* key, size_t key_len);
+
+/**
+ * Remove every entry and ghost, the counters are kept
+ * @param cache S3FifoCache to clear
+ */
+void cs_s3fifo_cache_clear(CsS3FifoCache* cache);
+
+/**
+ * Get the number of entries
+ * @param cache S3FifoCache to query
+ * @return
+ *  the number of entries
+ *  | 0 if cache is NULL
+ */
+size_t cs_s3fifo_cache_size(const CsS3FifoCache* cache);
+
+/**
+ * Get the share of cs_s3fifo_cache_get() calls that found their key
+ * @param cache S3FifoCache to query
+ * @return
+ *  hits / (hits + misses)
+ *  | 0 if there was no lookup yet or if cache is NULL
+ */
+double cs_s3fifo_cache_hit_rate(const CsS3FifoCache* cache);
+
+/**
+ * Reset the hit, miss and eviction counters
+ * @param cache S3FifoCache to reset
+ */
+void cs_s3fifo_cache_reset_stats(CsS3FifoCache* cache);
+
+#endif // S3FIFO_CACHE_H
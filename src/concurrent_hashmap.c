@@ -0,0 +1,436 @@
+// pthread_rwlock_t and posix_memalign() are hidden in strict C99 without this
+#define _POSIX_C_SOURCE 200112L
+
+#include "cstash/concurrent_hashmap.h"
+#include "cstash/hashmap.h"
+#include "cstash/result.h"
+#include "epoch_internal.h"
+#include "hashmap_internal.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Chained table of the lock-free read mode: published with a release store and never modified in place
+// except for bucket heads and next links, which readers load with acquire semantics
+typedef struct {
+    size_t capacity;
+    unsigned int shift;
+    CsHashMapEntry* buckets[];
+} CsRcuTable;
+
+#define SHARD_PAYLOAD (sizeof(pthread_rwlock_t) + sizeof(CsHashMap*) + sizeof(CsRcuTable*) + sizeof(size_t))
+
+struct cs_concurrent_shard {
+    pthread_rwlock_t lock; // readers and writers, or writers only with lock_free_reads
+    CsHashMap* map;        // NULL with lock_free_reads
+    CsRcuTable* table;     // lock_free_reads only
+    size_t size;           // lock_free_reads only
+    // shards never share a cache line, so locking one does not invalidate its neighbours
+    char padding[CONCURRENT_HASHMAP_CACHE_LINE - SHARD_PAYLOAD % CONCURRENT_HASHMAP_CACHE_LINE];
+};
+
+// Bits 32+ of the hash pick the shard: the chained engine indexes on hash * 2^64/phi and the swiss engine
+// on the low bits and the top 7 bits, so keys of one shard still spread over its buckets
+static inline CsConcurrentShard* concurrent_shard_for(const CsConcurrentHashMap* map, uint64_t hash) {
+    return &map->shards[(size_t)(hash >> 32) & (map->shard_count - 1)];
+}
+
+// ========================================
+// Copy-on-write tables (lock_free_reads)
+// ========================================
+
+static CsRcuTable* rcu_table_create(size_t capacity) {
+    if (capacity > (SIZE_MAX - sizeof(CsRcuTable)) / sizeof(CsHashMapEntry*)) return NULL;
+
+    CsRcuTable* table = calloc(1, sizeof(CsRcuTable) + capacity * sizeof(CsHashMapEntry*));
+    if (!table) return NULL;
+
+    table->capacity = capacity;
+    table->shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) table->shift--;
+    return table;
+}
+
+static inline size_t rcu_index(const CsRcuTable* table, uint64_t hash) {
+    return (size_t)((hash * CS_FIBONACCI_MULTIPLIER) >> table->shift);
+}
+
+// Frees the table and every entry still linked in it, used once the table has been replaced
+static void rcu_table_free(void* ptr) {
+    CsRcuTable* table = ptr;
+    for (size_t i = 0; i < table->capacity; i++) {
+        CsHashMapEntry* entry = table->buckets[i];
+        while (entry) {
+            CsHashMapEntry* next = entry->next;
+            cs_hashmap_free_entry(entry);
+            entry = next;
+        }
+    }
+    free(table);
+}
+
+static void rcu_entry_free(void* entry) {
+    cs_hashmap_free_entry(entry);
+}
+
+// Reader side: only acquire loads, entries reached this way are immutable
+static CsHashMapEntry* rcu_find(CsConcurrentShard* shard, uint64_t hash, const void* key, size_t key_len) {
+    CsRcuTable* table = __atomic_load_n(&shard->table, __ATOMIC_ACQUIRE);
+    CsHashMapEntry* entry = __atomic_load_n(&table->buckets[rcu_index(table, hash)], __ATOMIC_ACQUIRE);
+    while (entry) {
+        if (cs_hashmap_entry_matches(entry, hash, key, key_len)) return entry;
+        entry = __atomic_load_n(&entry->next, __ATOMIC_ACQUIRE);
+    }
+    return NULL;
+}
+
+// Writer side (shard lock held): address of the link pointing to the matching entry, or NULL
+static CsHashMapEntry** rcu_find_link(CsConcurrentShard* shard, uint64_t hash, const void* key, size_t key_len) {
+    CsRcuTable* table = shard->table;
+    CsHashMapEntry** link = &table->buckets[rcu_index(table, hash)];
+    while (*link) {
+        if (cs_hashmap_entry_matches(*link, hash, key, key_len)) return link;
+        link = &(*link)->next;
+    }
+    return NULL;
+}
+
+// Copy every entry into a table twice as large: readers may still be walking the old chains,
+// so they cannot be relinked in place. On allocation failure the shard keeps its current table
+static void rcu_grow(CsConcurrentHashMap* map, CsConcurrentShard* shard) {
+    CsRcuTable* old_table = shard->table;
+    CsRcuTable* table = rcu_table_create(old_table->capacity * 2);
+    if (!table) return;
+
+    for (size_t i = 0; i < old_table->capacity; i++) {
+        for (CsHashMapEntry* entry = old_table->buckets[i]; entry; entry = entry->next) {
+            CsHashMapEntry* copy =
+                cs_hashmap_new_entry(entry->key, entry->key_len, entry->hash, entry->data, map->value_size);
+            if (!copy) {
+                rcu_table_free(table);
+                return;
+            }
+            size_t index = rcu_index(table, copy->hash);
+            copy->next = table->buckets[index];
+            table->buckets[index] = copy;
+        }
+    }
+
+    __atomic_store_n(&shard->table, table, __ATOMIC_RELEASE);
+    cs_epoch_retire(map->epoch, old_table, rcu_table_free);
+}
+
+// Writer side (shard lock held): link a new entry at the head of its bucket, or replace an existing one
+static CsResult rcu_put(CsConcurrentHashMap* map, CsConcurrentShard* shard, uint64_t hash, const void* key,
+                        size_t key_len, const void* value, bool overwrite) {
+    CsHashMapEntry** link = rcu_find_link(shard, hash, key, key_len);
+    if (link && !overwrite) return CS_CONFLICT;
+
+    CsHashMapEntry* entry = cs_hashmap_new_entry(key, key_len, hash, value, map->value_size);
+    if (!entry) return CS_ALLOCATION_FAILED;
+
+    if (link) {
+        CsHashMapEntry* old = *link;
+        entry->next = old->next;
+        __atomic_store_n(link, entry, __ATOMIC_RELEASE);
+        cs_epoch_retire(map->epoch, old, rcu_entry_free);
+        return CS_SUCCESS;
+    }
+
+    CsRcuTable* table = shard->table;
+    CsHashMapEntry** head = &table->buckets[rcu_index(table, hash)];
+    entry->next = *head;
+    __atomic_store_n(head, entry, __ATOMIC_RELEASE);
+
+    size_t size = shard->size + 1;
+    __atomic_store_n(&shard->size, size, __ATOMIC_RELAXED);
+    if ((float)size / table->capacity > HASHMAP_MAX_LOAD_FACTOR) rcu_grow(map, shard);
+    return CS_SUCCESS;
+}
+
+static CsResult rcu_remove(CsConcurrentHashMap* map, CsConcurrentShard* shard, uint64_t hash, const void* key,
+                           size_t key_len) {
+    CsHashMapEntry** link = rcu_find_link(shard, hash, key, key_len);
+    if (!link) return CS_NOT_FOUND;
+
+    // the removed entry keeps its next link, so a reader standing on it still reaches the rest of the chain
+    CsHashMapEntry* entry = *link;
+    __atomic_store_n(link, entry->next, __ATOMIC_RELEASE);
+    __atomic_store_n(&shard->size, shard->size - 1, __ATOMIC_RELAXED);
+    cs_epoch_retire(map->epoch, entry, rcu_entry_free);
+    return CS_SUCCESS;
+}
+
+// ========================================
+// ConcurrentHashMap
+// ========================================
+
+CsConcurrentHashMap* cs_concurrent_hashmap_create(size_t value_size) {
+    return cs_concurrent_hashmap_create_with_options(value_size, NULL);
+}
+
+static bool concurrent_shard_init(CsConcurrentHashMap* map, CsConcurrentShard* shard,
+                                  const CsConcurrentHashMapOptions* options) {
+    shard->map = NULL;
+    shard->table = NULL;
+    shard->size = 0;
+
+    if (map->lock_free_reads) {
+        shard->table = rcu_table_create(HASHMAP_DEFAULT_CAPACITY);
+    } else {
+        shard->map = cs_hashmap_create_with_options(map->value_size, options ? &options->map : NULL);
+    }
+
+    if ((!shard->map && !shard->table) || pthread_rwlock_init(&shard->lock, NULL) != 0) {
+        cs_hashmap_destroy(shard->map);
+        free(shard->table);
+        return false;
+    }
+    return true;
+}
+
+CsConcurrentHashMap* cs_concurrent_hashmap_create_with_options(size_t value_size,
+                                                               const CsConcurrentHashMapOptions* options) {
+    if (value_size == 0) return NULL;
+
+    bool lock_free_reads = options && options->lock_free_reads;
+    if (lock_free_reads && (options->map.engine != CS_HASHMAP_CHAINED || options->map.incremental ||
+                            options->map.destructor)) {
+        return NULL;
+    }
+
+    size_t requested = options && options->shards ? options->shards : CONCURRENT_HASHMAP_DEFAULT_SHARDS;
+    if (requested > ((size_t)1 << 31)) return NULL;
+    size_t shard_count = 1;
+    while (shard_count < requested) shard_count *= 2;
+
+    CsConcurrentHashMap* map = malloc(sizeof(CsConcurrentHashMap));
+    if (!map) return NULL;
+
+    void* shards = NULL;
+    if (posix_memalign(&shards, CONCURRENT_HASHMAP_CACHE_LINE, shard_count * sizeof(CsConcurrentShard)) != 0) {
+        free(map);
+        return NULL;
+    }
+
+    map->shards = shards;
+    map->shard_count = 0;
+    map->value_size = value_size;
+    map->hash = options && options->map.hash ? options->map.hash : cs_hash_wy;
+    map->lock_free_reads = lock_free_reads;
+    map->epoch = NULL;
+
+    if (lock_free_reads) {
+        map->epoch = cs_epoch_create();
+        if (!map->epoch) {
+            cs_concurrent_hashmap_destroy(map);
+            return NULL;
+        }
+    }
+
+    for (; map->shard_count < shard_count; map->shard_count++) {
+        if (!concurrent_shard_init(map, &map->shards[map->shard_count], options)) {
+            cs_concurrent_hashmap_destroy(map);
+            return NULL;
+        }
+    }
+
+    return map;
+}
+
+void cs_concurrent_hashmap_destroy(CsConcurrentHashMap* map) {
+    if (!map) return;
+
+    for (size_t i = 0; i < map->shard_count; i++) {
+        pthread_rwlock_destroy(&map->shards[i].lock);
+        cs_hashmap_destroy(map->shards[i].map);
+        if (map->shards[i].table) rcu_table_free(map->shards[i].table);
+    }
+    cs_epoch_destroy(map->epoch);
+    free(map->shards);
+    free(map);
+}
+
+CsResult cs_concurrent_hashmap_get(CsConcurrentHashMap* map, const char* key, void* out_value) {
+    if (!map || !key || !out_value) return CS_NULL_POINTER;
+
+    return cs_concurrent_hashmap_get_n(map, key, strlen(key), out_value);
+}
+
+CsResult cs_concurrent_hashmap_get_n(CsConcurrentHashMap* map, const void* key, size_t key_len, void* out_value) {
+    if (!map || !key || !out_value) return CS_NULL_POINTER;
+
+    uint64_t hash = map->hash(key, key_len);
+    CsConcurrentShard* shard = concurrent_shard_for(map, hash);
+    CsHashMapEntry* entry;
+
+    if (map->lock_free_reads) {
+        CsEpochReader* reader = cs_epoch_enter(map->epoch);
+        if (!reader) return CS_ALLOCATION_FAILED;
+        entry = rcu_find(shard, hash, key, key_len);
+        if (entry) memcpy(out_value, entry->data, map->value_size);
+        cs_epoch_exit(reader);
+    } else {
+        pthread_rwlock_rdlock(&shard->lock);
+        entry = cs_hashmap_find(shard->map, hash, key, key_len);
+        if (entry) memcpy(out_value, entry->data, map->value_size);
+        pthread_rwlock_unlock(&shard->lock);
+    }
+
+    return entry ? CS_SUCCESS : CS_NOT_FOUND;
+}
+
+bool cs_concurrent_hashmap_has(CsConcurrentHashMap* map, const char* key) {
+    if (!map || !key) return false;
+
+    return cs_concurrent_hashmap_has_n(map, key, strlen(key));
+}
+
+bool cs_concurrent_hashmap_has_n(CsConcurrentHashMap* map, const void* key, size_t key_len) {
+    if (!map || !key) return false;
+
+    uint64_t hash = map->hash(key, key_len);
+    CsConcurrentShard* shard = concurrent_shard_for(map, hash);
+    bool found;
+
+    if (map->lock_free_reads) {
+        CsEpochReader* reader = cs_epoch_enter(map->epoch);
+        if (!reader) return false;
+        found = rcu_find(shard, hash, key, key_len) != NULL;
+        cs_epoch_exit(reader);
+    } else {
+        pthread_rwlock_rdlock(&shard->lock);
+        found = cs_hashmap_find(shard->map, hash, key, key_len) != NULL;
+        pthread_rwlock_unlock(&shard->lock);
+    }
+
+    return found;
+}
+
+CsResult cs_concurrent_hashmap_insert(CsConcurrentHashMap* map, const char* key, const void* value) {
+    if (!map || !key || !value) return CS_NULL_POINTER;
+
+    return cs_concurrent_hashmap_insert_n(map, key, strlen(key), value);
+}
+
+CsResult cs_concurrent_hashmap_insert_n(CsConcurrentHashMap* map, const void* key, size_t key_len,
+                                        const void* value) {
+    if (!map || !key || !value) return CS_NULL_POINTER;
+
+    uint64_t hash = map->hash(key, key_len);
+    CsConcurrentShard* shard = concurrent_shard_for(map, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    CsResult result = CS_CONFLICT;
+    if (map->lock_free_reads) {
+        result = rcu_put(map, shard, hash, key, key_len, value, false);
+    } else if (!cs_hashmap_find(shard->map, hash, key, key_len)) {
+        result = cs_hashmap_insert_hashed(shard->map, hash, key, key_len, value, NULL);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return result;
+}
+
+CsResult cs_concurrent_hashmap_upsert(CsConcurrentHashMap* map, const char* key, const void* value) {
+    if (!map || !key || !value) return CS_NULL_POINTER;
+
+    return cs_concurrent_hashmap_upsert_n(map, key, strlen(key), value);
+}
+
+CsResult cs_concurrent_hashmap_upsert_n(CsConcurrentHashMap* map, const void* key, size_t key_len,
+                                        const void* value) {
+    if (!map || !key || !value) return CS_NULL_POINTER;
+
+    uint64_t hash = map->hash(key, key_len);
+    CsConcurrentShard* shard = concurrent_shard_for(map, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    CsResult result = CS_SUCCESS;
+    if (map->lock_free_reads) {
+        result = rcu_put(map, shard, hash, key, key_len, value, true);
+    } else {
+        CsHashMapEntry* entry = cs_hashmap_find(shard->map, hash, key, key_len);
+        if (entry && value != entry->data) {
+            if (shard->map->destructor) shard->map->destructor(entry->data);
+            memmove(entry->data, value, map->value_size);
+        } else if (!entry) {
+            result = cs_hashmap_insert_hashed(shard->map, hash, key, key_len, value, NULL);
+        }
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return result;
+}
+
+CsResult cs_concurrent_hashmap_remove(CsConcurrentHashMap* map, const char* key) {
+    if (!map || !key) return CS_NULL_POINTER;
+
+    return cs_concurrent_hashmap_remove_n(map, key, strlen(key));
+}
+
+CsResult cs_concurrent_hashmap_remove_n(CsConcurrentHashMap* map, const void* key, size_t key_len) {
+    if (!map || !key) return CS_NULL_POINTER;
+
+    uint64_t hash = map->hash(key, key_len);
+    CsConcurrentShard* shard = concurrent_shard_for(map, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    CsResult result = map->lock_free_reads ? rcu_remove(map, shard, hash, key, key_len)
+                                           : cs_hashmap_remove_hashed(shard->map, hash, key, key_len);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return result;
+}
+
+size_t cs_concurrent_hashmap_size(CsConcurrentHashMap* map) {
+    if (!map) return 0;
+
+    size_t size = 0;
+    for (size_t i = 0; i < map->shard_count; i++) {
+        CsConcurrentShard* shard = &map->shards[i];
+        if (map->lock_free_reads) {
+            size += __atomic_load_n(&shard->size, __ATOMIC_RELAXED);
+            continue;
+        }
+        pthread_rwlock_rdlock(&shard->lock);
+        size += shard->map->size;
+        pthread_rwlock_unlock(&shard->lock);
+    }
+    return size;
+}
+
+void cs_concurrent_hashmap_clear(CsConcurrentHashMap* map) {
+    if (!map) return;
+
+    for (size_t i = 0; i < map->shard_count; i++) {
+        CsConcurrentShard* shard = &map->shards[i];
+        pthread_rwlock_wrlock(&shard->lock);
+        if (!map->lock_free_reads) {
+            cs_hashmap_clear(shard->map);
+        } else if (shard->size > 0) {
+            // readers may be walking the old table, swap in an empty one and retire the old one whole
+            CsRcuTable* empty = rcu_table_create(HASHMAP_DEFAULT_CAPACITY);
+            if (empty) {
+                CsRcuTable* old_table = shard->table;
+                __atomic_store_n(&shard->table, empty, __ATOMIC_RELEASE);
+                cs_epoch_retire(map->epoch, old_table, rcu_table_free);
+            } else {
+                // no memory for a new table: unlink the entries one by one instead
+                CsRcuTable* table = shard->table;
+                for (size_t b = 0; b < table->capacity; b++) {
+                    while (table->buckets[b]) {
+                        CsHashMapEntry* entry = table->buckets[b];
+                        __atomic_store_n(&table->buckets[b], entry->next, __ATOMIC_RELEASE);
+                        cs_epoch_retire(map->epoch, entry, rcu_entry_free);
+                    }
+                }
+            }
+            __atomic_store_n(&shard->size, 0, __ATOMIC_RELAXED);
+        }
+        pthread_rwlock_unlock(&shard->lock);
+    }
+}
@@ -0,0 +1,191 @@
+// pthread_key_t and sched_yield() are hidden in strict C99 without this
+#define _POSIX_C_SOURCE 200112L
+
+#include "epoch_internal.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define EPOCH_CACHE_LINE 64
+
+// One per thread and domain, never freed before the domain: a writer may be scanning it at any time
+struct cs_epoch_reader {
+    uint64_t epoch; // epoch the running read section started in, 0 outside of a read section
+    bool in_use;    // owned by a live thread, released by the pthread key destructor
+    struct cs_epoch_reader* next;
+    char padding[EPOCH_CACHE_LINE - sizeof(uint64_t) - sizeof(bool) - sizeof(void*)];
+};
+
+typedef struct cs_epoch_retired {
+    void* ptr;
+    void (*free_fn)(void*);
+    uint64_t epoch; // global epoch when ptr was retired
+    struct cs_epoch_retired* next;
+} CsEpochRetired;
+
+struct cs_epoch_domain {
+    uint64_t epoch; // starts at 1, 0 marks an idle reader
+    CsEpochReader* readers;
+    pthread_key_t reader_key;
+    pthread_mutex_t retire_lock;
+    CsEpochRetired* retired;
+    size_t retired_count;
+};
+
+static void epoch_release_reader(void* reader) {
+    __atomic_store_n(&((CsEpochReader*)reader)->in_use, false, __ATOMIC_RELEASE);
+}
+
+CsEpochDomain* cs_epoch_create(void) {
+    CsEpochDomain* domain = malloc(sizeof(CsEpochDomain));
+    if (!domain) return NULL;
+
+    if (pthread_key_create(&domain->reader_key, epoch_release_reader) != 0) {
+        free(domain);
+        return NULL;
+    }
+    if (pthread_mutex_init(&domain->retire_lock, NULL) != 0) {
+        pthread_key_delete(domain->reader_key);
+        free(domain);
+        return NULL;
+    }
+
+    domain->epoch = 1;
+    domain->readers = NULL;
+    domain->retired = NULL;
+    domain->retired_count = 0;
+    return domain;
+}
+
+void cs_epoch_destroy(CsEpochDomain* domain) {
+    if (!domain) return;
+
+    // deleting the key first guarantees the destructor never runs on a freed reader
+    pthread_key_delete(domain->reader_key);
+
+    CsEpochRetired* retired = domain->retired;
+    while (retired) {
+        CsEpochRetired* next = retired->next;
+        retired->free_fn(retired->ptr);
+        free(retired);
+        retired = next;
+    }
+
+    CsEpochReader* reader = domain->readers;
+    while (reader) {
+        CsEpochReader* next = reader->next;
+        free(reader);
+        reader = next;
+    }
+
+    pthread_mutex_destroy(&domain->retire_lock);
+    free(domain);
+}
+
+// Slow path, once per thread: adopt a reader released by an exited thread or push a new one
+static CsEpochReader* epoch_register(CsEpochDomain* domain) {
+    CsEpochReader* reader = __atomic_load_n(&domain->readers, __ATOMIC_ACQUIRE);
+    for (; reader; reader = reader->next) {
+        bool expected = false;
+        if (__atomic_compare_exchange_n(&reader->in_use, &expected, true, false, __ATOMIC_ACQUIRE,
+                                        __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    if (!reader) {
+        reader = malloc(sizeof(CsEpochReader));
+        if (!reader) return NULL;
+        reader->epoch = 0;
+        reader->in_use = true;
+        reader->next = __atomic_load_n(&domain->readers, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&domain->readers, &reader->next, reader, true, __ATOMIC_RELEASE,
+                                            __ATOMIC_RELAXED)) {
+        }
+    }
+
+    if (pthread_setspecific(domain->reader_key, reader) != 0) {
+        epoch_release_reader(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+CsEpochReader* cs_epoch_enter(CsEpochDomain* domain) {
+    CsEpochReader* reader = pthread_getspecific(domain->reader_key);
+    if (!reader) {
+        reader = epoch_register(domain);
+        if (!reader) return NULL;
+    }
+
+    __atomic_store_n(&reader->epoch, __atomic_load_n(&domain->epoch, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    // pairs with the fence of cs_epoch_retire(), between the unlink and the read of the retire epoch: either this
+    // reader sees the unlink, or the writer's fence comes after this one and tags the item with an epoch no older
+    // than this reader's, so epoch_min_active() keeps it while this reader is in (the fence there orders the scan
+    // of the readers after the epoch bump the same way)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return reader;
+}
+
+void cs_epoch_exit(CsEpochReader* reader) {
+    __atomic_store_n(&reader->epoch, 0, __ATOMIC_RELEASE);
+}
+
+// Oldest epoch a reader may still be running in, after moving the global epoch forward
+static uint64_t epoch_min_active(CsEpochDomain* domain) {
+    uint64_t min = __atomic_add_fetch(&domain->epoch, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    for (CsEpochReader* reader = __atomic_load_n(&domain->readers, __ATOMIC_ACQUIRE); reader;
+         reader = reader->next) {
+        uint64_t epoch = __atomic_load_n(&reader->epoch, __ATOMIC_ACQUIRE);
+        if (epoch != 0 && epoch < min) min = epoch;
+    }
+    return min;
+}
+
+// Called with retire_lock held
+static void epoch_reclaim(CsEpochDomain* domain) {
+    uint64_t min = epoch_min_active(domain);
+
+    CsEpochRetired** link = &domain->retired;
+    while (*link) {
+        CsEpochRetired* retired = *link;
+        if (retired->epoch < min) {
+            *link = retired->next;
+            retired->free_fn(retired->ptr);
+            free(retired);
+            domain->retired_count--;
+        } else {
+            link = &retired->next;
+        }
+    }
+}
+
+void cs_epoch_retire(CsEpochDomain* domain, void* ptr, void (*free_fn)(void*)) {
+    // the caller's unlink is a release store: without a full fence the load below could be ordered before it
+    // (StoreLoad), tagging the item with an epoch a reader entering later still sees it in
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint64_t epoch = __atomic_load_n(&domain->epoch, __ATOMIC_SEQ_CST);
+    CsEpochRetired* retired = malloc(sizeof(CsEpochRetired));
+
+    if (!retired) {
+        // no memory to defer the free: wait until every reader has moved past the current epoch
+        while (epoch_min_active(domain) <= epoch) sched_yield();
+        free_fn(ptr);
+        return;
+    }
+
+    retired->ptr = ptr;
+    retired->free_fn = free_fn;
+    retired->epoch = epoch;
+
+    pthread_mutex_lock(&domain->retire_lock);
+    retired->next = domain->retired;
+    domain->retired = retired;
+    if (++domain->retired_count % EPOCH_RECLAIM_THRESHOLD == 0) epoch_reclaim(domain);
+    pthread_mutex_unlock(&domain->retire_lock);
+}
@@ -0,0 +1,31 @@
+#ifndef EPOCH_INTERNAL_H
+#define EPOCH_INTERNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Epoch-based reclamation, not part of the public API
+//
+// Readers announce the global epoch they started in and clear it when done, with plain stores only.
+// Writers unlink memory first, then retire it: it is freed once every active reader started in a later
+// epoch, so no reader can still be holding a pointer to it
+
+#define EPOCH_RECLAIM_THRESHOLD 64 // retired pointers accumulated before a writer tries to free them
+
+typedef struct cs_epoch_reader CsEpochReader;
+typedef struct cs_epoch_domain CsEpochDomain;
+
+CsEpochDomain* cs_epoch_create(void);
+
+// No thread may be inside a read section, every pending pointer is freed
+void cs_epoch_destroy(CsEpochDomain* domain);
+
+// Start a read section on the calling thread, NULL if the thread could not be registered
+CsEpochReader* cs_epoch_enter(CsEpochDomain* domain);
+void cs_epoch_exit(CsEpochReader* reader);
+
+// Free ptr with free_fn once no reader can reach it anymore, must be called after ptr was unlinked
+void cs_epoch_retire(CsEpochDomain* domain, void* ptr, void (*free_fn)(void*));
+
+#endif // EPOCH_INTERNAL_H
@@ -0,0 +1,434 @@
+// mmap() and fstat() are hidden in strict C99 without this
+#define _POSIX_C_SOURCE 200112L
+
+#include "cstash/frozen_hashmap.h"
+#include "cstash/hash.h"
+#include "cstash/hashmap.h"
+#include "hashmap_internal.h"
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FROZEN_MAGIC 0x4e455a4f52465343ULL // "CSFROZEN" read as a little-endian uint64_t
+#define FROZEN_VERSION 2 // 2: records and values aligned to 16 bytes
+
+// Hashed at freeze time and again at open time to detect a different hash function
+#define FROZEN_HASH_PROBE "cstash frozen hashmap"
+
+// Slot entries pack the top 16 bits of the hash above a 48-bit record offset, so most misses are
+// rejected without touching the record
+#define FROZEN_OFFSET_BITS 48
+#define FROZEN_OFFSET_MASK ((1ULL << FROZEN_OFFSET_BITS) - 1)
+
+// Start of the blob, every field is a uint64_t so the layout does not depend on the platform
+// The blob is also the file format: a byte-swapped magic rejects files from the other endianness
+typedef struct {
+    uint64_t magic;
+    uint64_t version;
+    uint64_t hash_check; // hash of FROZEN_HASH_PROBE
+    uint64_t size;
+    uint64_t value_size;
+    uint64_t bucket_count;
+    uint64_t seed;
+    uint64_t records_size;
+} FrozenHeader;
+
+// Followed by the value, the key bytes and a NUL byte, padded to 16 bytes
+// Records start on a 16-byte boundary and the record header is 16 bytes, so values are 16-byte aligned like
+// the values of a CsHashMap
+typedef struct {
+    uint64_t hash;
+    uint64_t key_len;
+} FrozenRecord;
+
+static inline size_t frozen_align16(size_t size) {
+    return (size + 15) & ~(size_t)15;
+}
+
+// Map x to [0, n) with a multiply instead of a 64-bit modulo
+static inline size_t frozen_reduce(uint64_t x, size_t n) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+    return (size_t)(((uint128)x * n) >> 64);
+#else
+    return (size_t)(x % n);
+#endif
+}
+
+static inline size_t frozen_bucket(uint64_t hash, uint64_t seed, size_t bucket_count) {
+    return frozen_reduce(cs_hash_u64(hash ^ seed), bucket_count);
+}
+
+static inline size_t frozen_slot(uint64_t hash, uint64_t seed, uint32_t pilot, size_t size) {
+    return frozen_reduce(cs_hash_u64(hash ^ seed ^ (((uint64_t)pilot + 1) * CS_FIBONACCI_MULTIPLIER)), size);
+}
+
+static inline size_t frozen_record_size(size_t value_size, size_t key_len) {
+    return frozen_align16(sizeof(FrozenRecord) + value_size + key_len + 1);
+}
+
+static inline size_t frozen_pilots_size(size_t bucket_count) {
+    return frozen_align16(bucket_count * sizeof(uint32_t));
+}
+
+static inline size_t frozen_offsets_size(size_t size) {
+    return frozen_align16(size * sizeof(uint64_t));
+}
+
+static inline uint64_t frozen_hash_check(CsHashFunction hash) {
+    return hash(FROZEN_HASH_PROBE, sizeof(FROZEN_HASH_PROBE) - 1);
+}
+
+// Point frozen into a blob whose header has been written or validated
+static void frozen_attach(CsFrozenHashMap* frozen, void* blob, size_t blob_size, CsHashFunction hash) {
+    FrozenHeader header;
+    memcpy(&header, blob, sizeof(header));
+
+    frozen->blob = blob;
+    frozen->blob_size = blob_size;
+    frozen->size = (size_t)header.size;
+    frozen->value_size = (size_t)header.value_size;
+    frozen->bucket_count = (size_t)header.bucket_count;
+    frozen->seed = header.seed;
+    frozen->hash = hash;
+    frozen->pilots = (const uint32_t*)((const char*)blob + sizeof(FrozenHeader));
+    frozen->offsets = (const uint64_t*)((const char*)frozen->pilots + frozen_pilots_size(frozen->bucket_count));
+    frozen->records = (const char*)frozen->offsets + frozen_offsets_size(frozen->size);
+    frozen->mapped = false;
+}
+
+// ========================================
+// Construction
+// ========================================
+
+typedef struct {
+    size_t n;
+    size_t bucket_count;
+    const CsHashMapEntry** entries; // entries of the map, grouped by bucket during a pass
+    size_t* bucket_start;           // bucket_count + 1 offsets into entries
+    size_t* bucket_order;           // non-empty buckets sorted by decreasing size
+    size_t used_buckets;            // length of bucket_order
+    uint32_t* pilots;
+    size_t* slot_entry; // entry index of each slot
+    bool* taken;
+    size_t* slots; // scratch, slots of the bucket being placed
+} FrozenBuilder;
+
+static void frozen_builder_free(FrozenBuilder* builder) {
+    free(builder->entries);
+    free(builder->bucket_start);
+    free(builder->bucket_order);
+    free(builder->pilots);
+    free(builder->slot_entry);
+    free(builder->taken);
+    free(builder->slots);
+}
+
+// Group the entries by bucket (counting sort) and order the buckets from largest to smallest,
+// so the hardest buckets are placed while the table is still mostly empty
+static size_t frozen_group(FrozenBuilder* builder, const CsHashMap* hashmap, uint64_t seed) {
+    size_t bucket_count = builder->bucket_count;
+    memset(builder->bucket_start, 0, (bucket_count + 1) * sizeof(size_t));
+
+    for (size_t i = 0; i < hashmap->order_len; i++) {
+        if (hashmap->order[i]) builder->bucket_start[frozen_bucket(hashmap->order[i]->hash, seed, bucket_count) + 1]++;
+    }
+
+    size_t max_size = 0;
+    for (size_t b = 0; b < bucket_count; b++) {
+        if (builder->bucket_start[b + 1] > max_size) max_size = builder->bucket_start[b + 1];
+        builder->bucket_start[b + 1] += builder->bucket_start[b];
+    }
+
+    // bucket_order doubles as the fill cursor of each bucket
+    memcpy(builder->bucket_order, builder->bucket_start, bucket_count * sizeof(size_t));
+    for (size_t i = 0; i < hashmap->order_len; i++) {
+        const CsHashMapEntry* entry = hashmap->order[i];
+        if (entry) builder->entries[builder->bucket_order[frozen_bucket(entry->hash, seed, bucket_count)]++] = entry;
+    }
+
+    builder->used_buckets = 0;
+    for (size_t size = max_size; size > 0; size--) {
+        for (size_t b = 0; b < bucket_count; b++) {
+            if (builder->bucket_start[b + 1] - builder->bucket_start[b] == size) {
+                builder->bucket_order[builder->used_buckets++] = b;
+            }
+        }
+    }
+    return max_size;
+}
+
+// Two keys with the same hash land in the same bucket and slot for every seed and pilot
+static bool frozen_has_duplicate_hash(const FrozenBuilder* builder) {
+    for (size_t b = 0; b < builder->bucket_count; b++) {
+        for (size_t i = builder->bucket_start[b]; i < builder->bucket_start[b + 1]; i++) {
+            for (size_t j = i + 1; j < builder->bucket_start[b + 1]; j++) {
+                if (builder->entries[i]->hash == builder->entries[j]->hash) return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Find a pilot for every bucket, false if some bucket exhausted its pilots with this seed
+static bool frozen_place(FrozenBuilder* builder, uint64_t seed) {
+    size_t n = builder->n;
+    uint64_t max_pilot = (uint64_t)n * 16 > (1u << 16) ? (uint64_t)n * 16 : (1u << 16);
+    if (max_pilot > UINT32_MAX) max_pilot = UINT32_MAX;
+
+    memset(builder->taken, 0, n * sizeof(bool));
+    memset(builder->pilots, 0, builder->bucket_count * sizeof(uint32_t));
+
+    // empty buckets keep pilot 0, no key ever reads it back
+    for (size_t i = 0; i < builder->used_buckets; i++) {
+        size_t b = builder->bucket_order[i];
+        size_t first = builder->bucket_start[b];
+        size_t count = builder->bucket_start[b + 1] - first;
+
+        uint64_t pilot = 0;
+        for (; pilot < max_pilot; pilot++) {
+            size_t k = 0;
+            for (; k < count; k++) {
+                size_t slot = frozen_slot(builder->entries[first + k]->hash, seed, (uint32_t)pilot, n);
+                if (builder->taken[slot]) break;
+
+                size_t previous = 0;
+                while (previous < k && builder->slots[previous] != slot) previous++;
+                if (previous < k) break;
+
+                builder->slots[k] = slot;
+            }
+            if (k == count) break;
+        }
+        if (pilot == max_pilot) return false;
+
+        builder->pilots[b] = (uint32_t)pilot;
+        for (size_t k = 0; k < count; k++) {
+            builder->taken[builder->slots[k]] = true;
+            builder->slot_entry[builder->slots[k]] = first + k;
+        }
+    }
+    return true;
+}
+
+static CsFrozenHashMap* frozen_build_blob(const FrozenBuilder* builder, const CsHashMap* hashmap, uint64_t seed) {
+    size_t n = builder->n;
+    size_t pilots_size = frozen_pilots_size(builder->bucket_count);
+    size_t records_size = 0;
+    for (size_t i = 0; i < n; i++) {
+        records_size += frozen_record_size(hashmap->value_size, builder->entries[i]->key_len);
+    }
+    size_t offsets_size = frozen_offsets_size(n);
+    size_t blob_size = sizeof(FrozenHeader) + pilots_size + offsets_size + records_size;
+    if ((uint64_t)records_size > FROZEN_OFFSET_MASK) return NULL;
+
+    CsFrozenHashMap* frozen = malloc(sizeof(CsFrozenHashMap));
+    char* blob = malloc(blob_size);
+    if (!frozen || !blob) {
+        free(frozen);
+        free(blob);
+        return NULL;
+    }
+
+    FrozenHeader header = {FROZEN_MAGIC, FROZEN_VERSION, frozen_hash_check(hashmap->hash), n,
+                           hashmap->value_size, builder->bucket_count, seed, records_size};
+    memcpy(blob, &header, sizeof(header));
+
+    uint32_t* pilots = (uint32_t*)(blob + sizeof(FrozenHeader));
+    memset(pilots, 0, pilots_size);
+    memcpy(pilots, builder->pilots, builder->bucket_count * sizeof(uint32_t));
+
+    uint64_t* offsets = (uint64_t*)(blob + sizeof(FrozenHeader) + pilots_size);
+    memset(offsets, 0, offsets_size);
+    char* records = (char*)offsets + offsets_size;
+
+    // records in slot order: a scan of the blob visits the slots sequentially
+    size_t offset = 0;
+    for (size_t slot = 0; slot < n; slot++) {
+        const CsHashMapEntry* entry = builder->entries[builder->slot_entry[slot]];
+        size_t record_size = frozen_record_size(hashmap->value_size, entry->key_len);
+        char* record = records + offset;
+
+        FrozenRecord fields = {entry->hash, entry->key_len};
+        memset(record, 0, record_size);
+        memcpy(record, &fields, sizeof(fields));
+        memcpy(record + sizeof(FrozenRecord), entry->data, hashmap->value_size);
+        memcpy(record + sizeof(FrozenRecord) + hashmap->value_size, entry->key, entry->key_len);
+
+        offsets[slot] = (entry->hash & ~FROZEN_OFFSET_MASK) | offset;
+        offset += record_size;
+    }
+
+    frozen_attach(frozen, blob, blob_size, hashmap->hash);
+    return frozen;
+}
+
+CsFrozenHashMap* cs_hashmap_freeze(const CsHashMap* hashmap) {
+    if (!hashmap) return NULL;
+
+    FrozenBuilder builder = {0};
+    builder.n = hashmap->size;
+    builder.bucket_count = hashmap->size / FROZEN_HASHMAP_BUCKET_SIZE + 1;
+
+    builder.entries = malloc((builder.n + 1) * sizeof(CsHashMapEntry*));
+    builder.bucket_start = malloc((builder.bucket_count + 1) * sizeof(size_t));
+    builder.bucket_order = malloc(builder.bucket_count * sizeof(size_t));
+    builder.pilots = malloc(builder.bucket_count * sizeof(uint32_t));
+    builder.slot_entry = malloc((builder.n + 1) * sizeof(size_t));
+    builder.taken = malloc(builder.n + 1);
+    if (!builder.entries || !builder.bucket_start || !builder.bucket_order || !builder.pilots ||
+        !builder.slot_entry || !builder.taken) {
+        frozen_builder_free(&builder);
+        return NULL;
+    }
+
+    CsFrozenHashMap* frozen = NULL;
+    for (uint64_t attempt = 0; attempt < FROZEN_HASHMAP_MAX_SEEDS; attempt++) {
+        uint64_t seed = cs_hash_u64(attempt + 1);
+        size_t max_size = frozen_group(&builder, hashmap, seed);
+
+        if (attempt == 0) {
+            if (frozen_has_duplicate_hash(&builder)) break;
+            builder.slots = malloc((max_size + 1) * sizeof(size_t));
+            if (!builder.slots) break;
+        } else {
+            // a new seed may produce a larger bucket
+            size_t* slots = realloc(builder.slots, (max_size + 1) * sizeof(size_t));
+            if (!slots) break;
+            builder.slots = slots;
+        }
+
+        if (frozen_place(&builder, seed)) {
+            frozen = frozen_build_blob(&builder, hashmap, seed);
+            break;
+        }
+    }
+
+    frozen_builder_free(&builder);
+    return frozen;
+}
+
+void cs_frozen_hashmap_destroy(CsFrozenHashMap* frozen) {
+    if (!frozen) return;
+
+    if (frozen->mapped) {
+        munmap(frozen->blob, frozen->blob_size);
+    } else {
+        free(frozen->blob);
+    }
+    free(frozen);
+}
+
+// ========================================
+// Files
+// ========================================
+
+CsResult cs_frozen_hashmap_save(const CsFrozenHashMap* frozen, const char* path) {
+    if (!frozen || !path) return CS_NULL_POINTER;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return CS_IO_ERROR;
+
+    size_t written = fwrite(frozen->blob, 1, frozen->blob_size, file);
+    if (fclose(file) != 0 || written != frozen->blob_size) return CS_IO_ERROR;
+
+    return CS_SUCCESS;
+}
+
+// Only the header is checked, in O(1): the rest of the file is trusted
+static bool frozen_header_valid(const FrozenHeader* header, size_t file_size, CsHashFunction hash) {
+    if (header->magic != FROZEN_MAGIC || header->version != FROZEN_VERSION) return false;
+    if (header->hash_check != frozen_hash_check(hash)) return false;
+    if (header->bucket_count == 0 || header->bucket_count > SIZE_MAX / sizeof(uint32_t)) return false;
+    if (header->size > SIZE_MAX / sizeof(uint64_t) || header->value_size > SIZE_MAX) return false;
+
+    size_t fixed = sizeof(FrozenHeader) + frozen_pilots_size((size_t)header->bucket_count);
+    if (fixed > file_size || (file_size - fixed) / sizeof(uint64_t) < header->size) return false;
+    size_t offsets_size = frozen_offsets_size((size_t)header->size);
+    if (offsets_size > file_size - fixed) return false;
+    return header->records_size == file_size - fixed - offsets_size;
+}
+
+CsFrozenHashMap* cs_frozen_hashmap_open(const char* path, CsHashFunction hash) {
+    if (!path) return NULL;
+    if (!hash) hash = cs_hash_wy;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (uint64_t)info.st_size < sizeof(FrozenHeader) ||
+        (uint64_t)info.st_size > SIZE_MAX) {
+        close(fd);
+        return NULL;
+    }
+    size_t file_size = (size_t)info.st_size;
+
+    // The mapping outlives the descriptor, pages are faulted in on first access
+    void* blob = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (blob == MAP_FAILED) return NULL;
+
+    FrozenHeader header;
+    memcpy(&header, blob, sizeof(header));
+    CsFrozenHashMap* frozen = frozen_header_valid(&header, file_size, hash) ? malloc(sizeof(CsFrozenHashMap)) : NULL;
+    if (!frozen) {
+        munmap(blob, file_size);
+        return NULL;
+    }
+
+    frozen_attach(frozen, blob, file_size, hash);
+    frozen->mapped = true;
+    return frozen;
+}
+
+// ========================================
+// Lookup
+// ========================================
+
+const void* cs_frozen_hashmap_get(const CsFrozenHashMap* frozen, const char* key) {
+    if (!frozen || !key) return NULL;
+
+    return cs_frozen_hashmap_get_n(frozen, key, strlen(key));
+}
+
+const void* cs_frozen_hashmap_get_n(const CsFrozenHashMap* frozen, const void* key, size_t key_len) {
+    if (!frozen || !key || frozen->size == 0) return NULL;
+
+    uint64_t hash = frozen->hash(key, key_len);
+    uint32_t pilot = frozen->pilots[frozen_bucket(hash, frozen->seed, frozen->bucket_count)];
+    uint64_t slot = frozen->offsets[frozen_slot(hash, frozen->seed, pilot, frozen->size)];
+
+    // the slot always holds some key: absent keys are rejected by the fingerprint then the comparison
+    if ((slot ^ hash) & ~FROZEN_OFFSET_MASK) return NULL;
+
+    // open() only checks the header: a corrupt offset or key length must not send the lookup out of the blob
+    size_t records_size = frozen->blob_size - (size_t)(frozen->records - (const char*)frozen->blob);
+    size_t offset = (size_t)(slot & FROZEN_OFFSET_MASK);
+    if (records_size < sizeof(FrozenRecord) || offset > records_size - sizeof(FrozenRecord)) return NULL;
+    size_t room = records_size - sizeof(FrozenRecord) - offset; // bytes left for the value and the key
+    if (frozen->value_size > room || key_len > room - frozen->value_size) return NULL;
+
+    const char* record = frozen->records + offset;
+    FrozenRecord fields;
+    memcpy(&fields, record, sizeof(fields));
+    if (fields.hash != hash || fields.key_len != key_len) return NULL;
+    if (memcmp(record + sizeof(FrozenRecord) + frozen->value_size, key, key_len) != 0) return NULL;
+
+    return record + sizeof(FrozenRecord);
+}
+
+bool cs_frozen_hashmap_has(const CsFrozenHashMap* frozen, const char* key) {
+    return cs_frozen_hashmap_get(frozen, key) != NULL;
+}
+
+bool cs_frozen_hashmap_has_n(const CsFrozenHashMap* frozen, const void* key, size_t key_len) {
+    return cs_frozen_hashmap_get_n(frozen, key, key_len) != NULL;
+}
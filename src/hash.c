@@ -0,0 +1,165 @@
+#include "cstash/hash.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CS_CRC32C_X86 1
+#include <nmmintrin.h>
+#endif
+
+uint64_t cs_hash_fnv1a(const void* key, size_t key_len) {
+    const uint8_t* bytes = key;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < key_len; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// ========================================
+// wyhash
+// ========================================
+
+static const uint64_t WY_SECRET[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL,
+                                      0x4d5a2da51de1aa47ULL};
+
+// 64x64 -> 128 bit multiply, low half in *a and high half in *b
+static inline void wy_mum(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+    uint128 r = (uint128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b) {
+    wy_mum(&a, &b);
+    return a ^ b;
+}
+
+// Unaligned little-endian style loads, memcpy compiles to a single mov
+static inline uint64_t wy_read8(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t wy_read4(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t wy_read3(const uint8_t* p, size_t k) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+uint64_t cs_hash_wy(const void* key, size_t key_len) {
+    const uint8_t* p = key;
+    uint64_t seed = wy_mix(WY_SECRET[0], WY_SECRET[1]);
+    uint64_t a, b;
+
+    if (key_len <= 16) {
+        if (key_len >= 4) {
+            size_t shift = (key_len >> 3) << 2;
+            a = (wy_read4(p) << 32) | wy_read4(p + shift);
+            b = (wy_read4(p + key_len - 4) << 32) | wy_read4(p + key_len - 4 - shift);
+        } else if (key_len > 0) {
+            a = wy_read3(p, key_len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = key_len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = wy_mix(wy_read8(p) ^ WY_SECRET[1], wy_read8(p + 8) ^ seed);
+                see1 = wy_mix(wy_read8(p + 16) ^ WY_SECRET[2], wy_read8(p + 24) ^ see1);
+                see2 = wy_mix(wy_read8(p + 32) ^ WY_SECRET[3], wy_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = wy_mix(wy_read8(p) ^ WY_SECRET[1], wy_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wy_read8(p + i - 16);
+        b = wy_read8(p + i - 8);
+    }
+
+    a ^= WY_SECRET[1];
+    b ^= seed;
+    wy_mum(&a, &b);
+    return wy_mix(a ^ WY_SECRET[0] ^ key_len, b ^ WY_SECRET[1]);
+}
+
+// ========================================
+// CRC32C
+// ========================================
+
+static uint32_t crc32c_portable(uint32_t crc, const uint8_t* p, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= p[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+        }
+    }
+    return crc;
+}
+
+#ifdef CS_CRC32C_X86
+__attribute__((target("sse4.2"))) static uint32_t crc32c_sse42(uint32_t crc, const uint8_t* p, size_t len) {
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; len >= 8; len -= 8, p += 8) {
+        crc64 = _mm_crc32_u64(crc64, wy_read8(p));
+    }
+    crc = (uint32_t)crc64;
+#endif
+    for (; len >= 4; len -= 4, p += 4) {
+        crc = _mm_crc32_u32(crc, (uint32_t)wy_read4(p));
+    }
+    for (; len > 0; len--, p++) {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+    return crc;
+}
+#endif
+
+bool cs_crc32c_is_hardware(void) {
+#ifdef CS_CRC32C_X86
+    return __builtin_cpu_supports("sse4.2");
+#else
+    return false;
+#endif
+}
+
+uint32_t cs_crc32c(const void* data, size_t len) {
+#ifdef CS_CRC32C_X86
+    if (cs_crc32c_is_hardware()) return ~crc32c_sse42(0xFFFFFFFFu, data, len);
+#endif
+    return ~crc32c_portable(0xFFFFFFFFu, data, len);
+}
+
+uint64_t cs_hash_crc32c(const void* key, size_t key_len) {
+    // the fmix64 finalizer of cs_hash_u64 spreads the 32-bit CRC (and the length) over all 64 bits
+    return cs_hash_u64(cs_crc32c(key, key_len) ^ ((uint64_t)key_len << 32));
+}
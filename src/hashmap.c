@@ -1,202 +1,628 @@
+// pthread_t is hidden in strict C99 without this
+#define _POSIX_C_SOURCE 200112L
+
 #include "cstash/hashmap.h"
 #include "cstash/result.h"
+#include "hashmap_internal.h"
 
+#include <pthread.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Table capacity holding entries under the load factor of the engine, 0 if it cannot be represented
+static size_t cs_hashmap_capacity_for(CsHashMapEngine engine, size_t entries) {
+    double load_factor = HASHMAP_MAX_LOAD_FACTOR;
+    if (engine == CS_HASHMAP_SWISS) load_factor = HASHMAP_SWISS_MAX_LOAD_FACTOR;
+    if (engine == CS_HASHMAP_ROBIN_HOOD) load_factor = HASHMAP_ROBIN_HOOD_MAX_LOAD_FACTOR;
+    if (engine == CS_HASHMAP_CUCKOO) load_factor = HASHMAP_CUCKOO_MAX_LOAD_FACTOR;
+    double capacity = (double)entries / load_factor + 1;
+    if (capacity > (double)(SIZE_MAX / 2)) return 0;
+    return (size_t)capacity < HASHMAP_DEFAULT_CAPACITY ? HASHMAP_DEFAULT_CAPACITY : (size_t)capacity;
+}
+
+static CsResult cs_hashmap_reserve_order(CsHashMap* hashmap, size_t count);
+
 CsHashMap* cs_hashmap_create(size_t value_size) {
     if (value_size == 0) return NULL;
+    return cs_hashmap_create_sized(value_size, NULL, 0);
+}
+
+CsHashMap* cs_hashmap_create_with_options(size_t value_size, const CsHashMapOptions* options) {
+    if (value_size == 0) return NULL;
+    return cs_hashmap_create_sized(value_size, options, 0);
+}
+
+CsHashMap* cs_hashmap_create_with_capacity(size_t value_size, size_t expected_entries) {
+    if (value_size == 0) return NULL;
+    return cs_hashmap_create_sized(value_size, NULL, expected_entries);
+}
+
+CsHashMap* cs_hashmap_create_sized(size_t value_size, const CsHashMapOptions* options, size_t expected) {
+    CsHashMapEngine engine = options ? options->engine : CS_HASHMAP_CHAINED;
+    if (engine < CS_HASHMAP_CHAINED || engine > CS_HASHMAP_CUCKOO) return NULL;
+
+    bool incremental = options && options->incremental;
+    if (incremental && engine != CS_HASHMAP_CHAINED) return NULL;
 
     CsHashMap* hashmap = malloc(sizeof(CsHashMap));
     if (!hashmap) return NULL;
 
     hashmap->value_size = value_size;
-    hashmap->capacity = HASHMAP_DEFAULT_CAPACITY;
     hashmap->size = 0;
-    hashmap->buckets = calloc(hashmap->capacity, sizeof(CsHashMapEntry*));
-    if (!hashmap->buckets) {
+    hashmap->engine = engine;
+    hashmap->buckets = NULL;
+    hashmap->ctrl = NULL;
+    hashmap->tombstones = 0;
+    hashmap->hash = options && options->hash ? options->hash : cs_hash_wy;
+    hashmap->incremental = incremental;
+    hashmap->old_buckets = NULL;
+    hashmap->old_capacity = 0;
+    hashmap->old_shift = 0;
+    hashmap->migrate_index = 0;
+    hashmap->order = NULL;
+    hashmap->order_len = 0;
+    hashmap->order_capacity = 0;
+    hashmap->destructor = options ? options->destructor : NULL;
+
+    size_t capacity = cs_hashmap_capacity_for(engine, expected);
+    if (capacity == 0) {
         free(hashmap);
         return NULL;
     }
 
+    CsResult result;
+    if (engine == CS_HASHMAP_SWISS) {
+        result = cs_swiss_init(hashmap, capacity);
+    } else if (engine == CS_HASHMAP_ROBIN_HOOD) {
+        result = cs_robin_hood_init(hashmap, capacity);
+    } else if (engine == CS_HASHMAP_CUCKOO) {
+        result = cs_cuckoo_init(hashmap, capacity);
+    } else {
+        result = cs_chained_init(hashmap, capacity);
+    }
+    if (result != CS_SUCCESS) {
+        free(hashmap);
+        return NULL;
+    }
+
+    // the insertion-order array must not double either while the expected entries arrive
+    if (expected > 0 && cs_hashmap_reserve_order(hashmap, expected) != CS_SUCCESS) {
+        cs_hashmap_destroy(hashmap);
+        return NULL;
+    }
+
+    return hashmap;
+}
+
+CsHashMap* cs_hashmap_create_from(size_t value_size, const char* const* keys, const void* values, size_t n) {
+    CsHashMap* hashmap = cs_hashmap_create_with_capacity(value_size, n);
+    if (!hashmap) return NULL;
+
+    CsResult result = cs_hashmap_insert_bulk(hashmap, keys, values, n, NULL);
+    if (result != CS_SUCCESS && result != CS_CONFLICT) {
+        cs_hashmap_destroy(hashmap);
+        return NULL;
+    }
     return hashmap;
 }
 
 void cs_hashmap_destroy(CsHashMap* hashmap) {
     if (!hashmap) return;
 
-    for (size_t i = 0; i < hashmap->capacity; i++) {
-        CsHashMapEntry* current = hashmap->buckets[i];
-        while (current) {
-            CsHashMapEntry* next = current->next;
-            free(current->key);
-            free(current);
-            current = next;
-        }
-    }
+    cs_hashmap_clear(hashmap);
     free(hashmap->buckets);
+    free(hashmap->old_buckets);
+    free(hashmap->ctrl);
+    free(hashmap->order);
     free(hashmap);
 }
 
-uint64_t cs_hash_fnv1a(const char* key) {
-    uint64_t hash = 0xcbf29ce484222325ULL;
-    while (*key) {
-        hash ^= (uint8_t)(*key++);
-        hash *= 0x100000001b3ULL;
+CsHashMapEntry* cs_hashmap_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    if (hashmap->engine == CS_HASHMAP_SWISS) return cs_swiss_find(hashmap, hash, key, key_len);
+    if (hashmap->engine == CS_HASHMAP_ROBIN_HOOD) return cs_robin_hood_find(hashmap, hash, key, key_len);
+    if (hashmap->engine == CS_HASHMAP_CUCKOO) return cs_cuckoo_find(hashmap, hash, key, key_len);
+    return cs_chained_find(hashmap, hash, key, key_len);
+}
+
+// Link an entry known to be absent into the engine
+static CsResult cs_hashmap_engine_insert(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry) {
+    if (hashmap->engine == CS_HASHMAP_SWISS) return cs_swiss_insert(hashmap, hash, entry);
+    if (hashmap->engine == CS_HASHMAP_ROBIN_HOOD) return cs_robin_hood_insert(hashmap, hash, entry);
+    if (hashmap->engine == CS_HASHMAP_CUCKOO) return cs_cuckoo_insert(hashmap, hash, entry);
+    return cs_chained_insert(hashmap, hash, entry);
+}
+
+// Start loading the bucket (chained), control group (swiss), home slot (robin hood) or both buckets (cuckoo)
+static void cs_hashmap_prefetch_bucket(const CsHashMap* hashmap, uint64_t hash) {
+    if (hashmap->engine == CS_HASHMAP_SWISS) {
+        cs_swiss_prefetch_group(hashmap, hash);
+    } else if (hashmap->engine == CS_HASHMAP_ROBIN_HOOD) {
+        cs_robin_hood_prefetch_slot(hashmap, hash);
+    } else if (hashmap->engine == CS_HASHMAP_CUCKOO) {
+        cs_cuckoo_prefetch_buckets(hashmap, hash);
+    } else {
+        cs_chained_prefetch_bucket(hashmap, hash);
+    }
+}
+
+// Once the bucket has arrived, start loading the candidate entry
+static void cs_hashmap_prefetch_entry(const CsHashMap* hashmap, uint64_t hash) {
+    if (hashmap->engine == CS_HASHMAP_SWISS) {
+        cs_swiss_prefetch_entry(hashmap, hash);
+    } else if (hashmap->engine == CS_HASHMAP_ROBIN_HOOD) {
+        cs_robin_hood_prefetch_entry(hashmap, hash);
+    } else if (hashmap->engine == CS_HASHMAP_CUCKOO) {
+        cs_cuckoo_prefetch_entry(hashmap, hash);
+    } else {
+        cs_chained_prefetch_entry(hashmap, hash);
     }
-    return hash;
 }
 
 void* cs_hashmap_get(const CsHashMap* hashmap, const char* key) {
     if (!hashmap || !key) return NULL;
 
-    size_t index = cs_hash_fnv1a(key) % hashmap->capacity;
-    CsHashMapEntry* bucket = hashmap->buckets[index];
+    return cs_hashmap_get_n(hashmap, key, strlen(key));
+}
+
+void* cs_hashmap_get_n(const CsHashMap* hashmap, const void* key, size_t key_len) {
+    if (!hashmap || !key) return NULL;
+
+    CsHashMapEntry* entry = cs_hashmap_find(hashmap, hashmap->hash(key, key_len), key, key_len);
+    return entry ? entry->data : NULL;
+}
+
+size_t cs_hashmap_get_batch(const CsHashMap* hashmap, const char* const* keys, size_t n, void** out_values) {
+    if (!hashmap || !keys || !out_values) return 0;
+
+    uint64_t hashes[HASHMAP_BATCH_SIZE];
+    size_t lengths[HASHMAP_BATCH_SIZE];
+    size_t found = 0;
+
+    for (size_t start = 0; start < n; start += HASHMAP_BATCH_SIZE) {
+        size_t count = n - start < HASHMAP_BATCH_SIZE ? n - start : HASHMAP_BATCH_SIZE;
+
+        // 1. hash every key and start loading its bucket
+        for (size_t i = 0; i < count; i++) {
+            const char* key = keys[start + i];
+            if (!key) continue;
+            lengths[i] = strlen(key);
+            hashes[i] = hashmap->hash(key, lengths[i]);
+            cs_hashmap_prefetch_bucket(hashmap, hashes[i]);
+        }
+
+        // 2. buckets have arrived, start loading the candidate entries
+        for (size_t i = 0; i < count; i++) {
+            if (!keys[start + i]) continue;
+            cs_hashmap_prefetch_entry(hashmap, hashes[i]);
+        }
 
-    while (bucket) {
-        if (strcmp(bucket->key, key) == 0) return bucket->data;
-        bucket = bucket->next;
+        // 3. resolve, mostly from cache
+        for (size_t i = 0; i < count; i++) {
+            const char* key = keys[start + i];
+            CsHashMapEntry* entry = key ? cs_hashmap_find(hashmap, hashes[i], key, lengths[i]) : NULL;
+            out_values[start + i] = entry ? entry->data : NULL;
+            if (entry) found++;
+        }
     }
-    return NULL;
+
+    return found;
 }
 
 bool cs_hashmap_has(const CsHashMap* hashmap, const char* key) {
     if (!hashmap || !key) return false;
 
-    size_t index = cs_hash_fnv1a(key) % hashmap->capacity;
-    CsHashMapEntry* bucket = hashmap->buckets[index];
+    return cs_hashmap_has_n(hashmap, key, strlen(key));
+}
 
-    while (bucket) {
-        if (strcmp(bucket->key, key) == 0) return true;
-        bucket = bucket->next;
-    }
-    return false;
+bool cs_hashmap_has_n(const CsHashMap* hashmap, const void* key, size_t key_len) {
+    if (!hashmap || !key) return false;
+
+    return cs_hashmap_find(hashmap, hashmap->hash(key, key_len), key, key_len) != NULL;
 }
 
-CsHashMapEntry* cs_hashmap_new_entry(const char* key, const void* value, size_t value_size) {
-    CsHashMapEntry* entry = malloc(sizeof(CsHashMapEntry) + value_size);
-    if (!entry) return NULL;
+CsHashMapEntry* cs_hashmap_new_entry(const void* key, size_t key_len, uint64_t hash, const void* value,
+                                     size_t value_size) {
+    if (key_len > SIZE_MAX - sizeof(CsHashMapEntry) - value_size - 1) return NULL;
 
-    entry->key = strdup(key);
-    if (!entry->key) {
-        free(entry);
-        return NULL;
-    }
+    CsHashMapEntry* entry = malloc(sizeof(CsHashMapEntry) + value_size + key_len + 1);
+    if (!entry) return NULL;
 
     entry->next = NULL;
-    memcpy(entry->data, value, value_size);
+    entry->key = entry->data + value_size;
+    entry->key_len = key_len;
+    entry->hash = hash;
+    if (value) {
+        memcpy(entry->data, value, value_size);
+    } else {
+        memset(entry->data, 0, value_size);
+    }
+    memcpy(entry->key, key, key_len);
+    entry->key[key_len] = '\0';
     return entry;
 }
 
+void cs_hashmap_free_entry(CsHashMapEntry* entry) {
+    free(entry);
+}
+
+// Make room for count more entries in the insertion-order array
+// Holes are squeezed out only here, so removals never move entries under a running iterator
+static CsResult cs_hashmap_reserve_order(CsHashMap* hashmap, size_t count) {
+    if (count <= hashmap->order_capacity - hashmap->order_len) return CS_SUCCESS;
+
+    if (hashmap->order_len > 0 && hashmap->order_len - hashmap->size >= hashmap->order_len / 2) {
+        size_t len = 0;
+        for (size_t i = 0; i < hashmap->order_len; i++) {
+            CsHashMapEntry* entry = hashmap->order[i];
+            if (!entry) continue;
+            entry->order = len;
+            hashmap->order[len++] = entry;
+        }
+        hashmap->order_len = len;
+        if (count <= hashmap->order_capacity - hashmap->order_len) return CS_SUCCESS;
+    }
+
+    size_t capacity = hashmap->order_capacity ? hashmap->order_capacity * 2 : HASHMAP_DEFAULT_CAPACITY;
+    while (capacity - hashmap->order_len < count) {
+        if (capacity > SIZE_MAX / 2) return CS_ALLOCATION_FAILED;
+        capacity *= 2;
+    }
+    if (capacity > SIZE_MAX / sizeof(CsHashMapEntry*)) return CS_ALLOCATION_FAILED;
+
+    CsHashMapEntry** order = realloc(hashmap->order, capacity * sizeof(CsHashMapEntry*));
+    if (!order) return CS_ALLOCATION_FAILED;
+
+    hashmap->order = order;
+    hashmap->order_capacity = capacity;
+    return CS_SUCCESS;
+}
+
+// Grow the table once so that additional more entries fit under the load factor of the engine
+static CsResult cs_hashmap_reserve(CsHashMap* hashmap, size_t additional) {
+    if (additional > SIZE_MAX - hashmap->size) return CS_ALLOCATION_FAILED;
+
+    size_t capacity = cs_hashmap_capacity_for(hashmap->engine, hashmap->size + additional);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+    if (capacity <= hashmap->capacity) return CS_SUCCESS;
+
+    return cs_hashmap_resize(hashmap, capacity);
+}
+
+// Insert a key known to be absent, reusing the hash computed for the lookup
+CsResult cs_hashmap_insert_hashed(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len,
+                                  const void* value, CsHashMapEntry** out_entry) {
+    CsResult result = cs_hashmap_reserve_order(hashmap, 1);
+    if (result != CS_SUCCESS) return result;
+
+    CsHashMapEntry* entry = cs_hashmap_new_entry(key, key_len, hash, value, hashmap->value_size);
+    if (!entry) return CS_ALLOCATION_FAILED;
+
+    result = cs_hashmap_engine_insert(hashmap, hash, entry);
+    if (result != CS_SUCCESS) {
+        cs_hashmap_free_entry(entry);
+        return result;
+    }
+
+    entry->order = hashmap->order_len;
+    hashmap->order[hashmap->order_len++] = entry;
+
+    if (out_entry) *out_entry = entry;
+    return CS_SUCCESS;
+}
+
 CsResult cs_hashmap_insert(CsHashMap* hashmap, const char* key, const void* value) {
     if (!hashmap || !key || !value) return CS_NULL_POINTER;
 
-    size_t index = cs_hash_fnv1a(key) % hashmap->capacity;
-    CsHashMapEntry* bucket = hashmap->buckets[index];
+    return cs_hashmap_insert_n(hashmap, key, strlen(key), value);
+}
+
+CsResult cs_hashmap_insert_n(CsHashMap* hashmap, const void* key, size_t key_len, const void* value) {
+    if (!hashmap || !key || !value) return CS_NULL_POINTER;
+
+    uint64_t hash = hashmap->hash(key, key_len);
+    if (cs_hashmap_find(hashmap, hash, key, key_len)) return CS_CONFLICT;
 
-    if (!bucket) {
-        hashmap->buckets[index] = cs_hashmap_new_entry(key, value, hashmap->value_size);
-        if (!hashmap->buckets[index]) return CS_ALLOCATION_FAILED;
-        hashmap->size++;
-    } else {
-        while (bucket) {
-            if (strcmp(bucket->key, key) == 0) {
-                return CS_CONFLICT;
-            }
-            if (!bucket->next) break;
-            bucket = bucket->next;
-        }
+    return cs_hashmap_insert_hashed(hashmap, hash, key, key_len, value, NULL);
+}
 
-        bucket->next = cs_hashmap_new_entry(key, value, hashmap->value_size);
-        if (!bucket->next) return CS_ALLOCATION_FAILED;
-        hashmap->size++;
+// Share of a bulk insertion: hash the keys and build their entries, without touching the map itself
+typedef struct {
+    const char* const* keys;
+    const char* values;
+    size_t value_size;
+    CsHashFunction hash;
+    CsHashMapEntry** entries;
+    size_t first;
+    size_t count;
+    bool failed;
+} CsHashMapBulkJob;
+
+static void* cs_hashmap_bulk_prepare(void* arg) {
+    CsHashMapBulkJob* job = arg;
+    for (size_t i = job->first; i < job->first + job->count; i++) {
+        size_t key_len = strlen(job->keys[i]);
+        job->entries[i] = cs_hashmap_new_entry(job->keys[i], key_len, job->hash(job->keys[i], key_len),
+                                               job->values + i * job->value_size, job->value_size);
+        if (!job->entries[i]) job->failed = true;
     }
+    return NULL;
+}
 
-    // Vérifier le load factor après TOUTE insertion
-    float load_factor = (float)hashmap->size / hashmap->capacity;
-    if (load_factor > HASHMAP_MAX_LOAD_FACTOR) {
-        cs_hashmap_resize(hashmap, hashmap->capacity * 2);
+// Build every entry of the batch, on several threads when the batch is large enough
+static CsResult cs_hashmap_bulk_prepare_all(const CsHashMap* hashmap, const char* const* keys, const char* values,
+                                            size_t n, CsHashMapEntry** entries, size_t threads) {
+    size_t max_threads = n / HASHMAP_BULK_MIN_PER_THREAD;
+    if (threads > max_threads) threads = max_threads;
+    if (threads == 0) threads = 1;
+
+    CsHashMapBulkJob* jobs = malloc(threads * sizeof(CsHashMapBulkJob));
+    pthread_t* workers = malloc(threads * sizeof(pthread_t));
+    bool* started = calloc(threads, sizeof(bool));
+    if (!jobs || !workers || !started) {
+        free(jobs);
+        free(workers);
+        free(started);
+        return CS_ALLOCATION_FAILED;
     }
 
+    size_t share = n / threads;
+    for (size_t t = 0; t < threads; t++) {
+        size_t first = t * share;
+        size_t count = t + 1 == threads ? n - first : share;
+        jobs[t] = (CsHashMapBulkJob){keys, values, hashmap->value_size, hashmap->hash, entries, first, count, false};
+        // the calling thread takes the first share, and any share whose thread could not start
+        if (t > 0) started[t] = pthread_create(&workers[t], NULL, cs_hashmap_bulk_prepare, &jobs[t]) == 0;
+    }
+    cs_hashmap_bulk_prepare(&jobs[0]);
+
+    bool failed = jobs[0].failed;
+    for (size_t t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(workers[t], NULL);
+        } else {
+            cs_hashmap_bulk_prepare(&jobs[t]);
+        }
+        failed = failed || jobs[t].failed;
+    }
+
+    free(jobs);
+    free(workers);
+    free(started);
+
+    if (failed) {
+        for (size_t i = 0; i < n; i++) cs_hashmap_free_entry(entries[i]);
+        return CS_ALLOCATION_FAILED;
+    }
     return CS_SUCCESS;
 }
 
+#define HASHMAP_BULK_PREFETCH_DISTANCE 8
+
+CsResult cs_hashmap_insert_bulk(CsHashMap* hashmap, const char* const* keys, const void* values, size_t n,
+                                const CsHashMapBulkOptions* options) {
+    if (!hashmap || ((!keys || !values) && n > 0)) return CS_NULL_POINTER;
+    for (size_t i = 0; i < n; i++) {
+        if (!keys[i]) return CS_NULL_POINTER;
+    }
+    if (n == 0) return CS_SUCCESS;
+
+    bool unique = options && options->unique;
+    size_t threads = options ? options->threads : 1;
+
+    CsHashMapEntry** entries = calloc(n, sizeof(CsHashMapEntry*));
+    if (!entries) return CS_ALLOCATION_FAILED;
+
+    CsResult result = cs_hashmap_reserve(hashmap, n);
+    if (result == CS_SUCCESS) result = cs_hashmap_reserve_order(hashmap, n);
+    if (result == CS_SUCCESS) result = cs_hashmap_bulk_prepare_all(hashmap, keys, values, n, entries, threads);
+    if (result != CS_SUCCESS) {
+        free(entries);
+        return result;
+    }
+
+    // Link on the calling thread, the table no longer grows so only bucket loads are left to hide
+    bool skipped = false;
+    for (size_t i = 0; i < n; i++) {
+        if (i + HASHMAP_BULK_PREFETCH_DISTANCE < n) {
+            cs_hashmap_prefetch_bucket(hashmap, entries[i + HASHMAP_BULK_PREFETCH_DISTANCE]->hash);
+        }
+
+        CsHashMapEntry* entry = entries[i];
+        if (!unique && cs_hashmap_find(hashmap, entry->hash, entry->key, entry->key_len)) {
+            cs_hashmap_free_entry(entry);
+            skipped = true;
+            continue;
+        }
+
+        result = cs_hashmap_engine_insert(hashmap, entry->hash, entry);
+        if (result != CS_SUCCESS) {
+            for (size_t j = i; j < n; j++) cs_hashmap_free_entry(entries[j]);
+            free(entries);
+            return result;
+        }
+        entry->order = hashmap->order_len;
+        hashmap->order[hashmap->order_len++] = entry;
+    }
+
+    free(entries);
+    return skipped ? CS_CONFLICT : CS_SUCCESS;
+}
+
+void* cs_hashmap_get_or_insert(CsHashMap* hashmap, const char* key, const void* default_value, bool* inserted) {
+    if (inserted) *inserted = false;
+    if (!hashmap || !key) return NULL;
+
+    return cs_hashmap_get_or_insert_n(hashmap, key, strlen(key), default_value, inserted);
+}
+
+void* cs_hashmap_get_or_insert_n(CsHashMap* hashmap, const void* key, size_t key_len, const void* default_value,
+                                 bool* inserted) {
+    if (inserted) *inserted = false;
+    if (!hashmap || !key) return NULL;
+
+    uint64_t hash = hashmap->hash(key, key_len);
+    CsHashMapEntry* entry = cs_hashmap_find(hashmap, hash, key, key_len);
+    if (entry) return entry->data;
+
+    if (cs_hashmap_insert_hashed(hashmap, hash, key, key_len, default_value, &entry) != CS_SUCCESS) return NULL;
+    if (inserted) *inserted = true;
+    return entry->data;
+}
+
+void* cs_hashmap_upsert(CsHashMap* hashmap, const char* key, const void* value) {
+    if (!hashmap || !key || !value) return NULL;
+
+    return cs_hashmap_upsert_n(hashmap, key, strlen(key), value);
+}
+
+void* cs_hashmap_upsert_n(CsHashMap* hashmap, const void* key, size_t key_len, const void* value) {
+    if (!hashmap || !key || !value) return NULL;
+
+    uint64_t hash = hashmap->hash(key, key_len);
+    CsHashMapEntry* entry = cs_hashmap_find(hashmap, hash, key, key_len);
+    if (entry) {
+        // value may be the stored value itself (upsert of a get result), or point into another entry
+        if (value != entry->data) {
+            if (hashmap->destructor) hashmap->destructor(entry->data);
+            memmove(entry->data, value, hashmap->value_size);
+        }
+        return entry->data;
+    }
+
+    if (cs_hashmap_insert_hashed(hashmap, hash, key, key_len, value, &entry) != CS_SUCCESS) return NULL;
+    return entry->data;
+}
+
 CsResult cs_hashmap_remove(CsHashMap* hashmap, const char* key) {
     if (!hashmap || !key) return CS_NULL_POINTER;
 
-    size_t index = cs_hash_fnv1a(key) % hashmap->capacity;
-    CsHashMapEntry* current = hashmap->buckets[index];
-    CsHashMapEntry* prev = NULL;
-
-    while (current) {
-        if (strcmp(current->key, key) == 0) {
-            // we found the key, we can remove the entry
-            if (!prev) {
-                // current is the first entry of the bucket
-                hashmap->buckets[index] = current->next;
-            } else {
-                prev->next = current->next;
-            }
-            free(current->key);
-            free(current);
-            hashmap->size--;
-            return CS_SUCCESS;
-        }
-        prev = current;
-        current = current->next;
+    return cs_hashmap_remove_n(hashmap, key, strlen(key));
+}
+
+CsResult cs_hashmap_remove_n(CsHashMap* hashmap, const void* key, size_t key_len) {
+    if (!hashmap || !key) return CS_NULL_POINTER;
+
+    return cs_hashmap_remove_hashed(hashmap, hashmap->hash(key, key_len), key, key_len);
+}
+
+// Unlink an entry from its engine and from the insertion order, the caller frees it
+static CsHashMapEntry* cs_hashmap_detach(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    CsHashMapEntry* entry;
+    if (hashmap->engine == CS_HASHMAP_SWISS) {
+        entry = cs_swiss_remove(hashmap, hash, key, key_len);
+    } else if (hashmap->engine == CS_HASHMAP_ROBIN_HOOD) {
+        entry = cs_robin_hood_remove(hashmap, hash, key, key_len);
+    } else if (hashmap->engine == CS_HASHMAP_CUCKOO) {
+        entry = cs_cuckoo_remove(hashmap, hash, key, key_len);
+    } else {
+        entry = cs_chained_remove(hashmap, hash, key, key_len);
     }
-    return CS_NOT_FOUND;
+    if (entry) hashmap->order[entry->order] = NULL;
+    return entry;
+}
+
+CsResult cs_hashmap_remove_hashed(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    CsHashMapEntry* entry = cs_hashmap_detach(hashmap, hash, key, key_len);
+    if (!entry) return CS_NOT_FOUND;
+
+    if (hashmap->destructor) hashmap->destructor(entry->data);
+    cs_hashmap_free_entry(entry);
+    return CS_SUCCESS;
+}
+
+CsResult cs_hashmap_take(CsHashMap* hashmap, const char* key, void* out_value) {
+    if (!hashmap || !key || !out_value) return CS_NULL_POINTER;
+
+    return cs_hashmap_take_n(hashmap, key, strlen(key), out_value);
+}
+
+CsResult cs_hashmap_take_n(CsHashMap* hashmap, const void* key, size_t key_len, void* out_value) {
+    if (!hashmap || !key || !out_value) return CS_NULL_POINTER;
+
+    CsHashMapEntry* entry = cs_hashmap_detach(hashmap, hashmap->hash(key, key_len), key, key_len);
+    if (!entry) return CS_NOT_FOUND;
+
+    memcpy(out_value, entry->data, hashmap->value_size);
+    cs_hashmap_free_entry(entry);
+    return CS_SUCCESS;
 }
 
 void cs_hashmap_clear(CsHashMap* hashmap) {
-    if (!hashmap || hashmap->size == 0) return;
-
-    for (size_t i = 0; i < hashmap->capacity; i++) {
-        CsHashMapEntry* bucket = hashmap->buckets[i];
-        while (bucket) {
-            CsHashMapEntry* next = bucket->next;
-            free(bucket->key);
-            free(bucket);
-            bucket = next;
+    // no shortcut on size == 0: removals leave holes in order and may leave an incremental resize pending
+    if (!hashmap) return;
+
+    if (hashmap->destructor) {
+        for (size_t i = 0; i < hashmap->order_len; i++) {
+            if (hashmap->order[i]) hashmap->destructor(hashmap->order[i]->data);
         }
-        hashmap->buckets[i] = NULL;
+    }
+
+    if (hashmap->engine == CS_HASHMAP_SWISS) {
+        cs_swiss_clear(hashmap);
+    } else if (hashmap->engine == CS_HASHMAP_ROBIN_HOOD) {
+        cs_robin_hood_clear(hashmap);
+    } else if (hashmap->engine == CS_HASHMAP_CUCKOO) {
+        cs_cuckoo_clear(hashmap);
+    } else {
+        cs_chained_clear(hashmap);
     }
     hashmap->size = 0;
+    hashmap->order_len = 0;
 }
 
 CsResult cs_hashmap_resize(CsHashMap* hashmap, size_t new_capacity) {
     if (!hashmap) return CS_NULL_POINTER;
 
-    if (new_capacity < 0) new_capacity = HASHMAP_DEFAULT_CAPACITY;
-    if (new_capacity == hashmap->capacity) return CS_SUCCESS;
-
-    CsHashMapEntry** old_buckets = hashmap->buckets;
-    size_t old_capacity = hashmap->capacity;
+    if (new_capacity == 0) new_capacity = HASHMAP_DEFAULT_CAPACITY;
 
-    hashmap->buckets = calloc(new_capacity, sizeof(CsHashMapEntry*));
-    if (!hashmap->buckets) {
-        hashmap->buckets = old_buckets;
-        return CS_ALLOCATION_FAILED;
+    if (hashmap->engine == CS_HASHMAP_SWISS) {
+        if (new_capacity == hashmap->capacity) return CS_SUCCESS;
+        return cs_swiss_resize(hashmap, new_capacity);
+    }
+    if (hashmap->engine == CS_HASHMAP_ROBIN_HOOD) {
+        if (new_capacity == hashmap->capacity) return CS_SUCCESS;
+        return cs_robin_hood_resize(hashmap, new_capacity);
     }
+    if (hashmap->engine == CS_HASHMAP_CUCKOO) {
+        if (new_capacity == hashmap->capacity) return CS_SUCCESS;
+        return cs_cuckoo_resize(hashmap, new_capacity);
+    }
+    return cs_chained_resize(hashmap, new_capacity);
+}
 
-    hashmap->capacity = new_capacity;
-    hashmap->size = 0;
+CsHashMapIter cs_hashmap_iter_begin(const CsHashMap* hashmap) {
+    CsHashMapIter iter = {hashmap, 0};
+    return iter;
+}
 
-    for (size_t i = 0; i < old_capacity; i++) {
-        CsHashMapEntry* current = old_buckets[i];
-        while (current) {
-            CsHashMapEntry* next = current->next;
+bool cs_hashmap_iter_next(CsHashMapIter* iter, const char** key, size_t* key_len, void** value) {
+    if (!iter || !iter->hashmap) return false;
 
-            size_t new_index = cs_hash_fnv1a(current->key) % new_capacity;
-            current->next = hashmap->buckets[new_index];
-            hashmap->buckets[new_index] = current;
-            hashmap->size++;
+    const CsHashMap* hashmap = iter->hashmap;
+    while (iter->index < hashmap->order_len) {
+        CsHashMapEntry* entry = hashmap->order[iter->index++];
+        if (!entry) continue;
 
-            current = next;
-        }
+        if (key) *key = entry->key;
+        if (key_len) *key_len = entry->key_len;
+        if (value) *value = entry->data;
+        return true;
     }
+    return false;
+}
 
-    free(old_buckets);
-    return CS_SUCCESS;
+size_t cs_hashmap_for_each(const CsHashMap* hashmap, CsHashMapVisitor visitor, void* user_data) {
+    if (!hashmap || !visitor) return 0;
+
+    size_t visited = 0;
+    for (size_t i = 0; i < hashmap->order_len; i++) {
+        CsHashMapEntry* entry = hashmap->order[i];
+        if (!entry) continue;
+
+        visited++;
+        if (!visitor(entry->key, entry->key_len, entry->data, user_data)) break;
+    }
+    return visited;
 }
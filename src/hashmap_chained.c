@@ -0,0 +1,243 @@
+#include "cstash/hashmap.h"
+#include "cstash/result.h"
+#include "hashmap_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Power of two >= capacity, at least 2 so that the index shift stays below 64, 0 if it cannot be represented
+static size_t chained_round_capacity(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        if (rounded > SIZE_MAX / 2 / sizeof(CsHashMapEntry*)) return 0;
+        rounded *= 2;
+    }
+    return rounded;
+}
+
+static unsigned int chained_shift_for(size_t capacity) {
+    unsigned int shift = 64;
+    while (capacity > 1) {
+        capacity >>= 1;
+        shift--;
+    }
+    return shift;
+}
+
+static inline size_t chained_old_index(const CsHashMap* hashmap, uint64_t hash) {
+    return (size_t)((hash * CS_FIBONACCI_MULTIPLIER) >> hashmap->old_shift);
+}
+
+static CsHashMapEntry* chained_find_in(CsHashMapEntry* bucket, uint64_t hash, const void* key, size_t key_len) {
+    while (bucket) {
+        if (cs_hashmap_entry_matches(bucket, hash, key, key_len)) return bucket;
+        bucket = bucket->next;
+    }
+    return NULL;
+}
+
+// Unlink the matching entry from the chain starting at *head
+static CsHashMapEntry* chained_unlink(CsHashMapEntry** head, uint64_t hash, const void* key, size_t key_len) {
+    CsHashMapEntry* current = *head;
+    CsHashMapEntry* prev = NULL;
+
+    while (current) {
+        if (cs_hashmap_entry_matches(current, hash, key, key_len)) {
+            if (!prev) {
+                // current is the first entry of the bucket
+                *head = current->next;
+            } else {
+                prev->next = current->next;
+            }
+            current->next = NULL;
+            return current;
+        }
+        prev = current;
+        current = current->next;
+    }
+    return NULL;
+}
+
+// Move every entry of a chain to the current bucket array, reusing the cached hashes
+static void chained_relink(CsHashMap* hashmap, CsHashMapEntry* current) {
+    while (current) {
+        CsHashMapEntry* next = current->next;
+
+        size_t new_index = cs_hashmap_bucket_index(hashmap, current->hash);
+        current->next = hashmap->buckets[new_index];
+        hashmap->buckets[new_index] = current;
+
+        current = next;
+    }
+}
+
+// Migrate up to count buckets of the old array, freeing it once empty
+static void chained_migrate(CsHashMap* hashmap, size_t count) {
+    if (!hashmap->old_buckets) return;
+
+    size_t remaining = hashmap->old_capacity - hashmap->migrate_index;
+    size_t end = count < remaining ? hashmap->migrate_index + count : hashmap->old_capacity;
+
+    for (; hashmap->migrate_index < end; hashmap->migrate_index++) {
+        chained_relink(hashmap, hashmap->old_buckets[hashmap->migrate_index]);
+        hashmap->old_buckets[hashmap->migrate_index] = NULL;
+    }
+
+    if (hashmap->migrate_index == hashmap->old_capacity) {
+        free(hashmap->old_buckets);
+        hashmap->old_buckets = NULL;
+        hashmap->old_capacity = 0;
+        hashmap->migrate_index = 0;
+    }
+}
+
+// Swap in a bucket array twice as large, entries move over during the next operations
+static CsResult chained_start_migration(CsHashMap* hashmap) {
+    // the previous migration always ends before the map doubles again, this is only a safety net
+    chained_migrate(hashmap, SIZE_MAX);
+
+    size_t new_capacity = hashmap->capacity * 2;
+    CsHashMapEntry** buckets = calloc(new_capacity, sizeof(CsHashMapEntry*));
+    if (!buckets) return CS_ALLOCATION_FAILED;
+
+    hashmap->old_buckets = hashmap->buckets;
+    hashmap->old_capacity = hashmap->capacity;
+    hashmap->old_shift = hashmap->shift;
+    hashmap->migrate_index = 0;
+
+    hashmap->buckets = buckets;
+    hashmap->capacity = new_capacity;
+    hashmap->shift = chained_shift_for(new_capacity);
+    return CS_SUCCESS;
+}
+
+CsResult cs_chained_init(CsHashMap* hashmap, size_t capacity) {
+    capacity = chained_round_capacity(capacity);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+
+    hashmap->buckets = calloc(capacity, sizeof(CsHashMapEntry*));
+    if (!hashmap->buckets) return CS_ALLOCATION_FAILED;
+
+    hashmap->capacity = capacity;
+    hashmap->shift = chained_shift_for(capacity);
+    return CS_SUCCESS;
+}
+
+CsHashMapEntry* cs_chained_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    if (hashmap->old_buckets) {
+        size_t old_index = chained_old_index(hashmap, hash);
+        if (old_index >= hashmap->migrate_index) {
+            CsHashMapEntry* entry = chained_find_in(hashmap->old_buckets[old_index], hash, key, key_len);
+            if (entry) return entry;
+        }
+    }
+    return chained_find_in(hashmap->buckets[cs_hashmap_bucket_index(hashmap, hash)], hash, key, key_len);
+}
+
+CsResult cs_chained_insert(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry) {
+    if (hashmap->incremental) chained_migrate(hashmap, HASHMAP_INCREMENTAL_STEP);
+
+    size_t index = cs_hashmap_bucket_index(hashmap, hash);
+    entry->next = hashmap->buckets[index];
+    hashmap->buckets[index] = entry;
+    hashmap->size++;
+
+    // Vérifier le load factor après TOUTE insertion
+    float load_factor = (float)hashmap->size / hashmap->capacity;
+    if (load_factor > HASHMAP_MAX_LOAD_FACTOR) {
+        if (hashmap->incremental) {
+            chained_start_migration(hashmap);
+        } else {
+            cs_chained_resize(hashmap, hashmap->capacity * 2);
+        }
+    }
+
+    return CS_SUCCESS;
+}
+
+CsHashMapEntry* cs_chained_remove(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    if (hashmap->incremental) chained_migrate(hashmap, HASHMAP_INCREMENTAL_STEP);
+
+    CsHashMapEntry* entry = NULL;
+    if (hashmap->old_buckets) {
+        size_t old_index = chained_old_index(hashmap, hash);
+        if (old_index >= hashmap->migrate_index) {
+            entry = chained_unlink(&hashmap->old_buckets[old_index], hash, key, key_len);
+        }
+    }
+    if (!entry) {
+        entry = chained_unlink(&hashmap->buckets[cs_hashmap_bucket_index(hashmap, hash)], hash, key, key_len);
+    }
+
+    if (entry) hashmap->size--;
+    return entry;
+}
+
+CsResult cs_chained_resize(CsHashMap* hashmap, size_t new_capacity) {
+    new_capacity = chained_round_capacity(new_capacity);
+    if (new_capacity == 0) return CS_ALLOCATION_FAILED;
+    if (new_capacity == hashmap->capacity && !hashmap->old_buckets) return CS_SUCCESS;
+
+    CsHashMapEntry** buckets = calloc(new_capacity, sizeof(CsHashMapEntry*));
+    if (!buckets) return CS_ALLOCATION_FAILED;
+
+    CsHashMapEntry** old_buckets = hashmap->buckets;
+    size_t old_capacity = hashmap->capacity;
+
+    hashmap->buckets = buckets;
+    hashmap->capacity = new_capacity;
+    hashmap->shift = chained_shift_for(new_capacity);
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        chained_relink(hashmap, old_buckets[i]);
+    }
+    free(old_buckets);
+
+    // an explicit resize also completes a pending incremental migration
+    if (hashmap->old_buckets) {
+        for (size_t i = hashmap->migrate_index; i < hashmap->old_capacity; i++) {
+            chained_relink(hashmap, hashmap->old_buckets[i]);
+        }
+        free(hashmap->old_buckets);
+        hashmap->old_buckets = NULL;
+        hashmap->old_capacity = 0;
+        hashmap->migrate_index = 0;
+    }
+
+    return CS_SUCCESS;
+}
+
+static void chained_free_chains(CsHashMapEntry** buckets, size_t from, size_t to) {
+    for (size_t i = from; i < to; i++) {
+        CsHashMapEntry* bucket = buckets[i];
+        while (bucket) {
+            CsHashMapEntry* next = bucket->next;
+            cs_hashmap_free_entry(bucket);
+            bucket = next;
+        }
+        buckets[i] = NULL;
+    }
+}
+
+void cs_chained_clear(CsHashMap* hashmap) {
+    chained_free_chains(hashmap->buckets, 0, hashmap->capacity);
+
+    if (hashmap->old_buckets) {
+        chained_free_chains(hashmap->old_buckets, hashmap->migrate_index, hashmap->old_capacity);
+        free(hashmap->old_buckets);
+        hashmap->old_buckets = NULL;
+        hashmap->old_capacity = 0;
+        hashmap->migrate_index = 0;
+    }
+}
+
+void cs_chained_prefetch_bucket(const CsHashMap* hashmap, uint64_t hash) {
+    CS_PREFETCH(&hashmap->buckets[cs_hashmap_bucket_index(hashmap, hash)]);
+}
+
+// Called once the bucket is expected in cache: prefetch the head entry of its chain
+void cs_chained_prefetch_entry(const CsHashMap* hashmap, uint64_t hash) {
+    CsHashMapEntry* head = hashmap->buckets[cs_hashmap_bucket_index(hashmap, hash)];
+    if (head) CS_PREFETCH(head);
+}
@@ -0,0 +1,277 @@
+#include "cstash/hashmap.h"
+#include "cstash/result.h"
+#include "hashmap_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Slots are grouped in buckets of BUCKET_SIZE, an entry lives in one of the two buckets given by its hash
+// ctrl holds one byte per slot: 0 = empty, otherwise a non-zero fingerprint of the hash
+#define BUCKET_SIZE HASHMAP_CUCKOO_BUCKET_SIZE
+#define CUCKOO_EMPTY ((uint8_t)0)
+
+// Second multiplier for the alternate bucket, odd and unrelated to the Fibonacci one
+#define CUCKOO_ALT_MULTIPLIER 0xC2B2AE3D27D4EB4FULL
+
+// Breadth-first search for a free slot: nodes are bucket slots whose entry could move to its other bucket
+#define CUCKOO_SEARCH_NODES 256
+
+typedef struct {
+    size_t bucket;
+    size_t parent; // index of the node whose entry would move here, SIZE_MAX for the two starting buckets
+    size_t slot;   // slot of the parent bucket holding that entry
+} CuckooNode;
+
+static inline uint8_t cuckoo_fingerprint(uint64_t hash) {
+    uint8_t fingerprint = (uint8_t)hash;
+    return fingerprint ? fingerprint : 1;
+}
+
+// Both buckets come from the one 64-bit hash: the high bits of two different multiplications
+static inline size_t cuckoo_primary(const CsHashMap* hashmap, uint64_t hash) {
+    return cs_hashmap_bucket_index(hashmap, hash);
+}
+
+static inline size_t cuckoo_secondary(const CsHashMap* hashmap, uint64_t hash) {
+    size_t primary = cuckoo_primary(hashmap, hash);
+    size_t secondary = (size_t)((((hash >> 32) | (hash << 32)) * CUCKOO_ALT_MULTIPLIER) >> hashmap->shift);
+    return secondary != primary ? secondary : primary ^ 1;
+}
+
+// The other bucket of the entry stored in bucket
+static inline size_t cuckoo_alternate(const CsHashMap* hashmap, const CsHashMapEntry* entry, size_t bucket) {
+    size_t primary = cuckoo_primary(hashmap, entry->hash);
+    return bucket == primary ? cuckoo_secondary(hashmap, entry->hash) : primary;
+}
+
+static inline size_t cuckoo_max_load(size_t capacity) {
+    return (size_t)(capacity * HASHMAP_CUCKOO_MAX_LOAD_FACTOR);
+}
+
+// Smallest power of two >= requested (and >= two buckets) able to hold size entries, 0 if too large
+static size_t cuckoo_capacity_for(size_t requested, size_t size) {
+    size_t capacity = 2 * BUCKET_SIZE;
+    while (capacity < requested || cuckoo_max_load(capacity) < size) {
+        if (capacity > SIZE_MAX / 2 / sizeof(CsHashMapEntry*)) return 0;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static unsigned int cuckoo_shift_for(size_t buckets) {
+    unsigned int shift = 64;
+    while (buckets > 1) {
+        buckets >>= 1;
+        shift--;
+    }
+    return shift;
+}
+
+static bool cuckoo_find_in(const CsHashMap* hashmap, size_t bucket, uint64_t hash, uint8_t fingerprint,
+                           const void* key, size_t key_len, size_t* slot) {
+    size_t first = bucket * BUCKET_SIZE;
+    for (size_t i = first; i < first + BUCKET_SIZE; i++) {
+        if (hashmap->ctrl[i] == fingerprint && cs_hashmap_entry_matches(hashmap->buckets[i], hash, key, key_len)) {
+            *slot = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Two buckets at most, whatever the load: the worst case is 2 * BUCKET_SIZE fingerprints and key comparisons
+static bool cuckoo_find_slot(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len,
+                             size_t* slot) {
+    uint8_t fingerprint = cuckoo_fingerprint(hash);
+    size_t secondary = cuckoo_secondary(hashmap, hash);
+    // both locations are known up front: load the second one while the first is scanned
+    CS_PREFETCH(hashmap->ctrl + secondary * BUCKET_SIZE);
+    CS_PREFETCH(hashmap->buckets + secondary * BUCKET_SIZE);
+    return cuckoo_find_in(hashmap, cuckoo_primary(hashmap, hash), hash, fingerprint, key, key_len, slot) ||
+           cuckoo_find_in(hashmap, secondary, hash, fingerprint, key, key_len, slot);
+}
+
+// A bucket is searched once: every slot on a chain then belongs to a different bucket, so no entry moves twice
+static bool cuckoo_queued(const CuckooNode* nodes, size_t count, size_t bucket) {
+    for (size_t i = 0; i < count; i++) {
+        if (nodes[i].bucket == bucket) return true;
+    }
+    return false;
+}
+
+static bool cuckoo_free_slot(const CsHashMap* hashmap, size_t bucket, size_t* slot) {
+    size_t first = bucket * BUCKET_SIZE;
+    for (size_t i = first; i < first + BUCKET_SIZE; i++) {
+        if (hashmap->ctrl[i] == CUCKOO_EMPTY) {
+            *slot = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Store an entry known to be absent. When both buckets are full, search breadth-first for the shortest chain
+// of entries that can each move to their other bucket and end on a free slot, then shift along it
+// Returns false without touching the table if no such chain is found within CUCKOO_SEARCH_NODES
+static bool cuckoo_place(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry) {
+    CuckooNode nodes[CUCKOO_SEARCH_NODES];
+    size_t count = 0;
+    size_t head = 0;
+    size_t free_slot = 0;
+    size_t found = SIZE_MAX;
+
+    nodes[count++] = (CuckooNode){cuckoo_primary(hashmap, hash), SIZE_MAX, 0};
+    nodes[count++] = (CuckooNode){cuckoo_secondary(hashmap, hash), SIZE_MAX, 0};
+
+    while (head < count && found == SIZE_MAX) {
+        if (cuckoo_free_slot(hashmap, nodes[head].bucket, &free_slot)) {
+            found = head;
+            break;
+        }
+        size_t first = nodes[head].bucket * BUCKET_SIZE;
+        for (size_t i = 0; i < BUCKET_SIZE && count < CUCKOO_SEARCH_NODES; i++) {
+            size_t alternate = cuckoo_alternate(hashmap, hashmap->buckets[first + i], nodes[head].bucket);
+            if (!cuckoo_queued(nodes, count, alternate)) nodes[count++] = (CuckooNode){alternate, head, first + i};
+        }
+        head++;
+    }
+    if (found == SIZE_MAX) return false;
+
+    // Walk back to a starting bucket, each entry on the chain moving into the slot freed after it
+    for (size_t node = found; nodes[node].parent != SIZE_MAX; node = nodes[node].parent) {
+        size_t from = nodes[node].slot;
+        hashmap->ctrl[free_slot] = hashmap->ctrl[from];
+        hashmap->buckets[free_slot] = hashmap->buckets[from];
+        free_slot = from;
+    }
+    hashmap->ctrl[free_slot] = cuckoo_fingerprint(hash);
+    hashmap->buckets[free_slot] = entry;
+    return true;
+}
+
+static CsResult cuckoo_alloc(CsHashMap* hashmap, size_t capacity) {
+    uint8_t* ctrl = calloc(capacity, 1);
+    CsHashMapEntry** slots = calloc(capacity, sizeof(CsHashMapEntry*));
+    if (!ctrl || !slots) {
+        free(ctrl);
+        free(slots);
+        return CS_ALLOCATION_FAILED;
+    }
+
+    hashmap->ctrl = ctrl;
+    hashmap->buckets = slots;
+    hashmap->capacity = capacity;
+    hashmap->shift = cuckoo_shift_for(capacity / BUCKET_SIZE);
+    return CS_SUCCESS;
+}
+
+CsResult cs_cuckoo_init(CsHashMap* hashmap, size_t capacity) {
+    capacity = cuckoo_capacity_for(capacity, 0);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+
+    CsResult result = cuckoo_alloc(hashmap, capacity);
+    if (result != CS_SUCCESS) return result;
+    hashmap->tombstones = 0;
+    return CS_SUCCESS;
+}
+
+CsHashMapEntry* cs_cuckoo_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    size_t slot;
+    if (!cuckoo_find_slot(hashmap, hash, key, key_len, &slot)) return NULL;
+    return hashmap->buckets[slot];
+}
+
+CsResult cs_cuckoo_insert(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry) {
+    if (hashmap->size + 1 > cuckoo_max_load(hashmap->capacity)) {
+        CsResult result = cs_cuckoo_resize(hashmap, hashmap->capacity * 2);
+        if (result != CS_SUCCESS) return result;
+    }
+
+    while (!cuckoo_place(hashmap, hash, entry)) {
+        // No free slot reachable: grow, unless the table is already sparse, in which case the key shares its
+        // pair of buckets with too many others (same hash) for any capacity to separate them
+        if (hashmap->size < hashmap->capacity / 8) return CS_OUT_OF_BOUNDS;
+
+        CsResult result = cs_cuckoo_resize(hashmap, hashmap->capacity * 2);
+        if (result != CS_SUCCESS) return result;
+    }
+    hashmap->size++;
+    return CS_SUCCESS;
+}
+
+CsHashMapEntry* cs_cuckoo_remove(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    size_t slot;
+    if (!cuckoo_find_slot(hashmap, hash, key, key_len, &slot)) return NULL;
+
+    CsHashMapEntry* entry = hashmap->buckets[slot];
+    hashmap->ctrl[slot] = CUCKOO_EMPTY;
+    hashmap->buckets[slot] = NULL;
+    hashmap->size--;
+    return entry;
+}
+
+CsResult cs_cuckoo_resize(CsHashMap* hashmap, size_t new_capacity) {
+    size_t capacity = cuckoo_capacity_for(new_capacity, hashmap->size);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+
+    CsHashMap old = *hashmap;
+    for (;;) {
+        CsResult result = cuckoo_alloc(hashmap, capacity);
+        if (result != CS_SUCCESS) {
+            *hashmap = old;
+            return result;
+        }
+
+        bool placed = true;
+        for (size_t i = 0; i < old.capacity && placed; i++) {
+            if (old.ctrl[i] != CUCKOO_EMPTY) placed = cuckoo_place(hashmap, old.buckets[i]->hash, old.buckets[i]);
+        }
+        if (placed) break;
+
+        // the entries do not fit at the requested size, retry with twice the slots
+        free(hashmap->ctrl);
+        free(hashmap->buckets);
+        capacity = cuckoo_capacity_for(capacity * 2, 0);
+        if (capacity == 0) {
+            *hashmap = old;
+            return CS_ALLOCATION_FAILED;
+        }
+    }
+
+    free(old.ctrl);
+    free(old.buckets);
+    return CS_SUCCESS;
+}
+
+void cs_cuckoo_clear(CsHashMap* hashmap) {
+    for (size_t i = 0; i < hashmap->capacity; i++) {
+        if (hashmap->ctrl[i] != CUCKOO_EMPTY) cs_hashmap_free_entry(hashmap->buckets[i]);
+    }
+    memset(hashmap->ctrl, CUCKOO_EMPTY, hashmap->capacity);
+    memset(hashmap->buckets, 0, hashmap->capacity * sizeof(CsHashMapEntry*));
+}
+
+void cs_cuckoo_prefetch_buckets(const CsHashMap* hashmap, uint64_t hash) {
+    size_t primary = cuckoo_primary(hashmap, hash) * BUCKET_SIZE;
+    size_t secondary = cuckoo_secondary(hashmap, hash) * BUCKET_SIZE;
+    CS_PREFETCH(hashmap->ctrl + primary);
+    CS_PREFETCH(hashmap->buckets + primary);
+    CS_PREFETCH(hashmap->ctrl + secondary);
+    CS_PREFETCH(hashmap->buckets + secondary);
+}
+
+// Called once both buckets are expected in cache: prefetch the first entry with a matching fingerprint
+void cs_cuckoo_prefetch_entry(const CsHashMap* hashmap, uint64_t hash) {
+    uint8_t fingerprint = cuckoo_fingerprint(hash);
+    size_t starts[2] = {cuckoo_primary(hashmap, hash) * BUCKET_SIZE, cuckoo_secondary(hashmap, hash) * BUCKET_SIZE};
+    for (size_t b = 0; b < 2; b++) {
+        for (size_t i = starts[b]; i < starts[b] + BUCKET_SIZE; i++) {
+            if (hashmap->ctrl[i] == fingerprint) {
+                CS_PREFETCH(hashmap->buckets[i]);
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef HASHMAP_INTERNAL_H
+#define HASHMAP_INTERNAL_H
+
+#include "cstash/hashmap.h"
+#include "cstash/result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Shared between the HashMap front-end and its storage engines, not part of the public API
+
+static inline bool cs_hashmap_entry_matches(const CsHashMapEntry* entry, uint64_t hash, const void* key,
+                                            size_t key_len) {
+    return entry->hash == hash && entry->key_len == key_len && memcmp(entry->key, key, key_len) == 0;
+}
+
+// Fibonacci hashing: multiply by 2^64/phi and keep the top bits, which mixes every bit of the hash
+// into the bucket index (unlike a mask) without the cost of a 64-bit modulo
+#define CS_FIBONACCI_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+static inline size_t cs_hashmap_bucket_index(const CsHashMap* hashmap, uint64_t hash) {
+    return (size_t)((hash * CS_FIBONACCI_MULTIPLIER) >> hashmap->shift);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CS_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define CS_PREFETCH(address) ((void)(address))
+#endif
+
+CsHashMapEntry* cs_hashmap_new_entry(const void* key, size_t key_len, uint64_t hash, const void* value,
+                                     size_t value_size);
+void cs_hashmap_free_entry(CsHashMapEntry* entry);
+
+// Front-end operations on a precomputed hash (hashmap.c), for containers built on top of CsHashMap
+// cs_hashmap_create_sized accepts value_size 0: entries then hold the key alone (sets)
+CsHashMap* cs_hashmap_create_sized(size_t value_size, const CsHashMapOptions* options, size_t expected);
+CsHashMapEntry* cs_hashmap_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+CsResult cs_hashmap_insert_hashed(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len,
+                                  const void* value, CsHashMapEntry** out_entry);
+CsResult cs_hashmap_remove_hashed(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+
+// Chained engine (hashmap_chained.c)
+CsResult cs_chained_init(CsHashMap* hashmap, size_t capacity);
+CsHashMapEntry* cs_chained_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+CsResult cs_chained_insert(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry);
+CsHashMapEntry* cs_chained_remove(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+CsResult cs_chained_resize(CsHashMap* hashmap, size_t new_capacity);
+void cs_chained_clear(CsHashMap* hashmap);
+void cs_chained_prefetch_bucket(const CsHashMap* hashmap, uint64_t hash);
+void cs_chained_prefetch_entry(const CsHashMap* hashmap, uint64_t hash);
+
+// SwissTable engine (hashmap_swiss.c)
+CsResult cs_swiss_init(CsHashMap* hashmap, size_t capacity);
+CsHashMapEntry* cs_swiss_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+CsResult cs_swiss_insert(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry);
+CsHashMapEntry* cs_swiss_remove(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+CsResult cs_swiss_resize(CsHashMap* hashmap, size_t new_capacity);
+void cs_swiss_clear(CsHashMap* hashmap);
+void cs_swiss_prefetch_group(const CsHashMap* hashmap, uint64_t hash);
+void cs_swiss_prefetch_entry(const CsHashMap* hashmap, uint64_t hash);
+
+// Robin Hood engine (hashmap_robin_hood.c)
+CsResult cs_robin_hood_init(CsHashMap* hashmap, size_t capacity);
+CsHashMapEntry* cs_robin_hood_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+CsResult cs_robin_hood_insert(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry);
+CsHashMapEntry* cs_robin_hood_remove(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+CsResult cs_robin_hood_resize(CsHashMap* hashmap, size_t new_capacity);
+void cs_robin_hood_clear(CsHashMap* hashmap);
+void cs_robin_hood_prefetch_slot(const CsHashMap* hashmap, uint64_t hash);
+void cs_robin_hood_prefetch_entry(const CsHashMap* hashmap, uint64_t hash);
+
+// Bucketized cuckoo engine (hashmap_cuckoo.c)
+CsResult cs_cuckoo_init(CsHashMap* hashmap, size_t capacity);
+CsHashMapEntry* cs_cuckoo_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+CsResult cs_cuckoo_insert(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry);
+CsHashMapEntry* cs_cuckoo_remove(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len);
+CsResult cs_cuckoo_resize(CsHashMap* hashmap, size_t new_capacity);
+void cs_cuckoo_clear(CsHashMap* hashmap);
+void cs_cuckoo_prefetch_buckets(const CsHashMap* hashmap, uint64_t hash);
+void cs_cuckoo_prefetch_entry(const CsHashMap* hashmap, uint64_t hash);
+
+#endif // HASHMAP_INTERNAL_H
@@ -0,0 +1,232 @@
+#include "cstash/hashmap.h"
+#include "cstash/result.h"
+#include "hashmap_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ctrl holds capacity distance bytes then capacity fingerprint bytes
+// Distance byte: 0 = empty, d + 1 = entry stored d slots after its home slot
+#define RH_EMPTY ((uint8_t)0)
+#define RH_MAX_DISTANCE HASHMAP_ROBIN_HOOD_MAX_DISTANCE
+
+static inline uint8_t* rh_fingerprints(const CsHashMap* hashmap) {
+    return hashmap->ctrl + hashmap->capacity;
+}
+
+// Low byte of the hash, the home slot comes from its high bits
+static inline uint8_t rh_fingerprint(uint64_t hash) {
+    return (uint8_t)hash;
+}
+
+static inline size_t rh_max_load(size_t capacity) {
+    return (size_t)(capacity * HASHMAP_ROBIN_HOOD_MAX_LOAD_FACTOR);
+}
+
+// Smallest power of two >= requested able to hold size entries, 0 if it cannot be represented
+static size_t rh_capacity_for(size_t requested, size_t size) {
+    size_t capacity = HASHMAP_DEFAULT_CAPACITY;
+    while (capacity < requested || rh_max_load(capacity) < size) {
+        if (capacity > SIZE_MAX / 2 / sizeof(CsHashMapEntry*)) return 0;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static unsigned int rh_shift_for(size_t capacity) {
+    unsigned int shift = 64;
+    while (capacity > 1) {
+        capacity >>= 1;
+        shift--;
+    }
+    return shift;
+}
+
+// Entries of a run are ordered by distance to their home slot, so the probe stops at the first resident
+// closer to its home than the key would be: misses cost about as much as hits
+static bool rh_find_slot(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len, size_t* slot) {
+    size_t mask = hashmap->capacity - 1;
+    const uint8_t* fingerprints = rh_fingerprints(hashmap);
+    uint8_t fingerprint = rh_fingerprint(hash);
+    size_t index = cs_hashmap_bucket_index(hashmap, hash);
+
+    for (size_t distance = 1;; distance++) {
+        uint8_t ctrl = hashmap->ctrl[index];
+        if (ctrl < distance) return false; // empty, or a resident closer to home
+        if (fingerprints[index] == fingerprint &&
+            cs_hashmap_entry_matches(hashmap->buckets[index], hash, key, key_len)) {
+            *slot = index;
+            return true;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+// Store an entry known to be absent: it takes the first slot whose resident is closer to home than the entry
+// would be, and the rest of the run up to the next empty slot shifts one slot further
+// Returns false without touching the table if an entry would end up beyond RH_MAX_DISTANCE
+static bool rh_place(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry) {
+    size_t mask = hashmap->capacity - 1;
+    uint8_t* fingerprints = rh_fingerprints(hashmap);
+    size_t index = cs_hashmap_bucket_index(hashmap, hash);
+    size_t distance = 1;
+
+    while (hashmap->ctrl[index] >= distance) {
+        index = (index + 1) & mask;
+        if (++distance > RH_MAX_DISTANCE + 1) return false;
+    }
+
+    size_t end = index;
+    while (hashmap->ctrl[end] != RH_EMPTY) {
+        if (hashmap->ctrl[end] > RH_MAX_DISTANCE) return false;
+        end = (end + 1) & mask;
+    }
+
+    for (; end != index; end = (end - 1) & mask) {
+        size_t prev = (end - 1) & mask;
+        hashmap->ctrl[end] = (uint8_t)(hashmap->ctrl[prev] + 1);
+        fingerprints[end] = fingerprints[prev];
+        hashmap->buckets[end] = hashmap->buckets[prev];
+    }
+    hashmap->ctrl[index] = (uint8_t)distance;
+    fingerprints[index] = rh_fingerprint(hash);
+    hashmap->buckets[index] = entry;
+    return true;
+}
+
+static CsResult rh_alloc(CsHashMap* hashmap, size_t capacity) {
+    uint8_t* ctrl = calloc(capacity, 2);
+    CsHashMapEntry** slots = calloc(capacity, sizeof(CsHashMapEntry*));
+    if (!ctrl || !slots) {
+        free(ctrl);
+        free(slots);
+        return CS_ALLOCATION_FAILED;
+    }
+
+    hashmap->ctrl = ctrl;
+    hashmap->buckets = slots;
+    hashmap->capacity = capacity;
+    hashmap->shift = rh_shift_for(capacity);
+    return CS_SUCCESS;
+}
+
+CsResult cs_robin_hood_init(CsHashMap* hashmap, size_t capacity) {
+    capacity = rh_capacity_for(capacity, 0);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+
+    CsResult result = rh_alloc(hashmap, capacity);
+    if (result != CS_SUCCESS) return result;
+    hashmap->tombstones = 0;
+    return CS_SUCCESS;
+}
+
+CsHashMapEntry* cs_robin_hood_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    size_t slot;
+    if (!rh_find_slot(hashmap, hash, key, key_len, &slot)) return NULL;
+    return hashmap->buckets[slot];
+}
+
+CsResult cs_robin_hood_insert(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry) {
+    if (hashmap->size + 1 > rh_max_load(hashmap->capacity)) {
+        CsResult result = cs_robin_hood_resize(hashmap, hashmap->capacity * 2);
+        if (result != CS_SUCCESS) return result;
+    }
+
+    while (!rh_place(hashmap, hash, entry)) {
+        // A run too long for the bound is spread over a larger table, unless the table is already sparse:
+        // then the keys share their hash and no capacity would separate them
+        if (hashmap->size < hashmap->capacity / 8) return CS_OUT_OF_BOUNDS;
+
+        CsResult result = cs_robin_hood_resize(hashmap, hashmap->capacity * 2);
+        if (result != CS_SUCCESS) return result;
+    }
+    hashmap->size++;
+    return CS_SUCCESS;
+}
+
+CsHashMapEntry* cs_robin_hood_remove(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    size_t slot;
+    if (!rh_find_slot(hashmap, hash, key, key_len, &slot)) return NULL;
+
+    CsHashMapEntry* entry = hashmap->buckets[slot];
+    size_t mask = hashmap->capacity - 1;
+    uint8_t* fingerprints = rh_fingerprints(hashmap);
+
+    // Backward shift: the rest of the run moves one slot closer to home, so no tombstone is left behind
+    for (size_t next = (slot + 1) & mask; hashmap->ctrl[next] > 1; next = (next + 1) & mask) {
+        hashmap->ctrl[slot] = (uint8_t)(hashmap->ctrl[next] - 1);
+        fingerprints[slot] = fingerprints[next];
+        hashmap->buckets[slot] = hashmap->buckets[next];
+        slot = next;
+    }
+    hashmap->ctrl[slot] = RH_EMPTY;
+    hashmap->buckets[slot] = NULL;
+    hashmap->size--;
+    return entry;
+}
+
+CsResult cs_robin_hood_resize(CsHashMap* hashmap, size_t new_capacity) {
+    size_t capacity = rh_capacity_for(new_capacity, hashmap->size);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+
+    CsHashMap old = *hashmap;
+    for (;;) {
+        CsResult result = rh_alloc(hashmap, capacity);
+        if (result != CS_SUCCESS) {
+            *hashmap = old;
+            return result;
+        }
+
+        bool placed = true;
+        for (size_t i = 0; i < old.capacity && placed; i++) {
+            if (old.ctrl[i] != RH_EMPTY) placed = rh_place(hashmap, old.buckets[i]->hash, old.buckets[i]);
+        }
+        if (placed) break;
+
+        // a run of the requested size exceeds the bound, retry with twice the slots
+        free(hashmap->ctrl);
+        free(hashmap->buckets);
+        capacity = rh_capacity_for(capacity * 2, 0);
+        if (capacity == 0) {
+            *hashmap = old;
+            return CS_ALLOCATION_FAILED;
+        }
+    }
+
+    free(old.ctrl);
+    free(old.buckets);
+    return CS_SUCCESS;
+}
+
+void cs_robin_hood_clear(CsHashMap* hashmap) {
+    for (size_t i = 0; i < hashmap->capacity; i++) {
+        if (hashmap->ctrl[i] != RH_EMPTY) cs_hashmap_free_entry(hashmap->buckets[i]);
+    }
+    memset(hashmap->ctrl, RH_EMPTY, hashmap->capacity);
+    memset(hashmap->buckets, 0, hashmap->capacity * sizeof(CsHashMapEntry*));
+}
+
+void cs_robin_hood_prefetch_slot(const CsHashMap* hashmap, uint64_t hash) {
+    size_t index = cs_hashmap_bucket_index(hashmap, hash);
+    CS_PREFETCH(hashmap->ctrl + index);
+    CS_PREFETCH(rh_fingerprints(hashmap) + index);
+    CS_PREFETCH(hashmap->buckets + index);
+}
+
+// Called once the home slot is expected in cache: prefetch the first entry with a matching fingerprint
+void cs_robin_hood_prefetch_entry(const CsHashMap* hashmap, uint64_t hash) {
+    size_t mask = hashmap->capacity - 1;
+    const uint8_t* fingerprints = rh_fingerprints(hashmap);
+    uint8_t fingerprint = rh_fingerprint(hash);
+    size_t index = cs_hashmap_bucket_index(hashmap, hash);
+
+    for (size_t distance = 1; hashmap->ctrl[index] >= distance; distance++) {
+        if (fingerprints[index] == fingerprint) {
+            CS_PREFETCH(hashmap->buckets[index]);
+            return;
+        }
+        index = (index + 1) & mask;
+    }
+}
@@ -0,0 +1,237 @@
+#include "cstash/hashmap.h"
+#include "cstash/result.h"
+#include "hashmap_internal.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Control bytes: 0b0xxxxxxx = full (7-bit hash fragment), 0b1xxxxxxx = free
+#define CTRL_EMPTY ((uint8_t)0x80)
+#define CTRL_DELETED ((uint8_t)0xFE)
+#define GROUP_WIDTH HASHMAP_SWISS_GROUP_WIDTH
+
+// Low bits pick the group, top 7 bits are stored in the control byte
+static inline size_t swiss_h1(uint64_t hash) {
+    return (size_t)hash;
+}
+
+static inline uint8_t swiss_h2(uint64_t hash) {
+    return (uint8_t)(hash >> 57);
+}
+
+// Bitmask of the slots of a group whose control byte equals the given byte
+static inline uint32_t swiss_group_match(const uint8_t* group, uint8_t byte) {
+#if defined(__SSE2__)
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)byte)));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < GROUP_WIDTH; i++) {
+        mask |= (uint32_t)(group[i] == byte) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bitmask of the empty or deleted slots of a group (high bit set)
+static inline uint32_t swiss_group_match_free(const uint8_t* group) {
+#if defined(__SSE2__)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < GROUP_WIDTH; i++) {
+        mask |= (uint32_t)(group[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+static inline size_t swiss_lowest_bit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctz(mask);
+#else
+    size_t bit = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static inline size_t swiss_max_load(size_t capacity) {
+    return (size_t)(capacity * HASHMAP_SWISS_MAX_LOAD_FACTOR);
+}
+
+// Smallest power of two >= requested (and >= one group) able to hold size entries, 0 if it cannot be represented
+static size_t swiss_capacity_for(size_t requested, size_t size) {
+    size_t capacity = GROUP_WIDTH;
+    while (capacity < requested || swiss_max_load(capacity) < size) {
+        if (capacity > SIZE_MAX / 2 / sizeof(CsHashMapEntry*)) return 0;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+// Triangular probing over groups visits every group once when their count is a power of two
+static bool swiss_find_slot(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len,
+                            size_t* slot) {
+    size_t group_mask = hashmap->capacity / GROUP_WIDTH - 1;
+    size_t group = swiss_h1(hash) & group_mask;
+    uint8_t h2 = swiss_h2(hash);
+
+    for (size_t step = 1; step <= group_mask + 1; step++) {
+        const uint8_t* ctrl = hashmap->ctrl + group * GROUP_WIDTH;
+
+        uint32_t match = swiss_group_match(ctrl, h2);
+        while (match) {
+            size_t index = group * GROUP_WIDTH + swiss_lowest_bit(match);
+            if (cs_hashmap_entry_matches(hashmap->buckets[index], hash, key, key_len)) {
+                *slot = index;
+                return true;
+            }
+            match &= match - 1;
+        }
+        // an empty slot ends the probe sequence, the key would have been stored there
+        if (swiss_group_match(ctrl, CTRL_EMPTY)) return false;
+
+        group = (group + step) & group_mask;
+    }
+    return false;
+}
+
+// Store an entry known to be absent, the caller guarantees a free slot exists
+static void swiss_place(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry) {
+    size_t group_mask = hashmap->capacity / GROUP_WIDTH - 1;
+    size_t group = swiss_h1(hash) & group_mask;
+
+    for (size_t step = 1;; step++) {
+        uint32_t free_slots = swiss_group_match_free(hashmap->ctrl + group * GROUP_WIDTH);
+        if (free_slots) {
+            size_t index = group * GROUP_WIDTH + swiss_lowest_bit(free_slots);
+            if (hashmap->ctrl[index] == CTRL_DELETED) hashmap->tombstones--;
+            hashmap->ctrl[index] = swiss_h2(hash);
+            hashmap->buckets[index] = entry;
+            return;
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+CsResult cs_swiss_init(CsHashMap* hashmap, size_t capacity) {
+    capacity = swiss_capacity_for(capacity, 0);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+
+    hashmap->ctrl = malloc(capacity);
+    hashmap->buckets = calloc(capacity, sizeof(CsHashMapEntry*));
+    if (!hashmap->ctrl || !hashmap->buckets) {
+        free(hashmap->ctrl);
+        free(hashmap->buckets);
+        return CS_ALLOCATION_FAILED;
+    }
+
+    memset(hashmap->ctrl, CTRL_EMPTY, capacity);
+    hashmap->capacity = capacity;
+    hashmap->tombstones = 0;
+    return CS_SUCCESS;
+}
+
+CsHashMapEntry* cs_swiss_find(const CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    size_t slot;
+    if (!swiss_find_slot(hashmap, hash, key, key_len, &slot)) return NULL;
+    return hashmap->buckets[slot];
+}
+
+CsResult cs_swiss_insert(CsHashMap* hashmap, uint64_t hash, CsHashMapEntry* entry) {
+    if (hashmap->size + hashmap->tombstones + 1 > swiss_max_load(hashmap->capacity)) {
+        // mostly tombstones: rehash in place, otherwise grow
+        size_t capacity = hashmap->capacity;
+        if (hashmap->size + 1 > swiss_max_load(capacity) / 2) capacity *= 2;
+
+        CsResult result = cs_swiss_resize(hashmap, capacity);
+        if (result != CS_SUCCESS) return result;
+    }
+
+    swiss_place(hashmap, hash, entry);
+    hashmap->size++;
+    return CS_SUCCESS;
+}
+
+CsHashMapEntry* cs_swiss_remove(CsHashMap* hashmap, uint64_t hash, const void* key, size_t key_len) {
+    size_t slot;
+    if (!swiss_find_slot(hashmap, hash, key, key_len, &slot)) return NULL;
+
+    CsHashMapEntry* entry = hashmap->buckets[slot];
+
+    // With aligned groups, a group that still has an empty slot never let a probe go past it,
+    // so the slot can become empty again instead of a tombstone
+    const uint8_t* group = hashmap->ctrl + (slot & ~(size_t)(GROUP_WIDTH - 1));
+    if (swiss_group_match(group, CTRL_EMPTY)) {
+        hashmap->ctrl[slot] = CTRL_EMPTY;
+    } else {
+        hashmap->ctrl[slot] = CTRL_DELETED;
+        hashmap->tombstones++;
+    }
+    hashmap->buckets[slot] = NULL;
+    hashmap->size--;
+    return entry;
+}
+
+CsResult cs_swiss_resize(CsHashMap* hashmap, size_t new_capacity) {
+    size_t capacity = swiss_capacity_for(new_capacity, hashmap->size);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+
+    uint8_t* ctrl = malloc(capacity);
+    CsHashMapEntry** slots = calloc(capacity, sizeof(CsHashMapEntry*));
+    if (!ctrl || !slots) {
+        free(ctrl);
+        free(slots);
+        return CS_ALLOCATION_FAILED;
+    }
+    memset(ctrl, CTRL_EMPTY, capacity);
+
+    uint8_t* old_ctrl = hashmap->ctrl;
+    CsHashMapEntry** old_slots = hashmap->buckets;
+    size_t old_capacity = hashmap->capacity;
+
+    hashmap->ctrl = ctrl;
+    hashmap->buckets = slots;
+    hashmap->capacity = capacity;
+    hashmap->tombstones = 0;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_ctrl[i] & CTRL_EMPTY) continue;
+        swiss_place(hashmap, old_slots[i]->hash, old_slots[i]);
+    }
+
+    free(old_ctrl);
+    free(old_slots);
+    return CS_SUCCESS;
+}
+
+void cs_swiss_clear(CsHashMap* hashmap) {
+    for (size_t i = 0; i < hashmap->capacity; i++) {
+        if (!(hashmap->ctrl[i] & CTRL_EMPTY)) cs_hashmap_free_entry(hashmap->buckets[i]);
+    }
+    memset(hashmap->ctrl, CTRL_EMPTY, hashmap->capacity);
+    memset(hashmap->buckets, 0, hashmap->capacity * sizeof(CsHashMapEntry*));
+    hashmap->tombstones = 0;
+}
+
+void cs_swiss_prefetch_group(const CsHashMap* hashmap, uint64_t hash) {
+    size_t group = swiss_h1(hash) & (hashmap->capacity / GROUP_WIDTH - 1);
+    CS_PREFETCH(hashmap->ctrl + group * GROUP_WIDTH);
+    CS_PREFETCH(hashmap->buckets + group * GROUP_WIDTH);
+}
+
+// Called once the control group is expected in cache: prefetch the first candidate entry
+void cs_swiss_prefetch_entry(const CsHashMap* hashmap, uint64_t hash) {
+    size_t group = swiss_h1(hash) & (hashmap->capacity / GROUP_WIDTH - 1);
+    uint32_t match = swiss_group_match(hashmap->ctrl + group * GROUP_WIDTH, swiss_h2(hash));
+    if (match) CS_PREFETCH(hashmap->buckets[group * GROUP_WIDTH + swiss_lowest_bit(match)]);
+}
@@ -0,0 +1,278 @@
+#include "cstash/hashset.h"
+#include "cstash/hash.h"
+#include "cstash/result.h"
+#include "hashmap_internal.h"
+#include "int_hashmap_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// String keys
+// ============================================================================
+
+// The map behind every set is created here with the default hash, so cached hashes are valid in any other set
+static CsHashSet* cs_hashset_create_sized(size_t expected) {
+    CsHashSet* set = malloc(sizeof(CsHashSet));
+    if (!set) return NULL;
+
+    set->map = cs_hashmap_create_sized(0, NULL, expected);
+    if (!set->map) {
+        free(set);
+        return NULL;
+    }
+    return set;
+}
+
+CsHashSet* cs_hashset_create(void) {
+    return cs_hashset_create_sized(0);
+}
+
+CsHashSet* cs_hashset_create_with_capacity(size_t expected_entries) {
+    return cs_hashset_create_sized(expected_entries);
+}
+
+void cs_hashset_destroy(CsHashSet* set) {
+    if (!set) return;
+    cs_hashmap_destroy(set->map);
+    free(set);
+}
+
+CsResult cs_hashset_add(CsHashSet* set, const char* key) {
+    if (!set || !key) return CS_NULL_POINTER;
+
+    return cs_hashset_add_n(set, key, strlen(key));
+}
+
+CsResult cs_hashset_add_n(CsHashSet* set, const void* key, size_t key_len) {
+    if (!set || !key) return CS_NULL_POINTER;
+
+    uint64_t hash = set->map->hash(key, key_len);
+    if (cs_hashmap_find(set->map, hash, key, key_len)) return CS_CONFLICT;
+
+    return cs_hashmap_insert_hashed(set->map, hash, key, key_len, NULL, NULL);
+}
+
+bool cs_hashset_contains(const CsHashSet* set, const char* key) {
+    if (!set || !key) return false;
+
+    return cs_hashmap_has_n(set->map, key, strlen(key));
+}
+
+bool cs_hashset_contains_n(const CsHashSet* set, const void* key, size_t key_len) {
+    if (!set || !key) return false;
+
+    return cs_hashmap_has_n(set->map, key, key_len);
+}
+
+CsResult cs_hashset_remove(CsHashSet* set, const char* key) {
+    if (!set || !key) return CS_NULL_POINTER;
+
+    return cs_hashmap_remove_n(set->map, key, strlen(key));
+}
+
+CsResult cs_hashset_remove_n(CsHashSet* set, const void* key, size_t key_len) {
+    if (!set || !key) return CS_NULL_POINTER;
+
+    return cs_hashmap_remove_n(set->map, key, key_len);
+}
+
+size_t cs_hashset_size(const CsHashSet* set) {
+    return set ? set->map->size : 0;
+}
+
+void cs_hashset_clear(CsHashSet* set) {
+    if (!set) return;
+    cs_hashmap_clear(set->map);
+}
+
+bool cs_hashset_next(const CsHashSet* set, size_t* cursor, const char** key, size_t* key_len) {
+    if (!set || !cursor) return false;
+
+    const CsHashMap* map = set->map;
+    while (*cursor < map->order_len) {
+        const CsHashMapEntry* entry = map->order[(*cursor)++];
+        if (!entry) continue;
+        if (key) *key = entry->key;
+        if (key_len) *key_len = entry->key_len;
+        return true;
+    }
+    return false;
+}
+
+// Copy the entries of from into result, skipping those present in exclude (when given) or absent from
+// require (when given). Hashes come from the entries themselves, and the result was sized up front,
+// so each key costs at most one lookup and one insertion that never resizes
+static CsResult cs_hashset_copy_entries(CsHashSet* result, const CsHashSet* from, const CsHashSet* exclude,
+                                        const CsHashSet* require) {
+    const CsHashMap* map = from->map;
+    for (size_t i = 0; i < map->order_len; i++) {
+        const CsHashMapEntry* entry = map->order[i];
+        if (!entry) continue;
+        if (exclude && cs_hashmap_find(exclude->map, entry->hash, entry->key, entry->key_len)) continue;
+        if (require && !cs_hashmap_find(require->map, entry->hash, entry->key, entry->key_len)) continue;
+
+        CsResult status = cs_hashmap_insert_hashed(result->map, entry->hash, entry->key, entry->key_len, NULL, NULL);
+        if (status != CS_SUCCESS) return status;
+    }
+    return CS_SUCCESS;
+}
+
+static CsHashSet* cs_hashset_finish(CsHashSet* result, CsResult status) {
+    if (status == CS_SUCCESS) return result;
+    cs_hashset_destroy(result);
+    return NULL;
+}
+
+CsHashSet* cs_hashset_union(const CsHashSet* a, const CsHashSet* b) {
+    if (!a || !b || a->map->size > SIZE_MAX - b->map->size) return NULL;
+
+    CsHashSet* result = cs_hashset_create_sized(a->map->size + b->map->size);
+    if (!result) return NULL;
+
+    CsResult status = cs_hashset_copy_entries(result, a, NULL, NULL);
+    if (status == CS_SUCCESS) status = cs_hashset_copy_entries(result, b, a, NULL);
+    return cs_hashset_finish(result, status);
+}
+
+CsHashSet* cs_hashset_intersection(const CsHashSet* a, const CsHashSet* b) {
+    if (!a || !b) return NULL;
+
+    const CsHashSet* smaller = a->map->size <= b->map->size ? a : b;
+    const CsHashSet* larger = smaller == a ? b : a;
+
+    CsHashSet* result = cs_hashset_create_sized(smaller->map->size);
+    if (!result) return NULL;
+
+    return cs_hashset_finish(result, cs_hashset_copy_entries(result, smaller, NULL, larger));
+}
+
+CsHashSet* cs_hashset_difference(const CsHashSet* a, const CsHashSet* b) {
+    if (!a || !b) return NULL;
+
+    CsHashSet* result = cs_hashset_create_sized(a->map->size);
+    if (!result) return NULL;
+
+    return cs_hashset_finish(result, cs_hashset_copy_entries(result, a, b, NULL));
+}
+
+// ============================================================================
+// Integer keys
+// ============================================================================
+
+static CsIntHashSet* cs_int_hashset_create_sized(size_t expected) {
+    CsIntHashSet* set = malloc(sizeof(CsIntHashSet));
+    if (!set) return NULL;
+
+    set->map = cs_int_hashmap_create_with_capacity(0, expected);
+    if (!set->map) {
+        free(set);
+        return NULL;
+    }
+    return set;
+}
+
+CsIntHashSet* cs_int_hashset_create(void) {
+    return cs_int_hashset_create_sized(0);
+}
+
+CsIntHashSet* cs_int_hashset_create_with_capacity(size_t expected_entries) {
+    return cs_int_hashset_create_sized(expected_entries);
+}
+
+void cs_int_hashset_destroy(CsIntHashSet* set) {
+    if (!set) return;
+    cs_int_hashmap_destroy(set->map);
+    free(set);
+}
+
+CsResult cs_int_hashset_add(CsIntHashSet* set, uint64_t key) {
+    if (!set) return CS_NULL_POINTER;
+
+    // no value to copy: the key alone goes through the map's own insertion
+    return cs_int_hashmap_insert(set->map, key, &key);
+}
+
+bool cs_int_hashset_contains(const CsIntHashSet* set, uint64_t key) {
+    return set && cs_int_hashmap_has(set->map, key);
+}
+
+CsResult cs_int_hashset_remove(CsIntHashSet* set, uint64_t key) {
+    if (!set) return CS_NULL_POINTER;
+
+    return cs_int_hashmap_remove(set->map, key);
+}
+
+size_t cs_int_hashset_size(const CsIntHashSet* set) {
+    return set ? set->map->size : 0;
+}
+
+void cs_int_hashset_clear(CsIntHashSet* set) {
+    if (!set) return;
+    cs_int_hashmap_clear(set->map);
+}
+
+bool cs_int_hashset_next(const CsIntHashSet* set, size_t* cursor, uint64_t* key) {
+    if (!set) return false;
+
+    return cs_int_hashmap_next(set->map, cursor, key, NULL);
+}
+
+// Place the keys of from into result under the same rules as the string sets. The result is sized for
+// every key it may receive and starts without tombstones, so placing never needs a rehash
+static void cs_int_hashset_copy_keys(CsIntHashSet* result, const CsIntHashSet* from, const CsIntHashSet* exclude,
+                                     const CsIntHashSet* require, bool check_result) {
+    size_t cursor = 0;
+    uint64_t key;
+    while (cs_int_hashmap_next(from->map, &cursor, &key, NULL)) {
+        uint64_t hash = cs_hash_u64(key);
+        if (exclude && cs_int_hashmap_find(exclude->map, key, hash)) continue;
+        if (require && !cs_int_hashmap_find(require->map, key, hash)) continue;
+        if (check_result && cs_int_hashmap_find(result->map, key, hash)) continue;
+        cs_int_hashmap_place(result->map, key, hash);
+    }
+}
+
+CsIntHashSet* cs_int_hashset_union(const CsIntHashSet* a, const CsIntHashSet* b) {
+    if (!a || !b || a->map->size > SIZE_MAX - b->map->size) return NULL;
+
+    CsIntHashSet* result = cs_int_hashset_create_sized(a->map->size + b->map->size);
+    if (!result) return NULL;
+
+    CsIntHashMap* map = result->map;
+    if (map->capacity == a->map->capacity && a->map->tombstones == 0) {
+        // same slot layout, every key of a lands where it already is
+        memcpy(map->ctrl, a->map->ctrl, map->capacity);
+        memcpy(map->slots, a->map->slots, map->capacity * map->slot_size);
+        map->size = a->map->size;
+    } else {
+        cs_int_hashset_copy_keys(result, a, NULL, NULL, false);
+    }
+    cs_int_hashset_copy_keys(result, b, NULL, NULL, true);
+    return result;
+}
+
+CsIntHashSet* cs_int_hashset_intersection(const CsIntHashSet* a, const CsIntHashSet* b) {
+    if (!a || !b) return NULL;
+
+    const CsIntHashSet* smaller = a->map->size <= b->map->size ? a : b;
+    const CsIntHashSet* larger = smaller == a ? b : a;
+
+    CsIntHashSet* result = cs_int_hashset_create_sized(smaller->map->size);
+    if (!result) return NULL;
+
+    cs_int_hashset_copy_keys(result, smaller, NULL, larger, false);
+    return result;
+}
+
+CsIntHashSet* cs_int_hashset_difference(const CsIntHashSet* a, const CsIntHashSet* b) {
+    if (!a || !b) return NULL;
+
+    CsIntHashSet* result = cs_int_hashset_create_sized(a->map->size);
+    if (!result) return NULL;
+
+    cs_int_hashset_copy_keys(result, a, b, NULL, false);
+    return result;
+}
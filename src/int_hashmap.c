@@ -0,0 +1,216 @@
+#include "cstash/int_hashmap.h"
+#include "cstash/hash.h"
+#include "int_hashmap_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INT_HASHMAP_KEY_SIZE sizeof(uint64_t)
+
+static inline char* cs_int_hashmap_slot(const CsIntHashMap* map, size_t index) {
+    return map->slots + index * map->slot_size;
+}
+
+static inline uint64_t cs_int_hashmap_slot_key(const char* slot) {
+    uint64_t key;
+    memcpy(&key, slot, sizeof(key));
+    return key;
+}
+
+// Slot index from the low bits, tag from the top 7: cs_hash_u64 mixes every bit, and with the index taken from
+// the low bits, slot order is not hash order. Copying a map in slot order into a smaller, growing one (the
+// way set operations and user loops do) then spreads the keys instead of piling them into one cluster
+static inline uint8_t cs_int_hashmap_h2(uint64_t hash) {
+    return (uint8_t)(hash >> 57);
+}
+
+static CsResult cs_int_hashmap_init(CsIntHashMap* map, size_t capacity) {
+    uint8_t* ctrl = malloc(capacity);
+    char* slots = malloc(capacity * map->slot_size);
+    if (!ctrl || !slots) {
+        free(ctrl);
+        free(slots);
+        return CS_ALLOCATION_FAILED;
+    }
+    memset(ctrl, CS_INT_HASHMAP_EMPTY, capacity);
+
+    map->ctrl = ctrl;
+    map->slots = slots;
+    map->capacity = capacity;
+    map->size = 0;
+    map->tombstones = 0;
+    return CS_SUCCESS;
+}
+
+// Power of two holding entries under HASHMAP_MAX_LOAD_FACTOR, 0 if too large
+static size_t cs_int_hashmap_capacity_for(size_t slot_size, size_t entries) {
+    size_t capacity = HASHMAP_DEFAULT_CAPACITY;
+    while ((double)entries >= capacity * HASHMAP_MAX_LOAD_FACTOR) {
+        if (capacity > SIZE_MAX / 2 / slot_size) return 0;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+CsIntHashMap* cs_int_hashmap_create(size_t value_size) {
+    return cs_int_hashmap_create_with_capacity(value_size, 0);
+}
+
+CsIntHashMap* cs_int_hashmap_create_with_capacity(size_t value_size, size_t expected_entries) {
+    if (value_size > SIZE_MAX - 2 * INT_HASHMAP_KEY_SIZE) return NULL;
+    size_t slot_size = (INT_HASHMAP_KEY_SIZE + value_size + 7) & ~(size_t)7;
+    size_t capacity = cs_int_hashmap_capacity_for(slot_size, expected_entries);
+    if (capacity == 0) return NULL;
+
+    CsIntHashMap* map = malloc(sizeof(CsIntHashMap));
+    if (!map) return NULL;
+    map->value_size = value_size;
+    map->slot_size = slot_size;
+    if (cs_int_hashmap_init(map, capacity) != CS_SUCCESS) {
+        free(map);
+        return NULL;
+    }
+    return map;
+}
+
+void cs_int_hashmap_destroy(CsIntHashMap* map) {
+    if (!map) return;
+    free(map->ctrl);
+    free(map->slots);
+    free(map);
+}
+
+// Probe until the key or an empty slot: the load factor guarantees an empty slot exists
+char* cs_int_hashmap_find(const CsIntHashMap* map, uint64_t key, uint64_t hash) {
+    uint8_t h2 = cs_int_hashmap_h2(hash);
+    size_t mask = map->capacity - 1;
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+        uint8_t ctrl = map->ctrl[i];
+        if (ctrl == CS_INT_HASHMAP_EMPTY) return NULL;
+        if (ctrl == h2) {
+            char* slot = cs_int_hashmap_slot(map, i);
+            if (cs_int_hashmap_slot_key(slot) == key) return slot;
+        }
+    }
+}
+
+// Store a key known to be absent in the first free slot of its probe sequence, return the value area
+char* cs_int_hashmap_place(CsIntHashMap* map, uint64_t key, uint64_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t i = (size_t)hash & mask;
+    while (!(map->ctrl[i] & 0x80)) i = (i + 1) & mask;
+    if (map->ctrl[i] == CS_INT_HASHMAP_DELETED) map->tombstones--;
+    map->ctrl[i] = cs_int_hashmap_h2(hash);
+    map->size++;
+
+    char* slot = cs_int_hashmap_slot(map, i);
+    memcpy(slot, &key, sizeof(key));
+    return slot + INT_HASHMAP_KEY_SIZE;
+}
+
+// Rehash before an insertion would push live entries and tombstones over the load factor
+static CsResult cs_int_hashmap_reserve_one(CsIntHashMap* map) {
+    if ((double)(map->size + map->tombstones + 1) < map->capacity * HASHMAP_MAX_LOAD_FACTOR) return CS_SUCCESS;
+
+    size_t capacity = cs_int_hashmap_capacity_for(map->slot_size, map->size + 1);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+    if (capacity < map->capacity) capacity = map->capacity;
+
+    CsIntHashMap old = *map;
+    if (cs_int_hashmap_init(map, capacity) != CS_SUCCESS) {
+        *map = old;
+        return CS_ALLOCATION_FAILED;
+    }
+    for (size_t i = 0; i < old.capacity; i++) {
+        if (old.ctrl[i] & 0x80) continue;
+        const char* slot = cs_int_hashmap_slot(&old, i);
+        uint64_t key = cs_int_hashmap_slot_key(slot);
+        memcpy(cs_int_hashmap_place(map, key, cs_hash_u64(key)), slot + INT_HASHMAP_KEY_SIZE, map->value_size);
+    }
+    free(old.ctrl);
+    free(old.slots);
+    return CS_SUCCESS;
+}
+
+void* cs_int_hashmap_get(const CsIntHashMap* map, uint64_t key) {
+    if (!map) return NULL;
+    char* slot = cs_int_hashmap_find(map, key, cs_hash_u64(key));
+    return slot ? slot + INT_HASHMAP_KEY_SIZE : NULL;
+}
+
+bool cs_int_hashmap_has(const CsIntHashMap* map, uint64_t key) {
+    return cs_int_hashmap_get(map, key) != NULL;
+}
+
+CsResult cs_int_hashmap_insert(CsIntHashMap* map, uint64_t key, const void* value) {
+    if (!map || !value) return CS_NULL_POINTER;
+    uint64_t hash = cs_hash_u64(key);
+    if (cs_int_hashmap_find(map, key, hash)) return CS_CONFLICT;
+    if (cs_int_hashmap_reserve_one(map) != CS_SUCCESS) return CS_ALLOCATION_FAILED;
+    memcpy(cs_int_hashmap_place(map, key, hash), value, map->value_size);
+    return CS_SUCCESS;
+}
+
+void* cs_int_hashmap_upsert(CsIntHashMap* map, uint64_t key, const void* value) {
+    if (!map || !value) return NULL;
+    uint64_t hash = cs_hash_u64(key);
+    char* data;
+    char* slot = cs_int_hashmap_find(map, key, hash);
+    if (slot) {
+        data = slot + INT_HASHMAP_KEY_SIZE;
+    } else {
+        if (cs_int_hashmap_reserve_one(map) != CS_SUCCESS) return NULL;
+        data = cs_int_hashmap_place(map, key, hash);
+    }
+    memmove(data, value, map->value_size);
+    return data;
+}
+
+CsResult cs_int_hashmap_take(CsIntHashMap* map, uint64_t key, void* out_value) {
+    if (!map) return CS_NULL_POINTER;
+    char* slot = cs_int_hashmap_find(map, key, cs_hash_u64(key));
+    if (!slot) return CS_NOT_FOUND;
+    if (out_value) memcpy(out_value, slot + INT_HASHMAP_KEY_SIZE, map->value_size);
+
+    // a slot followed by an empty one ends no probe sequence, it can become empty again
+    size_t i = (size_t)(slot - map->slots) / map->slot_size;
+    if (map->ctrl[(i + 1) & (map->capacity - 1)] == CS_INT_HASHMAP_EMPTY) {
+        map->ctrl[i] = CS_INT_HASHMAP_EMPTY;
+    } else {
+        map->ctrl[i] = CS_INT_HASHMAP_DELETED;
+        map->tombstones++;
+    }
+    map->size--;
+    return CS_SUCCESS;
+}
+
+CsResult cs_int_hashmap_remove(CsIntHashMap* map, uint64_t key) {
+    return cs_int_hashmap_take(map, key, NULL);
+}
+
+void cs_int_hashmap_clear(CsIntHashMap* map) {
+    if (!map) return;
+    memset(map->ctrl, CS_INT_HASHMAP_EMPTY, map->capacity);
+    map->size = 0;
+    map->tombstones = 0;
+}
+
+size_t cs_int_hashmap_size(const CsIntHashMap* map) {
+    return map ? map->size : 0;
+}
+
+bool cs_int_hashmap_next(const CsIntHashMap* map, size_t* cursor, uint64_t* key, void** value) {
+    if (!map || !cursor) return false;
+    for (; *cursor < map->capacity; (*cursor)++) {
+        size_t i = *cursor;
+        if (map->ctrl[i] & 0x80) continue;
+        (*cursor)++;
+        char* slot = cs_int_hashmap_slot(map, i);
+        if (key) *key = cs_int_hashmap_slot_key(slot);
+        if (value) *value = slot + INT_HASHMAP_KEY_SIZE;
+        return true;
+    }
+    return false;
+}
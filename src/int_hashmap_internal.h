@@ -0,0 +1,16 @@
+#ifndef INT_HASHMAP_INTERNAL_H
+#define INT_HASHMAP_INTERNAL_H
+
+#include "cstash/int_hashmap.h"
+
+#include <stdint.h>
+
+// Shared between the IntHashMap and the containers built on top of it, not part of the public API
+
+// Slot holding key (key then value), NULL if absent; hash is cs_hash_u64(key)
+char* cs_int_hashmap_find(const CsIntHashMap* map, uint64_t key, uint64_t hash);
+
+// Store a key known to be absent and return its value area, the caller keeps size + tombstones under the load factor
+char* cs_int_hashmap_place(CsIntHashMap* map, uint64_t key, uint64_t hash);
+
+#endif // INT_HASHMAP_INTERNAL_H
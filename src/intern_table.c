@@ -0,0 +1,250 @@
+#include "cstash/intern_table.h"
+#include "cstash/hash.h"
+#include "cstash/hashmap.h"
+#include "cstash/result.h"
+#include "hashmap_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INTERN_TAG_MASK 0xFFFFFFFF00000000ULL
+#define INTERN_ID_MASK 0x00000000FFFFFFFFULL
+
+// Power of two index holding strings under HASHMAP_MAX_LOAD_FACTOR, 0 if too large
+static size_t cs_intern_table_index_capacity_for(size_t strings) {
+    size_t capacity = HASHMAP_DEFAULT_CAPACITY;
+    while ((double)strings >= capacity * HASHMAP_MAX_LOAD_FACTOR) {
+        if (capacity > SIZE_MAX / 2 / sizeof(uint64_t)) return 0;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static CsResult cs_intern_table_alloc_index(CsInternTable* table, size_t capacity) {
+    uint64_t* index = calloc(capacity, sizeof(uint64_t));
+    if (!index) return CS_ALLOCATION_FAILED;
+
+    table->index = index;
+    table->index_capacity = capacity;
+    table->shift = 64;
+    while (capacity > 1) {
+        capacity >>= 1;
+        table->shift--;
+    }
+    return CS_SUCCESS;
+}
+
+static inline size_t cs_intern_table_home(const CsInternTable* table, uint64_t hash) {
+    return (size_t)((hash * CS_FIBONACCI_MULTIPLIER) >> table->shift);
+}
+
+CsInternTable* cs_intern_table_create(void) {
+    return cs_intern_table_create_with_capacity(0);
+}
+
+CsInternTable* cs_intern_table_create_with_capacity(size_t expected_strings) {
+    size_t capacity = cs_intern_table_index_capacity_for(expected_strings);
+    if (capacity == 0 || expected_strings > SIZE_MAX / sizeof(CsInternString)) return NULL;
+
+    CsInternTable* table = malloc(sizeof(CsInternTable));
+    if (!table) return NULL;
+
+    table->strings = NULL;
+    table->size = 0;
+    table->strings_capacity = 0;
+    table->chunks = NULL;
+    table->chunk_count = 0;
+    table->chunk_capacity = 0;
+    table->cursor = NULL;
+    table->remaining = 0;
+    table->arena_bytes = 0;
+
+    if (cs_intern_table_alloc_index(table, capacity) != CS_SUCCESS) {
+        free(table);
+        return NULL;
+    }
+    if (expected_strings > 0) {
+        table->strings = malloc(expected_strings * sizeof(CsInternString));
+        if (!table->strings) {
+            cs_intern_table_destroy(table);
+            return NULL;
+        }
+        table->strings_capacity = expected_strings;
+    }
+    return table;
+}
+
+void cs_intern_table_destroy(CsInternTable* table) {
+    if (!table) return;
+
+    for (size_t i = 0; i < table->chunk_count; i++) free(table->chunks[i]);
+    free(table->chunks);
+    free(table->strings);
+    free(table->index);
+    free(table);
+}
+
+// Probe for the string: true with its ID if present, false with the empty slot ending the probe otherwise
+// The high hash bits kept in each slot filter out almost every other string before its record is read
+static bool cs_intern_table_probe(const CsInternTable* table, uint64_t hash, const void* str, size_t len,
+                                  CsInternId* id, size_t* empty_slot) {
+    uint64_t tag = hash & INTERN_TAG_MASK;
+    size_t mask = table->index_capacity - 1;
+    for (size_t i = cs_intern_table_home(table, hash);; i = (i + 1) & mask) {
+        uint64_t slot = table->index[i];
+        if (slot == 0) {
+            if (empty_slot) *empty_slot = i;
+            return false;
+        }
+        if ((slot & INTERN_TAG_MASK) != tag) continue;
+
+        CsInternId candidate = (CsInternId)((slot & INTERN_ID_MASK) - 1);
+        const CsInternString* record = &table->strings[candidate];
+        if (record->hash == hash && record->len == len && memcmp(record->str, str, len) == 0) {
+            *id = candidate;
+            return true;
+        }
+    }
+}
+
+// Double the index, slots are rebuilt from the hashes kept in the records: no string is rehashed or compared
+static CsResult cs_intern_table_grow_index(CsInternTable* table) {
+    size_t capacity = cs_intern_table_index_capacity_for(table->size + 1);
+    if (capacity == 0) return CS_ALLOCATION_FAILED;
+    if (capacity <= table->index_capacity) return CS_SUCCESS;
+
+    uint64_t* old_index = table->index;
+    if (cs_intern_table_alloc_index(table, capacity) != CS_SUCCESS) return CS_ALLOCATION_FAILED;
+
+    size_t mask = capacity - 1;
+    for (size_t id = 0; id < table->size; id++) {
+        uint64_t hash = table->strings[id].hash;
+        size_t i = cs_intern_table_home(table, hash);
+        while (table->index[i] != 0) i = (i + 1) & mask;
+        table->index[i] = (hash & INTERN_TAG_MASK) | (uint64_t)(id + 1);
+    }
+    free(old_index);
+    return CS_SUCCESS;
+}
+
+static CsResult cs_intern_table_grow_strings(CsInternTable* table) {
+    if (table->size < table->strings_capacity) return CS_SUCCESS;
+
+    size_t capacity = table->strings_capacity ? table->strings_capacity * 2 : HASHMAP_DEFAULT_CAPACITY;
+    if (capacity > SIZE_MAX / sizeof(CsInternString)) return CS_ALLOCATION_FAILED;
+
+    CsInternString* strings = realloc(table->strings, capacity * sizeof(CsInternString));
+    if (!strings) return CS_ALLOCATION_FAILED;
+
+    table->strings = strings;
+    table->strings_capacity = capacity;
+    return CS_SUCCESS;
+}
+
+// Carve bytes out of the arena. A string longer than half a chunk gets a chunk of its own and the current chunk
+// keeps serving short strings, so one long string never wastes the rest of a chunk
+static char* cs_intern_table_arena_alloc(CsInternTable* table, size_t bytes) {
+    if (bytes <= table->remaining) {
+        char* memory = table->cursor;
+        table->cursor += bytes;
+        table->remaining -= bytes;
+        return memory;
+    }
+
+    if (table->chunk_count == table->chunk_capacity) {
+        size_t capacity = table->chunk_capacity ? table->chunk_capacity * 2 : HASHMAP_DEFAULT_CAPACITY;
+        char** chunks = realloc(table->chunks, capacity * sizeof(char*));
+        if (!chunks) return NULL;
+        table->chunks = chunks;
+        table->chunk_capacity = capacity;
+    }
+
+    bool dedicated = bytes > INTERN_TABLE_CHUNK_SIZE / 2;
+    size_t chunk_size = dedicated ? bytes : INTERN_TABLE_CHUNK_SIZE;
+    char* chunk = malloc(chunk_size);
+    if (!chunk) return NULL;
+
+    table->chunks[table->chunk_count++] = chunk;
+    table->arena_bytes += chunk_size;
+    if (!dedicated) {
+        table->cursor = chunk + bytes;
+        table->remaining = chunk_size - bytes;
+    }
+    return chunk;
+}
+
+const char* cs_intern_table_intern(CsInternTable* table, const char* str, CsInternId* out_id) {
+    if (!table || !str) return NULL;
+
+    return cs_intern_table_intern_n(table, str, strlen(str), out_id);
+}
+
+const char* cs_intern_table_intern_n(CsInternTable* table, const void* str, size_t len, CsInternId* out_id) {
+    if (!table || !str || len == SIZE_MAX) return NULL;
+
+    uint64_t hash = cs_hash_wy(str, len);
+    CsInternId id;
+    size_t slot;
+    if (cs_intern_table_probe(table, hash, str, len, &id, &slot)) {
+        if (out_id) *out_id = id;
+        return table->strings[id].str;
+    }
+    if (table->size >= UINT32_MAX) return NULL;
+
+    // a grown index moves the empty slot found by the probe
+    if ((double)(table->size + 1) >= table->index_capacity * HASHMAP_MAX_LOAD_FACTOR) {
+        if (cs_intern_table_grow_index(table) != CS_SUCCESS) return NULL;
+        cs_intern_table_probe(table, hash, str, len, &id, &slot);
+    }
+    if (cs_intern_table_grow_strings(table) != CS_SUCCESS) return NULL;
+
+    char* copy = cs_intern_table_arena_alloc(table, len + 1);
+    if (!copy) return NULL;
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+
+    id = (CsInternId)table->size;
+    table->strings[id].str = copy;
+    table->strings[id].len = len;
+    table->strings[id].hash = hash;
+    table->index[slot] = (hash & INTERN_TAG_MASK) | (uint64_t)(id + 1);
+    table->size++;
+
+    if (out_id) *out_id = id;
+    return copy;
+}
+
+const char* cs_intern_table_find(const CsInternTable* table, const char* str, CsInternId* out_id) {
+    if (!table || !str) return NULL;
+
+    return cs_intern_table_find_n(table, str, strlen(str), out_id);
+}
+
+const char* cs_intern_table_find_n(const CsInternTable* table, const void* str, size_t len, CsInternId* out_id) {
+    if (!table || !str) return NULL;
+
+    CsInternId id;
+    if (!cs_intern_table_probe(table, cs_hash_wy(str, len), str, len, &id, NULL)) return NULL;
+    if (out_id) *out_id = id;
+    return table->strings[id].str;
+}
+
+const char* cs_intern_table_get(const CsInternTable* table, CsInternId id, size_t* out_len) {
+    if (!table || id >= table->size) return NULL;
+
+    if (out_len) *out_len = table->strings[id].len;
+    return table->strings[id].str;
+}
+
+size_t cs_intern_table_size(const CsInternTable* table) {
+    return table ? table->size : 0;
+}
+
+size_t cs_intern_table_memory(const CsInternTable* table) {
+    if (!table) return 0;
+
+    return sizeof(CsInternTable) + table->arena_bytes + table->strings_capacity * sizeof(CsInternString) +
+           table->index_capacity * sizeof(uint64_t) + table->chunk_capacity * sizeof(char*);
+}
@@ -0,0 +1,213 @@
+#include "cstash/lru_cache.h"
+#include "cstash/hashmap.h"
+#include "cstash/result.h"
+#include "hashmap_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline CsLruLinks* cs_lru_links(CsHashMapEntry* entry) {
+    return (CsLruLinks*)entry->data;
+}
+
+static inline void* cs_lru_value(CsHashMapEntry* entry) {
+    return entry->data + sizeof(CsLruLinks);
+}
+
+static void cs_lru_unlink(CsLruCache* cache, CsHashMapEntry* entry) {
+    CsLruLinks* links = cs_lru_links(entry);
+    if (links->prev) {
+        cs_lru_links(links->prev)->next = links->next;
+    } else {
+        cache->head = links->next;
+    }
+    if (links->next) {
+        cs_lru_links(links->next)->prev = links->prev;
+    } else {
+        cache->tail = links->prev;
+    }
+}
+
+static void cs_lru_push_front(CsLruCache* cache, CsHashMapEntry* entry) {
+    CsLruLinks* links = cs_lru_links(entry);
+    links->prev = NULL;
+    links->next = cache->head;
+    if (cache->head) {
+        cs_lru_links(cache->head)->prev = entry;
+    } else {
+        cache->tail = entry;
+    }
+    cache->head = entry;
+}
+
+// Unlink an entry from the list and the map, dropping its value
+static void cs_lru_drop(CsLruCache* cache, CsHashMapEntry* entry) {
+    cs_lru_unlink(cache, entry);
+    cache->bytes -= cs_lru_links(entry)->charge;
+    if (cache->options.destructor) cache->options.destructor(cs_lru_value(entry));
+    cs_hashmap_remove_hashed(cache->map, entry->hash, entry->key, entry->key_len);
+}
+
+static bool cs_lru_over_bounds(const CsLruCache* cache) {
+    if (cache->options.max_entries && cache->map->size > cache->options.max_entries) return true;
+    return cache->options.max_bytes && cache->bytes > cache->options.max_bytes;
+}
+
+// Called with the entry just put at the head: its charge alone fits, so it is never the one evicted
+static void cs_lru_evict(CsLruCache* cache) {
+    while (cs_lru_over_bounds(cache)) {
+        cs_lru_drop(cache, cache->tail);
+        cache->evictions++;
+    }
+}
+
+CsLruCache* cs_lru_cache_create(size_t value_size, const CsLruCacheOptions* options) {
+    if (value_size == 0 || value_size > SIZE_MAX - sizeof(CsLruLinks)) return NULL;
+    if (!options || (options->max_entries == 0 && options->max_bytes == 0)) return NULL;
+
+    CsLruCache* cache = malloc(sizeof(CsLruCache));
+    if (!cache) return NULL;
+
+    // an entry bound alone fixes the size: the map never resizes, one extra slot for the put before its eviction
+    size_t expected = 0;
+    if (options->max_bytes == 0 && options->max_entries < SIZE_MAX) expected = options->max_entries + 1;
+    cache->map = cs_hashmap_create_with_capacity(sizeof(CsLruLinks) + value_size, expected);
+    if (!cache->map) {
+        free(cache);
+        return NULL;
+    }
+
+    cache->head = NULL;
+    cache->tail = NULL;
+    cache->value_size = value_size;
+    cache->bytes = 0;
+    cache->options = *options;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    return cache;
+}
+
+void cs_lru_cache_destroy(CsLruCache* cache) {
+    if (!cache) return;
+
+    cs_lru_cache_clear(cache);
+    cs_hashmap_destroy(cache->map);
+    free(cache);
+}
+
+void* cs_lru_cache_get(CsLruCache* cache, const char* key) {
+    if (!cache || !key) return NULL;
+
+    return cs_lru_cache_get_n(cache, key, strlen(key));
+}
+
+void* cs_lru_cache_get_n(CsLruCache* cache, const void* key, size_t key_len) {
+    if (!cache || !key) return NULL;
+
+    CsHashMapEntry* entry = cs_hashmap_find(cache->map, cache->map->hash(key, key_len), key, key_len);
+    if (!entry) {
+        cache->misses++;
+        return NULL;
+    }
+
+    cache->hits++;
+    if (entry != cache->head) {
+        cs_lru_unlink(cache, entry);
+        cs_lru_push_front(cache, entry);
+    }
+    return cs_lru_value(entry);
+}
+
+void* cs_lru_cache_peek(const CsLruCache* cache, const char* key) {
+    if (!cache || !key) return NULL;
+
+    size_t key_len = strlen(key);
+    CsHashMapEntry* entry = cs_hashmap_find(cache->map, cache->map->hash(key, key_len), key, key_len);
+    return entry ? cs_lru_value(entry) : NULL;
+}
+
+CsResult cs_lru_cache_put(CsLruCache* cache, const char* key, const void* value) {
+    if (!cache || !key || !value) return CS_NULL_POINTER;
+
+    return cs_lru_cache_put_n(cache, key, strlen(key), value);
+}
+
+CsResult cs_lru_cache_put_n(CsLruCache* cache, const void* key, size_t key_len, const void* value) {
+    if (!cache || !key || !value) return CS_NULL_POINTER;
+
+    size_t charge = cache->options.charge ? cache->options.charge(key, key_len, value) : key_len + cache->value_size;
+    if (cache->options.max_bytes && charge > cache->options.max_bytes) return CS_OUT_OF_BOUNDS;
+
+    uint64_t hash = cache->map->hash(key, key_len);
+    CsHashMapEntry* entry = cs_hashmap_find(cache->map, hash, key, key_len);
+    bool same_value = false;
+    if (entry) {
+        // value may be the stored value itself (put of a get result): keep it as is
+        same_value = value == cs_lru_value(entry);
+        if (cache->options.destructor && !same_value) cache->options.destructor(cs_lru_value(entry));
+        cs_lru_unlink(cache, entry);
+        cache->bytes -= cs_lru_links(entry)->charge;
+    } else {
+        CsResult result = cs_hashmap_insert_hashed(cache->map, hash, key, key_len, NULL, &entry);
+        if (result != CS_SUCCESS) return result;
+    }
+
+    // insert before evicting: value may point into an entry about to be evicted
+    if (!same_value) memmove(cs_lru_value(entry), value, cache->value_size);
+    cs_lru_links(entry)->charge = charge;
+    cache->bytes += charge;
+    cs_lru_push_front(cache, entry);
+    cs_lru_evict(cache);
+    return CS_SUCCESS;
+}
+
+CsResult cs_lru_cache_remove(CsLruCache* cache, const char* key) {
+    if (!cache || !key) return CS_NULL_POINTER;
+
+    return cs_lru_cache_remove_n(cache, key, strlen(key));
+}
+
+CsResult cs_lru_cache_remove_n(CsLruCache* cache, const void* key, size_t key_len) {
+    if (!cache || !key) return CS_NULL_POINTER;
+
+    CsHashMapEntry* entry = cs_hashmap_find(cache->map, cache->map->hash(key, key_len), key, key_len);
+    if (!entry) return CS_NOT_FOUND;
+
+    cs_lru_drop(cache, entry);
+    return CS_SUCCESS;
+}
+
+void cs_lru_cache_clear(CsLruCache* cache) {
+    if (!cache) return;
+
+    if (cache->options.destructor) {
+        for (CsHashMapEntry* entry = cache->head; entry; entry = cs_lru_links(entry)->next) {
+            cache->options.destructor(cs_lru_value(entry));
+        }
+    }
+    cs_hashmap_clear(cache->map);
+    cache->head = NULL;
+    cache->tail = NULL;
+    cache->bytes = 0;
+}
+
+size_t cs_lru_cache_size(const CsLruCache* cache) {
+    return cache ? cache->map->size : 0;
+}
+
+double cs_lru_cache_hit_rate(const CsLruCache* cache) {
+    if (!cache || cache->hits + cache->misses == 0) return 0;
+
+    return (double)cache->hits / (double)(cache->hits + cache->misses);
+}
+
+void cs_lru_cache_reset_stats(CsLruCache* cache) {
+    if (!cache) return;
+
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+}
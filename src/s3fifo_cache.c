@@ -0,0 +1,312 @@
+#include "cstash/s3fifo_cache.h"
+#include "cstash/hashmap.h"
+#include "cstash/int_hashmap.h"
+#include "cstash/result.h"
+#include "hashmap_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define S3FIFO_SMALL 0
+#define S3FIFO_MAIN 1
+
+static inline CsS3FifoLinks* cs_s3fifo_links(CsHashMapEntry* entry) {
+    return (CsS3FifoLinks*)entry->data;
+}
+
+static inline void* cs_s3fifo_value(CsHashMapEntry* entry) {
+    return entry->data + sizeof(CsS3FifoLinks);
+}
+
+static inline CsS3FifoQueue* cs_s3fifo_queue_of(CsS3FifoCache* cache, CsHashMapEntry* entry) {
+    return cs_s3fifo_links(entry)->queue == S3FIFO_MAIN ? &cache->main : &cache->small;
+}
+
+// Saturating increment, racing threads may lose an increment but never write past S3FIFO_MAX_FREQ,
+// and a hot entry stops being written at all once it saturates
+static inline void cs_s3fifo_touch(CsHashMapEntry* entry) {
+    uint8_t* freq = &cs_s3fifo_links(entry)->freq;
+    uint8_t current = __atomic_load_n(freq, __ATOMIC_RELAXED);
+    if (current < S3FIFO_MAX_FREQ) __atomic_store_n(freq, (uint8_t)(current + 1), __ATOMIC_RELAXED);
+}
+
+static void cs_s3fifo_push(CsS3FifoQueue* queue, CsHashMapEntry* entry) {
+    CsS3FifoLinks* links = cs_s3fifo_links(entry);
+    links->older = queue->newest;
+    links->newer = NULL;
+    if (queue->newest) {
+        cs_s3fifo_links(queue->newest)->newer = entry;
+    } else {
+        queue->oldest = entry;
+    }
+    queue->newest = entry;
+    queue->size++;
+}
+
+static void cs_s3fifo_unlink(CsS3FifoQueue* queue, CsHashMapEntry* entry) {
+    CsS3FifoLinks* links = cs_s3fifo_links(entry);
+    if (links->older) {
+        cs_s3fifo_links(links->older)->newer = links->newer;
+    } else {
+        queue->oldest = links->newer;
+    }
+    if (links->newer) {
+        cs_s3fifo_links(links->newer)->older = links->older;
+    } else {
+        queue->newest = links->older;
+    }
+    queue->size--;
+}
+
+// Remove an entry already unlinked from its queue from the map, dropping its value
+static void cs_s3fifo_free(CsS3FifoCache* cache, CsHashMapEntry* entry) {
+    if (cache->options.destructor) cache->options.destructor(cs_s3fifo_value(entry));
+    cs_hashmap_remove_hashed(cache->map, entry->hash, entry->key, entry->key_len);
+}
+
+// Remember the hash of a key evicted from the small queue, forgetting the oldest ghost once the ring is full
+static void cs_s3fifo_ghost_push(CsS3FifoCache* cache, uint64_t hash) {
+    size_t slot = (size_t)(cache->ghost_count % cache->ghost_capacity);
+    if (cache->ghost_count >= cache->ghost_capacity) {
+        // the oldest hash may have been pushed again since, then its ghost is the newer one
+        uint64_t position;
+        if (cs_int_hashmap_take(cache->ghosts, cache->ghost_ring[slot], &position) == CS_SUCCESS &&
+            position != cache->ghost_count - cache->ghost_capacity) {
+            cs_int_hashmap_insert(cache->ghosts, cache->ghost_ring[slot], &position);
+        }
+    }
+    cache->ghost_ring[slot] = hash;
+    cs_int_hashmap_upsert(cache->ghosts, hash, &cache->ghost_count);
+    cache->ghost_count++;
+}
+
+// Evict from the small queue: entries accessed while there move to main, the first one that was not is dropped
+// and leaves a ghost. False if the small queue ran out of entries before dropping one
+static bool cs_s3fifo_evict_small(CsS3FifoCache* cache) {
+    while (cache->small.oldest) {
+        CsHashMapEntry* entry = cache->small.oldest;
+        CsS3FifoLinks* links = cs_s3fifo_links(entry);
+        cs_s3fifo_unlink(&cache->small, entry);
+        if (links->freq > 0) {
+            links->freq = 0;
+            links->queue = S3FIFO_MAIN;
+            cs_s3fifo_push(&cache->main, entry);
+            continue;
+        }
+
+        cs_s3fifo_ghost_push(cache, entry->hash);
+        cs_s3fifo_free(cache, entry);
+        return true;
+    }
+    return false;
+}
+
+// Evict from the main queue, a CLOCK: an accessed entry goes back to the newest end with one access less
+static void cs_s3fifo_evict_main(CsS3FifoCache* cache) {
+    for (;;) {
+        CsHashMapEntry* entry = cache->main.oldest;
+        CsS3FifoLinks* links = cs_s3fifo_links(entry);
+        cs_s3fifo_unlink(&cache->main, entry);
+        if (links->freq == 0) {
+            cs_s3fifo_free(cache, entry);
+            return;
+        }
+        links->freq--;
+        cs_s3fifo_push(&cache->main, entry);
+    }
+}
+
+static void cs_s3fifo_evict(CsS3FifoCache* cache) {
+    if (cache->small.size < cache->small_capacity || !cs_s3fifo_evict_small(cache)) cs_s3fifo_evict_main(cache);
+    cache->evictions++;
+}
+
+CsS3FifoCache* cs_s3fifo_cache_create(size_t value_size, const CsS3FifoCacheOptions* options) {
+    if (value_size == 0 || value_size > SIZE_MAX - sizeof(CsS3FifoLinks)) return NULL;
+    if (!options || options->max_entries == 0 || options->max_entries == SIZE_MAX) return NULL;
+
+    double fraction = options->small_fraction ? options->small_fraction : S3FIFO_SMALL_FRACTION;
+    if (fraction < 0 || fraction > 1) return NULL;
+    size_t small_capacity = (size_t)((double)options->max_entries * fraction);
+    if (small_capacity == 0) small_capacity = 1;
+    if (small_capacity > options->max_entries) small_capacity = options->max_entries;
+    size_t ghost_capacity = options->max_entries - small_capacity;
+    if (ghost_capacity == 0) ghost_capacity = 1;
+    if (ghost_capacity > SIZE_MAX / sizeof(uint64_t)) return NULL;
+
+    CsS3FifoCache* cache = malloc(sizeof(CsS3FifoCache));
+    if (!cache) return NULL;
+
+    // the size is fixed: neither the map nor the ghost index ever resizes, one extra slot for the put before its
+    // eviction
+    size_t entry_size = sizeof(CsS3FifoLinks) + value_size;
+    cache->map = cs_hashmap_create_with_capacity(entry_size, options->max_entries + 1);
+    cache->ghosts = cs_int_hashmap_create_with_capacity(sizeof(uint64_t), ghost_capacity);
+    cache->ghost_ring = malloc(ghost_capacity * sizeof(uint64_t));
+    if (!cache->map || !cache->ghosts || !cache->ghost_ring) {
+        cs_hashmap_destroy(cache->map);
+        cs_int_hashmap_destroy(cache->ghosts);
+        free(cache->ghost_ring);
+        free(cache);
+        return NULL;
+    }
+
+    memset(&cache->small, 0, sizeof(CsS3FifoQueue));
+    memset(&cache->main, 0, sizeof(CsS3FifoQueue));
+    cache->small_capacity = small_capacity;
+    cache->ghost_capacity = ghost_capacity;
+    cache->ghost_count = 0;
+    cache->value_size = value_size;
+    cache->options = *options;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    return cache;
+}
+
+void cs_s3fifo_cache_destroy(CsS3FifoCache* cache) {
+    if (!cache) return;
+
+    cs_s3fifo_cache_clear(cache);
+    cs_hashmap_destroy(cache->map);
+    cs_int_hashmap_destroy(cache->ghosts);
+    free(cache->ghost_ring);
+    free(cache);
+}
+
+void* cs_s3fifo_cache_get(CsS3FifoCache* cache, const char* key) {
+    if (!cache || !key) return NULL;
+
+    return cs_s3fifo_cache_get_n(cache, key, strlen(key));
+}
+
+void* cs_s3fifo_cache_get_n(CsS3FifoCache* cache, const void* key, size_t key_len) {
+    if (!cache || !key) return NULL;
+
+    void* value = cs_s3fifo_cache_lookup_n(cache, key, key_len);
+    if (value) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+    }
+    return value;
+}
+
+void* cs_s3fifo_cache_lookup(const CsS3FifoCache* cache, const char* key) {
+    if (!cache || !key) return NULL;
+
+    return cs_s3fifo_cache_lookup_n(cache, key, strlen(key));
+}
+
+void* cs_s3fifo_cache_lookup_n(const CsS3FifoCache* cache, const void* key, size_t key_len) {
+    if (!cache || !key) return NULL;
+
+    CsHashMapEntry* entry = cs_hashmap_find(cache->map, cache->map->hash(key, key_len), key, key_len);
+    if (!entry) return NULL;
+
+    cs_s3fifo_touch(entry);
+    return cs_s3fifo_value(entry);
+}
+
+bool cs_s3fifo_cache_contains(const CsS3FifoCache* cache, const char* key) {
+    if (!cache || !key) return false;
+
+    return cs_s3fifo_cache_contains_n(cache, key, strlen(key));
+}
+
+bool cs_s3fifo_cache_contains_n(const CsS3FifoCache* cache, const void* key, size_t key_len) {
+    if (!cache || !key) return false;
+
+    return cs_hashmap_has_n(cache->map, key, key_len);
+}
+
+CsResult cs_s3fifo_cache_put(CsS3FifoCache* cache, const char* key, const void* value) {
+    if (!cache || !key || !value) return CS_NULL_POINTER;
+
+    return cs_s3fifo_cache_put_n(cache, key, strlen(key), value);
+}
+
+CsResult cs_s3fifo_cache_put_n(CsS3FifoCache* cache, const void* key, size_t key_len, const void* value) {
+    if (!cache || !key || !value) return CS_NULL_POINTER;
+
+    uint64_t hash = cache->map->hash(key, key_len);
+    CsHashMapEntry* entry = cs_hashmap_find(cache->map, hash, key, key_len);
+    if (entry) {
+        // value may be the stored value itself (put of a get result): keep it as is
+        if (value != cs_s3fifo_value(entry)) {
+            if (cache->options.destructor) cache->options.destructor(cs_s3fifo_value(entry));
+            memmove(cs_s3fifo_value(entry), value, cache->value_size);
+        }
+        cs_s3fifo_touch(entry);
+        return CS_SUCCESS;
+    }
+
+    // insert before evicting: value may point into the entry about to be evicted
+    CsResult result = cs_hashmap_insert_hashed(cache->map, hash, key, key_len, NULL, &entry);
+    if (result != CS_SUCCESS) return result;
+    memcpy(cs_s3fifo_value(entry), value, cache->value_size);
+    if (cache->map->size > cache->options.max_entries) cs_s3fifo_evict(cache);
+
+    CsS3FifoLinks* links = cs_s3fifo_links(entry);
+    links->freq = 0;
+    links->queue = S3FIFO_SMALL;
+    // a key evicted from the small queue came back before its ghost was forgotten: it has reuse
+    if (cs_int_hashmap_remove(cache->ghosts, hash) == CS_SUCCESS) links->queue = S3FIFO_MAIN;
+    cs_s3fifo_push(cs_s3fifo_queue_of(cache, entry), entry);
+    return CS_SUCCESS;
+}
+
+CsResult cs_s3fifo_cache_remove(CsS3FifoCache* cache, const char* key) {
+    if (!cache || !key) return CS_NULL_POINTER;
+
+    return cs_s3fifo_cache_remove_n(cache, key, strlen(key));
+}
+
+CsResult cs_s3fifo_cache_remove_n(CsS3FifoCache* cache, const void* key, size_t key_len) {
+    if (!cache || !key) return CS_NULL_POINTER;
+
+    CsHashMapEntry* entry = cs_hashmap_find(cache->map, cache->map->hash(key, key_len), key, key_len);
+    if (!entry) return CS_NOT_FOUND;
+
+    cs_s3fifo_unlink(cs_s3fifo_queue_of(cache, entry), entry);
+    cs_s3fifo_free(cache, entry);
+    return CS_SUCCESS;
+}
+
+void cs_s3fifo_cache_clear(CsS3FifoCache* cache) {
+    if (!cache) return;
+
+    if (cache->options.destructor) {
+        CsS3FifoQueue* queues[] = {&cache->small, &cache->main};
+        for (size_t i = 0; i < 2; i++) {
+            for (CsHashMapEntry* entry = queues[i]->oldest; entry; entry = cs_s3fifo_links(entry)->newer) {
+                cache->options.destructor(cs_s3fifo_value(entry));
+            }
+        }
+    }
+    cs_hashmap_clear(cache->map);
+    cs_int_hashmap_clear(cache->ghosts);
+    memset(&cache->small, 0, sizeof(CsS3FifoQueue));
+    memset(&cache->main, 0, sizeof(CsS3FifoQueue));
+    cache->ghost_count = 0;
+}
+
+size_t cs_s3fifo_cache_size(const CsS3FifoCache* cache) {
+    return cache ? cache->map->size : 0;
+}
+
+double cs_s3fifo_cache_hit_rate(const CsS3FifoCache* cache) {
+    if (!cache || cache->hits + cache->misses == 0) return 0;
+
+    return (double)cache->hits / (double)(cache->hits + cache->misses);
+}
+
+void cs_s3fifo_cache_reset_stats(CsS3FifoCache* cache) {
+    if (!cache) return;
+
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+}
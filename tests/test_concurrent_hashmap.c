@@ -0,0 +1,361 @@
+// pthread_t n'est pas exposé en -std=c99 strict sans cela
+#define _POSIX_C_SOURCE 200112L
+
+#include "cstash/concurrent_hashmap.h"
+#include "test_framework.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define THREADS 4
+#define KEYS_PER_THREAD 2000
+
+// ========================================
+// Tests de création
+// ========================================
+
+void test_concurrent_hashmap_create(void) {
+    CsConcurrentHashMap* map = cs_concurrent_hashmap_create(sizeof(int));
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->shard_count, CONCURRENT_HASHMAP_DEFAULT_SHARDS);
+    ASSERT_EQ(map->value_size, sizeof(int));
+    ASSERT_TRUE(map->hash == cs_hash_wy);
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), 0);
+    cs_concurrent_hashmap_destroy(map);
+}
+
+void test_concurrent_hashmap_create_with_options(void) {
+    CsConcurrentHashMapOptions options = {.shards = 5, .map = {.engine = CS_HASHMAP_SWISS, .hash = cs_hash_fnv1a}};
+    CsConcurrentHashMap* map = cs_concurrent_hashmap_create_with_options(sizeof(int), &options);
+    ASSERT_NOT_NULL(map);
+    // Arrondi à la puissance de deux supérieure
+    ASSERT_EQ(map->shard_count, 8);
+    ASSERT_TRUE(map->hash == cs_hash_fnv1a);
+    cs_concurrent_hashmap_destroy(map);
+
+    ASSERT_NULL(cs_concurrent_hashmap_create(0));
+
+    // Les options invalides des shards font échouer la création
+    CsConcurrentHashMapOptions invalid = {.map = {.engine = CS_HASHMAP_SWISS, .incremental = true}};
+    ASSERT_NULL(cs_concurrent_hashmap_create_with_options(sizeof(int), &invalid));
+}
+
+// ========================================
+// Tests des opérations
+// ========================================
+
+void test_concurrent_hashmap_insert_get_remove(void) {
+    CsConcurrentHashMap* map = cs_concurrent_hashmap_create(sizeof(int));
+    int value = 0;
+
+    ASSERT_EQ(cs_concurrent_hashmap_insert(map, "a", &(int){1}), CS_SUCCESS);
+    ASSERT_EQ(cs_concurrent_hashmap_insert(map, "a", &(int){2}), CS_CONFLICT);
+    ASSERT_EQ(cs_concurrent_hashmap_get(map, "a", &value), CS_SUCCESS);
+    ASSERT_EQ(value, 1);
+    ASSERT_TRUE(cs_concurrent_hashmap_has(map, "a"));
+
+    ASSERT_EQ(cs_concurrent_hashmap_upsert(map, "a", &(int){3}), CS_SUCCESS);
+    ASSERT_EQ(cs_concurrent_hashmap_get(map, "a", &value), CS_SUCCESS);
+    ASSERT_EQ(value, 3);
+    ASSERT_EQ(cs_concurrent_hashmap_upsert_n(map, "b\0c", 3, &(int){4}), CS_SUCCESS);
+    ASSERT_EQ(cs_concurrent_hashmap_get_n(map, "b\0c", 3, &value), CS_SUCCESS);
+    ASSERT_EQ(value, 4);
+    ASSERT_FALSE(cs_concurrent_hashmap_has(map, "b"));
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), 2);
+
+    ASSERT_EQ(cs_concurrent_hashmap_remove(map, "a"), CS_SUCCESS);
+    ASSERT_EQ(cs_concurrent_hashmap_remove(map, "a"), CS_NOT_FOUND);
+    ASSERT_EQ(cs_concurrent_hashmap_get(map, "a", &value), CS_NOT_FOUND);
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), 1);
+
+    cs_concurrent_hashmap_clear(map);
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), 0);
+    ASSERT_FALSE(cs_concurrent_hashmap_has_n(map, "b\0c", 3));
+
+    cs_concurrent_hashmap_destroy(map);
+}
+
+void test_concurrent_hashmap_null(void) {
+    CsConcurrentHashMap* map = cs_concurrent_hashmap_create(sizeof(int));
+    int value = 0;
+
+    ASSERT_EQ(cs_concurrent_hashmap_insert(NULL, "a", &value), CS_NULL_POINTER);
+    ASSERT_EQ(cs_concurrent_hashmap_insert(map, NULL, &value), CS_NULL_POINTER);
+    ASSERT_EQ(cs_concurrent_hashmap_insert(map, "a", NULL), CS_NULL_POINTER);
+    ASSERT_EQ(cs_concurrent_hashmap_get(map, "a", NULL), CS_NULL_POINTER);
+    ASSERT_EQ(cs_concurrent_hashmap_upsert(map, NULL, &value), CS_NULL_POINTER);
+    ASSERT_EQ(cs_concurrent_hashmap_remove(NULL, "a"), CS_NULL_POINTER);
+    ASSERT_FALSE(cs_concurrent_hashmap_has(NULL, "a"));
+    ASSERT_EQ(cs_concurrent_hashmap_size(NULL), 0);
+    cs_concurrent_hashmap_clear(NULL);
+    cs_concurrent_hashmap_destroy(NULL);
+
+    cs_concurrent_hashmap_destroy(map);
+}
+
+static int destroyed_values = 0;
+
+static void free_owned(void* value) {
+    free(*(char**)value);
+    destroyed_values++;
+}
+
+void test_concurrent_hashmap_upsert_destructor(void) {
+    CsConcurrentHashMapOptions options = {.map = {.destructor = free_owned}};
+    CsConcurrentHashMap* map = cs_concurrent_hashmap_create_with_options(sizeof(char*), &options);
+    destroyed_values = 0;
+
+    // La réécriture libère l'ancienne valeur possédée par la map
+    char* first = malloc(8);
+    char* second = malloc(8);
+    ASSERT_EQ(cs_concurrent_hashmap_upsert(map, "a", &first), CS_SUCCESS);
+    ASSERT_EQ(destroyed_values, 0);
+    ASSERT_EQ(cs_concurrent_hashmap_upsert(map, "a", &second), CS_SUCCESS);
+    ASSERT_EQ(destroyed_values, 1);
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), 1);
+
+    cs_concurrent_hashmap_destroy(map);
+    ASSERT_EQ(destroyed_values, 2);
+}
+
+// ========================================
+// Tests multi-threads
+// ========================================
+
+typedef struct {
+    CsConcurrentHashMap* map;
+    int id;
+    int errors; // les ASSERT ne sont pas thread-safe, chaque thread compte ses erreurs
+} Worker;
+
+static void* insert_worker(void* arg) {
+    Worker* worker = arg;
+    for (int i = 0; i < KEYS_PER_THREAD; i++) {
+        char key[32];
+        int value = worker->id * KEYS_PER_THREAD + i;
+        snprintf(key, sizeof(key), "t%d_key%d", worker->id, i);
+        if (cs_concurrent_hashmap_insert(worker->map, key, &value) != CS_SUCCESS) worker->errors++;
+    }
+    return NULL;
+}
+
+void test_concurrent_hashmap_parallel_inserts(void) {
+    CsConcurrentHashMap* map = cs_concurrent_hashmap_create(sizeof(int));
+    pthread_t threads[THREADS];
+    Worker workers[THREADS];
+
+    for (int t = 0; t < THREADS; t++) {
+        workers[t] = (Worker){map, t, 0};
+        pthread_create(&threads[t], NULL, insert_worker, &workers[t]);
+    }
+    for (int t = 0; t < THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        ASSERT_EQ(workers[t].errors, 0);
+    }
+
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), THREADS * KEYS_PER_THREAD);
+    for (int t = 0; t < THREADS; t++) {
+        for (int i = 0; i < KEYS_PER_THREAD; i += 97) {
+            char key[32];
+            int value = -1;
+            snprintf(key, sizeof(key), "t%d_key%d", t, i);
+            ASSERT_EQ(cs_concurrent_hashmap_get(map, key, &value), CS_SUCCESS);
+            ASSERT_EQ(value, t * KEYS_PER_THREAD + i);
+        }
+    }
+
+    cs_concurrent_hashmap_destroy(map);
+}
+
+// Les lecteurs ne doivent jamais voir de valeur incohérente pendant que les écrivains réécrivent les clés
+static void* reader_worker(void* arg) {
+    Worker* worker = arg;
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 100; i++) {
+            char key[32];
+            int value[2];
+            snprintf(key, sizeof(key), "shared%d", i);
+            if (cs_concurrent_hashmap_get(worker->map, key, value) == CS_SUCCESS && value[0] != value[1]) {
+                worker->errors++;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void* writer_worker(void* arg) {
+    Worker* worker = arg;
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 100; i++) {
+            char key[32];
+            int value[2] = {round, round};
+            snprintf(key, sizeof(key), "shared%d", i);
+            if (i % 10 == worker->id) {
+                cs_concurrent_hashmap_remove(worker->map, key);
+            } else if (cs_concurrent_hashmap_upsert(worker->map, key, value) != CS_SUCCESS) {
+                worker->errors++;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void run_readers_and_writers(CsConcurrentHashMap* map) {
+    pthread_t threads[THREADS];
+    Worker workers[THREADS];
+
+    for (int t = 0; t < THREADS; t++) {
+        workers[t] = (Worker){map, t, 0};
+        pthread_create(&threads[t], NULL, t % 2 ? reader_worker : writer_worker, &workers[t]);
+    }
+    for (int t = 0; t < THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        ASSERT_EQ(workers[t].errors, 0);
+    }
+    ASSERT_TRUE(cs_concurrent_hashmap_size(map) <= 100);
+}
+
+void test_concurrent_hashmap_readers_and_writers(void) {
+    CsConcurrentHashMapOptions options = {.shards = 4};
+    CsConcurrentHashMap* map = cs_concurrent_hashmap_create_with_options(2 * sizeof(int), &options);
+    run_readers_and_writers(map);
+    cs_concurrent_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests du mode lecture sans verrou
+// ========================================
+
+static CsConcurrentHashMap* create_lock_free_map(size_t value_size, size_t shards) {
+    CsConcurrentHashMapOptions options = {.shards = shards, .lock_free_reads = true};
+    return cs_concurrent_hashmap_create_with_options(value_size, &options);
+}
+
+void test_concurrent_hashmap_lock_free_create(void) {
+    CsConcurrentHashMap* map = create_lock_free_map(sizeof(int), 0);
+    ASSERT_NOT_NULL(map);
+    ASSERT_TRUE(map->lock_free_reads);
+    ASSERT_NOT_NULL(map->epoch);
+    cs_concurrent_hashmap_destroy(map);
+
+    // Seul le moteur chaîné sans resize incrémental est supporté
+    CsConcurrentHashMapOptions swiss = {.lock_free_reads = true, .map = {.engine = CS_HASHMAP_SWISS}};
+    ASSERT_NULL(cs_concurrent_hashmap_create_with_options(sizeof(int), &swiss));
+    CsConcurrentHashMapOptions robin_hood = {.lock_free_reads = true, .map = {.engine = CS_HASHMAP_ROBIN_HOOD}};
+    ASSERT_NULL(cs_concurrent_hashmap_create_with_options(sizeof(int), &robin_hood));
+    CsConcurrentHashMapOptions cuckoo = {.lock_free_reads = true, .map = {.engine = CS_HASHMAP_CUCKOO}};
+    ASSERT_NULL(cs_concurrent_hashmap_create_with_options(sizeof(int), &cuckoo));
+    CsConcurrentHashMapOptions incremental = {.lock_free_reads = true, .map = {.incremental = true}};
+    ASSERT_NULL(cs_concurrent_hashmap_create_with_options(sizeof(int), &incremental));
+
+    // Les entrées retirées sont libérées plus tard par l'epoch, sans destructeur
+    CsConcurrentHashMapOptions destructor = {.lock_free_reads = true, .map = {.destructor = free}};
+    ASSERT_NULL(cs_concurrent_hashmap_create_with_options(sizeof(char*), &destructor));
+}
+
+void test_concurrent_hashmap_lock_free_operations(void) {
+    // Un seul shard : les resize copient toute la table
+    CsConcurrentHashMap* map = create_lock_free_map(sizeof(int), 1);
+    int value = 0;
+
+    for (int i = 0; i < 1000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(cs_concurrent_hashmap_insert(map, key, &i), CS_SUCCESS);
+    }
+    ASSERT_EQ(cs_concurrent_hashmap_insert(map, "key5", &value), CS_CONFLICT);
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), 1000);
+
+    for (int i = 0; i < 1000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(cs_concurrent_hashmap_get(map, key, &value), CS_SUCCESS);
+        ASSERT_EQ(value, i);
+    }
+
+    ASSERT_EQ(cs_concurrent_hashmap_upsert(map, "key5", &(int){-5}), CS_SUCCESS);
+    ASSERT_EQ(cs_concurrent_hashmap_get(map, "key5", &value), CS_SUCCESS);
+    ASSERT_EQ(value, -5);
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), 1000);
+
+    ASSERT_EQ(cs_concurrent_hashmap_remove(map, "key5"), CS_SUCCESS);
+    ASSERT_EQ(cs_concurrent_hashmap_remove(map, "key5"), CS_NOT_FOUND);
+    ASSERT_FALSE(cs_concurrent_hashmap_has(map, "key5"));
+    ASSERT_TRUE(cs_concurrent_hashmap_has(map, "key6"));
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), 999);
+
+    cs_concurrent_hashmap_clear(map);
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), 0);
+    ASSERT_EQ(cs_concurrent_hashmap_get(map, "key6", &value), CS_NOT_FOUND);
+    ASSERT_EQ(cs_concurrent_hashmap_insert(map, "key6", &value), CS_SUCCESS);
+
+    cs_concurrent_hashmap_destroy(map);
+}
+
+void test_concurrent_hashmap_lock_free_readers_and_writers(void) {
+    // Sous AddressSanitizer, une entrée libérée trop tôt serait détectée par les lecteurs
+    CsConcurrentHashMap* map = create_lock_free_map(2 * sizeof(int), 2);
+    run_readers_and_writers(map);
+    cs_concurrent_hashmap_destroy(map);
+}
+
+void test_concurrent_hashmap_lock_free_parallel_inserts(void) {
+    CsConcurrentHashMap* map = create_lock_free_map(sizeof(int), 4);
+    pthread_t threads[THREADS];
+    Worker workers[THREADS];
+
+    for (int t = 0; t < THREADS; t++) {
+        workers[t] = (Worker){map, t, 0};
+        pthread_create(&threads[t], NULL, insert_worker, &workers[t]);
+    }
+    for (int t = 0; t < THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        ASSERT_EQ(workers[t].errors, 0);
+    }
+    ASSERT_EQ(cs_concurrent_hashmap_size(map), THREADS * KEYS_PER_THREAD);
+
+    // Les threads terminés libèrent leur slot de lecteur, réutilisé par les suivants
+    for (int t = 0; t < THREADS; t++) {
+        workers[t] = (Worker){map, t, 0};
+        pthread_create(&threads[t], NULL, reader_worker, &workers[t]);
+    }
+    for (int t = 0; t < THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        ASSERT_EQ(workers[t].errors, 0);
+    }
+
+    cs_concurrent_hashmap_destroy(map);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## CONCURRENT HASHMAP TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== CREATION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_concurrent_hashmap_create);
+    RUN_TEST(test_concurrent_hashmap_create_with_options);
+
+    printf("\n" COLOR_BLUE "========== OPERATIONS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_concurrent_hashmap_insert_get_remove);
+    RUN_TEST(test_concurrent_hashmap_null);
+    RUN_TEST(test_concurrent_hashmap_upsert_destructor);
+
+    printf("\n" COLOR_BLUE "========== MULTI-THREADS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_concurrent_hashmap_parallel_inserts);
+    RUN_TEST(test_concurrent_hashmap_readers_and_writers);
+
+    printf("\n" COLOR_BLUE "========== LOCK-FREE READS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_concurrent_hashmap_lock_free_create);
+    RUN_TEST(test_concurrent_hashmap_lock_free_operations);
+    RUN_TEST(test_concurrent_hashmap_lock_free_readers_and_writers);
+    RUN_TEST(test_concurrent_hashmap_lock_free_parallel_inserts);
+
+    TEST_SUMMARY();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,360 @@
+#include "cstash/frozen_hashmap.h"
+#include "test_framework.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MANY_KEYS 10000
+
+static CsHashMap* create_filled_map(size_t count) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    for (size_t i = 0; i < count; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "key_%zu", i);
+        int value = (int)i;
+        cs_hashmap_insert(map, key, &value);
+    }
+    return map;
+}
+
+// ========================================
+// Tests de construction
+// ========================================
+
+void test_frozen_hashmap_freeze(void) {
+    CsHashMap* map = create_filled_map(100);
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    ASSERT_NOT_NULL(frozen);
+    ASSERT_EQ(frozen->size, 100);
+    ASSERT_EQ(frozen->value_size, sizeof(int));
+    ASSERT_TRUE(frozen->hash == map->hash);
+
+    // La map source reste utilisable et indépendante
+    ASSERT_EQ(map->size, 100);
+    cs_hashmap_destroy(map);
+
+    const int* value = cs_frozen_hashmap_get(frozen, "key_42");
+    ASSERT_NOT_NULL(value);
+    ASSERT_EQ(*value, 42);
+
+    cs_frozen_hashmap_destroy(frozen);
+}
+
+void test_frozen_hashmap_freeze_empty(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    ASSERT_NOT_NULL(frozen);
+    ASSERT_EQ(frozen->size, 0);
+    ASSERT_NULL(cs_frozen_hashmap_get(frozen, "key"));
+    ASSERT_FALSE(cs_frozen_hashmap_has_n(frozen, "", 0));
+
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+}
+
+void test_frozen_hashmap_freeze_after_remove(void) {
+    CsHashMap* map = create_filled_map(50);
+    for (size_t i = 0; i < 50; i += 2) {
+        char key[32];
+        snprintf(key, sizeof(key), "key_%zu", i);
+        cs_hashmap_remove(map, key);
+    }
+
+    // Les trous laissés par les suppressions ne sont pas figés
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    ASSERT_NOT_NULL(frozen);
+    ASSERT_EQ(frozen->size, 25);
+    ASSERT_FALSE(cs_frozen_hashmap_has(frozen, "key_0"));
+    ASSERT_TRUE(cs_frozen_hashmap_has(frozen, "key_1"));
+
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+}
+
+static uint64_t constant_hash(const void* key, size_t key_len) {
+    (void)key;
+    (void)key_len;
+    return 7;
+}
+
+void test_frozen_hashmap_freeze_failures(void) {
+    ASSERT_NULL(cs_hashmap_freeze(NULL));
+
+    // Deux clés de même hash 64 bits ne peuvent pas recevoir deux slots distincts
+    CsHashMapOptions options = {.hash = constant_hash};
+    CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+    cs_hashmap_insert(map, "a", &(int){1});
+    cs_hashmap_insert(map, "b", &(int){2});
+    ASSERT_NULL(cs_hashmap_freeze(map));
+
+    // Une seule clé ne pose pas de problème
+    cs_hashmap_remove(map, "b");
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    ASSERT_NOT_NULL(frozen);
+    ASSERT_EQ(*(const int*)cs_frozen_hashmap_get(frozen, "a"), 1);
+    ASSERT_NULL(cs_frozen_hashmap_get(frozen, "b"));
+
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests de recherche
+// ========================================
+
+void test_frozen_hashmap_get_all(void) {
+    CsHashMap* map = create_filled_map(MANY_KEYS);
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    ASSERT_NOT_NULL(frozen);
+    ASSERT_EQ(frozen->size, MANY_KEYS);
+
+    // Chaque clé trouve sa propre valeur, alignée sur 16 octets comme dans un CsHashMap
+    size_t found = 0;
+    size_t aligned = 0;
+    for (size_t i = 0; i < MANY_KEYS; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "key_%zu", i);
+        const int* value = cs_frozen_hashmap_get(frozen, key);
+        if (value && *value == (int)i) found++;
+        if ((uintptr_t)value % 16 == 0) aligned++;
+    }
+    ASSERT_EQ(found, MANY_KEYS);
+    ASSERT_EQ(aligned, MANY_KEYS);
+
+    // Les clés absentes tombent sur un slot occupé mais sont rejetées
+    size_t misses = 0;
+    for (size_t i = 0; i < MANY_KEYS; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "missing_%zu", i);
+        if (!cs_frozen_hashmap_has(frozen, key)) misses++;
+    }
+    ASSERT_EQ(misses, MANY_KEYS);
+
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+}
+
+void test_frozen_hashmap_binary_keys(void) {
+    CsHashMapOptions options = {.engine = CS_HASHMAP_SWISS};
+    CsHashMap* map = cs_hashmap_create_with_options(sizeof(double), &options);
+    cs_hashmap_insert_n(map, "a\0b", 3, &(double){1.5});
+    cs_hashmap_insert_n(map, "a\0c", 3, &(double){2.5});
+    cs_hashmap_insert_n(map, "", 0, &(double){3.5});
+
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    ASSERT_NOT_NULL(frozen);
+    ASSERT_TRUE(*(const double*)cs_frozen_hashmap_get_n(frozen, "a\0b", 3) == 1.5);
+    ASSERT_TRUE(*(const double*)cs_frozen_hashmap_get_n(frozen, "a\0c", 3) == 2.5);
+    ASSERT_TRUE(*(const double*)cs_frozen_hashmap_get(frozen, "") == 3.5);
+    ASSERT_NULL(cs_frozen_hashmap_get(frozen, "a"));
+    ASSERT_NULL(cs_frozen_hashmap_get_n(frozen, "a\0b", 2));
+
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+}
+
+void test_frozen_hashmap_null(void) {
+    CsHashMap* map = create_filled_map(10);
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+
+    ASSERT_NULL(cs_frozen_hashmap_get(NULL, "key_1"));
+    ASSERT_NULL(cs_frozen_hashmap_get(frozen, NULL));
+    ASSERT_NULL(cs_frozen_hashmap_get_n(frozen, NULL, 3));
+    ASSERT_FALSE(cs_frozen_hashmap_has(NULL, "key_1"));
+    cs_frozen_hashmap_destroy(NULL);
+
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests mémoire
+// ========================================
+
+void test_frozen_hashmap_blob_size(void) {
+    CsHashMap* map = create_filled_map(MANY_KEYS);
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+
+    // Par clé : 4 / FROZEN_HASHMAP_BUCKET_SIZE octets de pilote, 8 d'offset et un enregistrement de
+    // 16 octets + valeur + clé, arrondi à 16. Les clés "key_N" font au plus 8 octets
+    size_t per_key = 1 + 8 + 16 + 8 + 16;
+    ASSERT_TRUE(frozen->blob_size <= 64 + MANY_KEYS * per_key);
+
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests des fichiers
+// ========================================
+
+#define FROZEN_FILE "test_frozen_hashmap.tmp"
+
+void test_frozen_hashmap_save_open(void) {
+    CsHashMap* map = create_filled_map(MANY_KEYS);
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    ASSERT_EQ(cs_frozen_hashmap_save(frozen, FROZEN_FILE), CS_SUCCESS);
+
+    CsFrozenHashMap* opened = cs_frozen_hashmap_open(FROZEN_FILE, NULL);
+    ASSERT_NOT_NULL(opened);
+    ASSERT_TRUE(opened->mapped);
+    ASSERT_EQ(opened->size, MANY_KEYS);
+    ASSERT_EQ(opened->value_size, sizeof(int));
+    ASSERT_EQ(opened->blob_size, frozen->blob_size);
+
+    // Le fichier projeté répond exactement comme la map d'origine
+    size_t found = 0;
+    for (size_t i = 0; i < MANY_KEYS; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "key_%zu", i);
+        const int* value = cs_frozen_hashmap_get(opened, key);
+        if (value && *value == (int)i) found++;
+    }
+    ASSERT_EQ(found, MANY_KEYS);
+    ASSERT_FALSE(cs_frozen_hashmap_has(opened, "missing"));
+
+    cs_frozen_hashmap_destroy(opened);
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+    remove(FROZEN_FILE);
+}
+
+void test_frozen_hashmap_save_open_empty(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    ASSERT_EQ(cs_frozen_hashmap_save(frozen, FROZEN_FILE), CS_SUCCESS);
+
+    CsFrozenHashMap* opened = cs_frozen_hashmap_open(FROZEN_FILE, NULL);
+    ASSERT_NOT_NULL(opened);
+    ASSERT_EQ(opened->size, 0);
+    ASSERT_NULL(cs_frozen_hashmap_get(opened, "key"));
+
+    cs_frozen_hashmap_destroy(opened);
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+    remove(FROZEN_FILE);
+}
+
+void test_frozen_hashmap_open_hash_mismatch(void) {
+    CsHashMapOptions options = {.hash = cs_hash_fnv1a};
+    CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+    cs_hashmap_insert(map, "a", &(int){1});
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    ASSERT_EQ(cs_frozen_hashmap_save(frozen, FROZEN_FILE), CS_SUCCESS);
+
+    // Une autre fonction de hash enverrait les clés dans de mauvais slots
+    ASSERT_NULL(cs_frozen_hashmap_open(FROZEN_FILE, NULL));
+    ASSERT_NULL(cs_frozen_hashmap_open(FROZEN_FILE, cs_hash_crc32c));
+
+    CsFrozenHashMap* opened = cs_frozen_hashmap_open(FROZEN_FILE, cs_hash_fnv1a);
+    ASSERT_NOT_NULL(opened);
+    ASSERT_EQ(*(const int*)cs_frozen_hashmap_get(opened, "a"), 1);
+
+    cs_frozen_hashmap_destroy(opened);
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+    remove(FROZEN_FILE);
+}
+
+void test_frozen_hashmap_open_invalid(void) {
+    ASSERT_NULL(cs_frozen_hashmap_open(NULL, NULL));
+    ASSERT_NULL(cs_frozen_hashmap_open("does_not_exist.tmp", NULL));
+
+    // Fichier qui n'est pas une map figée
+    FILE* file = fopen(FROZEN_FILE, "wb");
+    for (int i = 0; i < 256; i++) fputc(i, file);
+    fclose(file);
+    ASSERT_NULL(cs_frozen_hashmap_open(FROZEN_FILE, NULL));
+
+    // Fichier tronqué : l'en-tête est valide mais la taille ne correspond plus
+    CsHashMap* map = create_filled_map(100);
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+    file = fopen(FROZEN_FILE, "wb");
+    fwrite(frozen->blob, 1, frozen->blob_size - 8, file);
+    fclose(file);
+    ASSERT_NULL(cs_frozen_hashmap_open(FROZEN_FILE, NULL));
+
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+    remove(FROZEN_FILE);
+}
+
+void test_frozen_hashmap_open_corrupt_records(void) {
+    CsHashMap* map = create_filled_map(100);
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+
+    // En-tête intact, offsets pointant hors des enregistrements : open accepte, get ne doit pas lire hors du blob
+    char* blob = malloc(frozen->blob_size);
+    memcpy(blob, frozen->blob, frozen->blob_size);
+    uint64_t* offsets = (uint64_t*)(blob + ((const char*)frozen->offsets - (const char*)frozen->blob));
+    for (size_t i = 0; i < frozen->size; i++) offsets[i] |= (1ULL << 48) - 1;
+    FILE* file = fopen(FROZEN_FILE, "wb");
+    fwrite(blob, 1, frozen->blob_size, file);
+    fclose(file);
+    free(blob);
+
+    CsFrozenHashMap* corrupt = cs_frozen_hashmap_open(FROZEN_FILE, NULL);
+    ASSERT_NOT_NULL(corrupt);
+    size_t found = 0;
+    for (size_t i = 0; i < 100; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "key_%zu", i);
+        if (cs_frozen_hashmap_get(corrupt, key)) found++;
+    }
+    ASSERT_EQ(found, 0);
+
+    cs_frozen_hashmap_destroy(corrupt);
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+    remove(FROZEN_FILE);
+}
+
+void test_frozen_hashmap_save_errors(void) {
+    CsHashMap* map = create_filled_map(10);
+    CsFrozenHashMap* frozen = cs_hashmap_freeze(map);
+
+    ASSERT_EQ(cs_frozen_hashmap_save(NULL, FROZEN_FILE), CS_NULL_POINTER);
+    ASSERT_EQ(cs_frozen_hashmap_save(frozen, NULL), CS_NULL_POINTER);
+    ASSERT_EQ(cs_frozen_hashmap_save(frozen, "does_not_exist/frozen.tmp"), CS_IO_ERROR);
+
+    cs_frozen_hashmap_destroy(frozen);
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## FROZEN HASHMAP TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== CONSTRUCTION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_frozen_hashmap_freeze);
+    RUN_TEST(test_frozen_hashmap_freeze_empty);
+    RUN_TEST(test_frozen_hashmap_freeze_after_remove);
+    RUN_TEST(test_frozen_hashmap_freeze_failures);
+
+    printf("\n" COLOR_BLUE "========== LOOKUP ==========" COLOR_RESET "\n");
+    RUN_TEST(test_frozen_hashmap_get_all);
+    RUN_TEST(test_frozen_hashmap_binary_keys);
+    RUN_TEST(test_frozen_hashmap_null);
+
+    printf("\n" COLOR_BLUE "========== MEMORY ==========" COLOR_RESET "\n");
+    RUN_TEST(test_frozen_hashmap_blob_size);
+
+
+    printf("\n" COLOR_BLUE "========== FILES ==========" COLOR_RESET "\n");
+    RUN_TEST(test_frozen_hashmap_save_open);
+    RUN_TEST(test_frozen_hashmap_save_open_empty);
+    RUN_TEST(test_frozen_hashmap_open_hash_mismatch);
+    RUN_TEST(test_frozen_hashmap_open_invalid);
+    RUN_TEST(test_frozen_hashmap_open_corrupt_records);
+    RUN_TEST(test_frozen_hashmap_save_errors);
+
+    TEST_SUMMARY();
+
+    return tests_failed > 0 ? 1 : 0;
+}
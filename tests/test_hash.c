@@ -0,0 +1,155 @@
+#include "cstash/hash.h"
+#include "test_framework.h"
+#include <string.h>
+
+// ========================================
+// Tests de FNV-1a
+// ========================================
+
+void test_hash_fnv1a_known_values(void) {
+    ASSERT_TRUE(cs_hash_fnv1a("", 0) == 0xcbf29ce484222325ULL);
+    ASSERT_TRUE(cs_hash_fnv1a("a", 1) == 0xaf63dc4c8601ec8cULL);
+    ASSERT_TRUE(cs_hash_fnv1a("foobar", 6) == 0x85944171f73967e8ULL);
+}
+
+// ========================================
+// Tests de wyhash
+// ========================================
+
+void test_hash_wy_deterministic(void) {
+    const char* key = "the quick brown fox jumps over the lazy dog";
+    size_t len = strlen(key);
+
+    ASSERT_TRUE(cs_hash_wy(key, len) == cs_hash_wy(key, len));
+    ASSERT_TRUE(cs_hash_wy(key, len) != cs_hash_wy(key, len - 1));
+    ASSERT_TRUE(cs_hash_wy("", 0) != cs_hash_wy("\0", 1));
+}
+
+void test_hash_wy_all_lengths_distinct(void) {
+    // Chaque longueur de 0 à 128 passe par une branche différente (<4, <=16, <=48, >48)
+    char buffer[128];
+    memset(buffer, 'x', sizeof(buffer));
+
+    uint64_t hashes[129];
+    for (size_t len = 0; len <= sizeof(buffer); len++) {
+        hashes[len] = cs_hash_wy(buffer, len);
+    }
+
+    int collisions = 0;
+    for (size_t i = 0; i <= sizeof(buffer); i++) {
+        for (size_t j = i + 1; j <= sizeof(buffer); j++) {
+            if (hashes[i] == hashes[j]) collisions++;
+        }
+    }
+    ASSERT_EQ(collisions, 0);
+}
+
+void test_hash_wy_single_bit_change(void) {
+    char a[40];
+    char b[40];
+    memset(a, 0, sizeof(a));
+    memcpy(b, a, sizeof(b));
+    b[37] ^= 1;
+
+    uint64_t diff = cs_hash_wy(a, sizeof(a)) ^ cs_hash_wy(b, sizeof(b));
+    int bits = 0;
+    while (diff) {
+        bits += (int)(diff & 1);
+        diff >>= 1;
+    }
+    // Avalanche : environ la moitié des bits doivent changer
+    ASSERT_TRUE(bits > 16 && bits < 48);
+}
+
+// ========================================
+// Tests du mélangeur d'entiers
+// ========================================
+
+void test_hash_u64_bijective_on_sequence(void) {
+    // Des IDs consécutifs donnent des hash distincts et dispersés sur les bits hauts
+    uint64_t high_bits_seen = 0;
+    for (uint64_t i = 0; i < 64; i++) {
+        uint64_t hash = cs_hash_u64(i);
+        high_bits_seen |= 1ULL << (hash >> 58);
+        for (uint64_t j = 0; j < i; j++) {
+            if (cs_hash_u64(j) == hash) high_bits_seen = 0;
+        }
+    }
+    ASSERT_TRUE(__builtin_popcountll(high_bits_seen) > 32);
+    ASSERT_TRUE(cs_hash_u64(0) == 0);
+}
+
+void test_hash_u64_single_bit_change(void) {
+    uint64_t diff = cs_hash_u64(0x123456789ULL) ^ cs_hash_u64(0x123456789ULL ^ (1ULL << 40));
+    int bits = 0;
+    while (diff) {
+        bits += (int)(diff & 1);
+        diff >>= 1;
+    }
+    // Avalanche : environ la moitié des bits doivent changer
+    ASSERT_TRUE(bits > 16 && bits < 48);
+}
+
+// ========================================
+// Tests de CRC32C
+// ========================================
+
+void test_crc32c_known_values(void) {
+    printf("  crc32c hardware: %s\n", cs_crc32c_is_hardware() ? "yes" : "no");
+    ASSERT_TRUE(cs_crc32c("123456789", 9) == 0xE3069283u);
+    ASSERT_TRUE(cs_crc32c("", 0) == 0u);
+
+    unsigned char zeros[32] = {0};
+    ASSERT_TRUE(cs_crc32c(zeros, sizeof(zeros)) == 0x8A9136AAu);
+}
+
+void test_crc32c_unaligned_tails(void) {
+    // Toutes les longueurs et décalages doivent suivre le même chemin logique
+    const char* text = "Cstash CRC32C unaligned tail handling test vector";
+    size_t len = strlen(text);
+    uint32_t reference = cs_crc32c(text, len);
+
+    char shifted[64];
+    memcpy(shifted + 3, text, len);
+    ASSERT_TRUE(cs_crc32c(shifted + 3, len) == reference);
+}
+
+void test_hash_crc32c_spreads_bits(void) {
+    uint64_t h1 = cs_hash_crc32c("key1", 4);
+    uint64_t h2 = cs_hash_crc32c("key2", 4);
+
+    ASSERT_TRUE(h1 != h2);
+    ASSERT_TRUE((h1 >> 32) != 0);
+    ASSERT_TRUE(cs_hash_crc32c("", 0) != cs_hash_crc32c("\0", 1));
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## HASH TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== FNV-1A ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hash_fnv1a_known_values);
+
+    printf("\n" COLOR_BLUE "========== WYHASH ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hash_wy_deterministic);
+    RUN_TEST(test_hash_wy_all_lengths_distinct);
+    RUN_TEST(test_hash_wy_single_bit_change);
+
+    printf("\n" COLOR_BLUE "========== INTEGER MIXER ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hash_u64_bijective_on_sequence);
+    RUN_TEST(test_hash_u64_single_bit_change);
+
+    printf("\n" COLOR_BLUE "========== CRC32C ==========" COLOR_RESET "\n");
+    RUN_TEST(test_crc32c_known_values);
+    RUN_TEST(test_crc32c_unaligned_tails);
+    RUN_TEST(test_hash_crc32c_spreads_bits);
+
+    TEST_SUMMARY();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -50,6 +50,36 @@ void test_hashmap_destroy_null(void) {
     cs_hashmap_destroy(NULL);
 }
 
+void test_hashmap_create_with_capacity(void) {
+    CsHashMap* map = cs_hashmap_create_with_capacity(sizeof(int), 1000);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->size, 0);
+
+    // 1000 / 0.75 arrondi à la puissance de deux supérieure, et le tableau d'ordre déjà alloué
+    ASSERT_EQ(map->capacity, 2048);
+    ASSERT_TRUE(map->order_capacity >= 1000);
+
+    // Aucun redimensionnement pendant les insertions prévues
+    size_t order_capacity = map->order_capacity;
+    for (int i = 0; i < 1000; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+    ASSERT_EQ(map->capacity, 2048);
+    ASSERT_EQ(map->order_capacity, order_capacity);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key999"), 999);
+    cs_hashmap_destroy(map);
+
+    // Sans indication, la capacité par défaut
+    map = cs_hashmap_create_with_capacity(sizeof(int), 0);
+    ASSERT_EQ(map->capacity, HASHMAP_DEFAULT_CAPACITY);
+    cs_hashmap_destroy(map);
+
+    ASSERT_NULL(cs_hashmap_create_with_capacity(0, 100));
+    ASSERT_NULL(cs_hashmap_create_with_capacity(sizeof(int), SIZE_MAX));
+}
+
 // ========================================
 // Tests de insert
 // ========================================
@@ -427,6 +457,20 @@ void test_hashmap_resize_same_capacity(void) {
     cs_hashmap_destroy(map);
 }
 
+void test_hashmap_resize_too_large(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    cs_hashmap_insert(map, "key", &(int){1});
+    size_t capacity = map->capacity;
+
+    // Une capacité non représentable échoue sans toucher à la map
+    ASSERT_EQ(cs_hashmap_resize(map, SIZE_MAX), CS_ALLOCATION_FAILED);
+    ASSERT_EQ(cs_hashmap_resize(map, SIZE_MAX / 2 + 2), CS_ALLOCATION_FAILED);
+    ASSERT_EQ(map->capacity, capacity);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key"), 1);
+
+    cs_hashmap_destroy(map);
+}
+
 void test_hashmap_resize_null_hashmap(void) {
     CsResult result = cs_hashmap_resize(NULL, 16);
     ASSERT_EQ(result, CS_NULL_POINTER);
@@ -642,71 +686,1638 @@ void test_hashmap_overwrite_protection(void) {
 }
 
 // ========================================
-// Main
+// Tests du moteur swiss
 // ========================================
 
-int main(void) {
-    TEST_INIT();
+static CsHashMap* create_swiss_map(size_t value_size) {
+    CsHashMapOptions options = {.engine = CS_HASHMAP_SWISS};
+    return cs_hashmap_create_with_options(value_size, &options);
+}
 
-    printf("\n" COLOR_MAGENTA "########## HASHMAP TESTS ##########" COLOR_RESET "\n");
+void test_hashmap_swiss_create(void) {
+    CsHashMap* map = create_swiss_map(sizeof(int));
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->engine, CS_HASHMAP_SWISS);
+    ASSERT_EQ(map->size, 0);
+    ASSERT_EQ(map->capacity, HASHMAP_SWISS_GROUP_WIDTH);
+    ASSERT_NOT_NULL(map->ctrl);
+    cs_hashmap_destroy(map);
+}
 
-    printf("\n" COLOR_BLUE "========== CREATION & DESTRUCTION ==========" COLOR_RESET "\n");
-    RUN_TEST(test_hashmap_create_destroy);
-    RUN_TEST(test_hashmap_create_with_zero_size);
-    RUN_TEST(test_hashmap_create_with_different_types);
-    RUN_TEST(test_hashmap_destroy_null);
+void test_hashmap_create_with_invalid_engine(void) {
+    CsHashMapOptions options = {.engine = (CsHashMapEngine)42};
+    CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+    ASSERT_NULL(map);
+}
 
-    printf("\n" COLOR_BLUE "========== INSERT ==========" COLOR_RESET "\n");
-    RUN_TEST(test_hashmap_insert_single);
-    RUN_TEST(test_hashmap_insert_multiple);
-    RUN_TEST(test_hashmap_insert_duplicate_key);
-    RUN_TEST(test_hashmap_insert_null_hashmap);
-    RUN_TEST(test_hashmap_insert_null_key);
-    RUN_TEST(test_hashmap_insert_null_value);
-    RUN_TEST(test_hashmap_insert_with_auto_resize);
+void test_hashmap_swiss_insert_get_remove(void) {
+    CsHashMap* map = create_swiss_map(sizeof(int));
 
-    printf("\n" COLOR_BLUE "========== GET & HAS ==========" COLOR_RESET "\n");
-    RUN_TEST(test_hashmap_get_existing_key);
-    RUN_TEST(test_hashmap_get_non_existing_key);
-    RUN_TEST(test_hashmap_get_null_hashmap);
-    RUN_TEST(test_hashmap_get_null_key);
-    RUN_TEST(test_hashmap_has_existing_key);
-    RUN_TEST(test_hashmap_has_non_existing_key);
-    RUN_TEST(test_hashmap_has_null_hashmap);
-    RUN_TEST(test_hashmap_has_null_key);
+    for (int i = 0; i < 1000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(cs_hashmap_insert(map, key, &i), CS_SUCCESS);
+    }
+    ASSERT_EQ(map->size, 1000);
+    ASSERT_EQ(cs_hashmap_insert(map, "key10", &(int){0}), CS_CONFLICT);
 
-    printf("\n" COLOR_BLUE "========== REMOVE ==========" COLOR_RESET "\n");
-    RUN_TEST(test_hashmap_remove_existing_key);
-    RUN_TEST(test_hashmap_remove_non_existing_key);
-    RUN_TEST(test_hashmap_remove_from_bucket_chain);
-    RUN_TEST(test_hashmap_remove_null_hashmap);
-    RUN_TEST(test_hashmap_remove_null_key);
+    // La capacité reste une puissance de deux
+    ASSERT_EQ(map->capacity & (map->capacity - 1), 0);
 
-    printf("\n" COLOR_BLUE "========== CLEAR ==========" COLOR_RESET "\n");
-    RUN_TEST(test_hashmap_clear_empty);
-    RUN_TEST(test_hashmap_clear_with_data);
-    RUN_TEST(test_hashmap_clear_null);
+    for (int i = 0; i < 1000; i += 2) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(cs_hashmap_remove(map, key), CS_SUCCESS);
+    }
+    ASSERT_EQ(map->size, 500);
+    ASSERT_EQ(cs_hashmap_remove(map, "key0"), CS_NOT_FOUND);
 
-    printf("\n" COLOR_BLUE "========== RESIZE ==========" COLOR_RESET "\n");
-    RUN_TEST(test_hashmap_resize_increase);
-    RUN_TEST(test_hashmap_resize_decrease);
-    RUN_TEST(test_hashmap_resize_same_capacity);
-    RUN_TEST(test_hashmap_resize_null_hashmap);
+    for (int i = 0; i < 1000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        int* value = (int*)cs_hashmap_get(map, key);
+        if (i % 2 == 0) {
+            ASSERT_NULL(value);
+        } else {
+            ASSERT_NOT_NULL(value);
+            ASSERT_EQ(*value, i);
+        }
+    }
 
-    printf("\n" COLOR_BLUE "========== COMPLEX TYPES ==========" COLOR_RESET "\n");
-    RUN_TEST(test_hashmap_with_structs);
-    RUN_TEST(test_hashmap_with_string_values);
+    cs_hashmap_destroy(map);
+}
 
-    printf("\n" COLOR_BLUE "========== COLLISIONS ==========" COLOR_RESET "\n");
-    RUN_TEST(test_hashmap_collision_handling);
+void test_hashmap_swiss_tombstone_reuse(void) {
+    CsHashMap* map = create_swiss_map(sizeof(int));
 
-    printf("\n" COLOR_BLUE "========== STRESS TESTS ==========" COLOR_RESET "\n");
-    RUN_TEST(test_hashmap_large_dataset);
-    RUN_TEST(test_hashmap_insert_remove_cycle);
-    RUN_TEST(test_hashmap_key_variations);
-    RUN_TEST(test_hashmap_empty_string_key);
-    RUN_TEST(test_hashmap_long_key);
-    RUN_TEST(test_hashmap_overwrite_protection);
+    // Beaucoup de cycles insertion/suppression ne doivent pas faire grossir la table
+    for (int cycle = 0; cycle < 10000; cycle++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", cycle);
+        cs_hashmap_insert(map, key, &cycle);
+        cs_hashmap_remove(map, key);
+    }
+
+    ASSERT_EQ(map->size, 0);
+    ASSERT_EQ(map->capacity, HASHMAP_SWISS_GROUP_WIDTH);
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_swiss_resize_and_clear(void) {
+    CsHashMap* map = create_swiss_map(sizeof(int));
+
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+
+    // Trop petit pour 100 entrées : arrondi à la capacité minimale utilisable
+    ASSERT_EQ(cs_hashmap_resize(map, 16), CS_SUCCESS);
+    ASSERT_TRUE(map->capacity >= 128);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key42"), 42);
+
+    ASSERT_EQ(cs_hashmap_resize(map, 1000), CS_SUCCESS);
+    ASSERT_EQ(map->capacity, 1024);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key99"), 99);
+
+    // Une capacité non représentable échoue sans toucher à la map
+    ASSERT_EQ(cs_hashmap_resize(map, SIZE_MAX), CS_ALLOCATION_FAILED);
+    ASSERT_EQ(map->capacity, 1024);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key99"), 99);
+
+    cs_hashmap_clear(map);
+    ASSERT_EQ(map->size, 0);
+    ASSERT_FALSE(cs_hashmap_has(map, "key42"));
+    ASSERT_EQ(cs_hashmap_insert(map, "key42", &(int){1}), CS_SUCCESS);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests du hash mis en cache
+// ========================================
+
+void test_hashmap_entries_cache_hash(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+
+    // Après plusieurs resize, chaque entrée est dans le bucket donné par son hash en cache
+    size_t misplaced = 0;
+    size_t visited = 0;
+    for (size_t i = 0; i < map->capacity; i++) {
+        for (CsHashMapEntry* entry = map->buckets[i]; entry; entry = entry->next) {
+            // index de Fibonacci : bits de poids fort de hash * 2^64/phi
+            if ((size_t)((entry->hash * 0x9E3779B97F4A7C15ULL) >> map->shift) != i) misplaced++;
+            visited++;
+        }
+    }
+    ASSERT_EQ(visited, 100);
+    ASSERT_EQ(misplaced, 0);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests des clés binaires (_n)
+// ========================================
+
+void test_hashmap_binary_keys(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    const unsigned char id1[] = {0x00, 0x01, 0x02, 0x03};
+    const unsigned char id2[] = {0x00, 0x01, 0x02, 0x04};
+    int v1 = 1, v2 = 2;
+
+    ASSERT_EQ(cs_hashmap_insert_n(map, id1, sizeof(id1), &v1), CS_SUCCESS);
+    ASSERT_EQ(cs_hashmap_insert_n(map, id2, sizeof(id2), &v2), CS_SUCCESS);
+    ASSERT_EQ(cs_hashmap_insert_n(map, id1, sizeof(id1), &v2), CS_CONFLICT);
+    ASSERT_EQ(map->size, 2);
+
+    ASSERT_EQ(*(int*)cs_hashmap_get_n(map, id1, sizeof(id1)), 1);
+    ASSERT_EQ(*(int*)cs_hashmap_get_n(map, id2, sizeof(id2)), 2);
+    ASSERT_TRUE(cs_hashmap_has_n(map, id1, sizeof(id1)));
+    ASSERT_FALSE(cs_hashmap_has_n(map, id1, 3));
+
+    // Une clé commençant par un NUL n'est pas la clé vide
+    ASSERT_NULL(cs_hashmap_get(map, ""));
+
+    ASSERT_EQ(cs_hashmap_remove_n(map, id1, sizeof(id1)), CS_SUCCESS);
+    ASSERT_EQ(cs_hashmap_remove_n(map, id1, sizeof(id1)), CS_NOT_FOUND);
+    ASSERT_EQ(map->size, 1);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_key_slices(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    const char buffer[] = "GET /index.html HTTP/1.1";
+    int value = 7;
+
+    // Tranche non terminée d'un buffer, compatible avec l'API chaîne
+    ASSERT_EQ(cs_hashmap_insert_n(map, buffer + 4, 11, &value), CS_SUCCESS);
+    ASSERT_NOT_NULL(cs_hashmap_get(map, "/index.html"));
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "/index.html"), 7);
+
+    // "ab" et "ab\0" sont deux clés distinctes
+    int a = 1, b = 2;
+    ASSERT_EQ(cs_hashmap_insert_n(map, "ab", 2, &a), CS_SUCCESS);
+    ASSERT_EQ(cs_hashmap_insert_n(map, "ab", 3, &b), CS_SUCCESS);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "ab"), 1);
+    ASSERT_EQ(*(int*)cs_hashmap_get_n(map, "ab", 3), 2);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_binary_keys_swiss(void) {
+    CsHashMap* map = create_swiss_map(sizeof(int));
+
+    for (int i = 0; i < 500; i++) {
+        ASSERT_EQ(cs_hashmap_insert_n(map, &i, sizeof(i), &i), CS_SUCCESS);
+    }
+    for (int i = 0; i < 500; i++) {
+        int* value = (int*)cs_hashmap_get_n(map, &i, sizeof(i));
+        ASSERT_NOT_NULL(value);
+        ASSERT_EQ(*value, i);
+    }
+    int missing = 500;
+    ASSERT_NULL(cs_hashmap_get_n(map, &missing, sizeof(missing)));
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_binary_keys_null(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    int value = 1;
+
+    ASSERT_EQ(cs_hashmap_insert_n(map, NULL, 0, &value), CS_NULL_POINTER);
+    ASSERT_EQ(cs_hashmap_insert_n(NULL, "a", 1, &value), CS_NULL_POINTER);
+    ASSERT_NULL(cs_hashmap_get_n(map, NULL, 0));
+    ASSERT_FALSE(cs_hashmap_has_n(NULL, "a", 1));
+    ASSERT_EQ(cs_hashmap_remove_n(map, NULL, 0), CS_NULL_POINTER);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests des fonctions de hash
+// ========================================
+
+static uint64_t constant_hash(const void* key, size_t key_len) {
+    (void)key;
+    (void)key_len;
+    return 42;
+}
+
+void test_hashmap_default_hash(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    ASSERT_TRUE(map->hash == cs_hash_wy);
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_custom_hash(void) {
+    CsHashFunction functions[] = {cs_hash_fnv1a, cs_hash_crc32c, constant_hash};
+    // Le moteur cuckoo ne loge que 2 * HASHMAP_CUCKOO_BUCKET_SIZE clés de même hash, voir ses propres tests
+    CsHashMapEngine engines[] = {CS_HASHMAP_CHAINED, CS_HASHMAP_SWISS, CS_HASHMAP_ROBIN_HOOD};
+
+    for (size_t f = 0; f < 3; f++) {
+        for (size_t e = 0; e < 3; e++) {
+            CsHashMapOptions options = {.engine = engines[e], .hash = functions[f]};
+            CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+            ASSERT_TRUE(map->hash == functions[f]);
+
+            // Même un hash constant (toutes les clés en collision) reste correct
+            for (int i = 0; i < 100; i++) {
+                char key[16];
+                snprintf(key, sizeof(key), "key%d", i);
+                cs_hashmap_insert(map, key, &i);
+            }
+            int found = 0;
+            for (int i = 0; i < 100; i++) {
+                char key[16];
+                snprintf(key, sizeof(key), "key%d", i);
+                int* value = (int*)cs_hashmap_get(map, key);
+                if (value && *value == i) found++;
+            }
+            ASSERT_EQ(found, 100);
+            ASSERT_EQ(cs_hashmap_remove(map, "key50"), CS_SUCCESS);
+            ASSERT_FALSE(cs_hashmap_has(map, "key50"));
+
+            cs_hashmap_destroy(map);
+        }
+    }
+}
+
+// ========================================
+// Tests des capacités en puissance de deux
+// ========================================
+
+// Hash faible : seuls les bits de poids fort varient, un simple masque mettrait tout dans le bucket 0
+static uint64_t high_bits_hash(const void* key, size_t key_len) {
+    uint32_t id = 0;
+    memcpy(&id, key, key_len < sizeof(id) ? key_len : sizeof(id));
+    return (uint64_t)id << 40;
+}
+
+void test_hashmap_capacity_power_of_two(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+
+    ASSERT_EQ(cs_hashmap_resize(map, 1000), CS_SUCCESS);
+    ASSERT_EQ(map->capacity, 1024);
+    ASSERT_EQ(map->shift, 54);
+
+    ASSERT_EQ(cs_hashmap_resize(map, 3), CS_SUCCESS);
+    ASSERT_EQ(map->capacity, 4);
+
+    ASSERT_EQ(cs_hashmap_resize(map, 1), CS_SUCCESS);
+    ASSERT_EQ(map->capacity, 2);
+
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+    ASSERT_EQ(map->capacity & (map->capacity - 1), 0);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key77"), 77);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_weak_hash_distribution(void) {
+    CsHashMapOptions options = {.hash = high_bits_hash};
+    CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+
+    for (uint32_t i = 0; i < 512; i++) {
+        cs_hashmap_insert_n(map, &i, sizeof(i), &i);
+    }
+
+    size_t longest_chain = 0;
+    for (size_t i = 0; i < map->capacity; i++) {
+        size_t length = 0;
+        for (CsHashMapEntry* entry = map->buckets[i]; entry; entry = entry->next) length++;
+        if (length > longest_chain) longest_chain = length;
+    }
+    ASSERT_TRUE(longest_chain <= 4);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests du resize incrémental
+// ========================================
+
+static CsHashMap* create_incremental_map(size_t value_size) {
+    CsHashMapOptions options = {.incremental = true};
+    return cs_hashmap_create_with_options(value_size, &options);
+}
+
+void test_hashmap_incremental_rejects_swiss(void) {
+    CsHashMapOptions options = {.engine = CS_HASHMAP_SWISS, .incremental = true};
+    ASSERT_NULL(cs_hashmap_create_with_options(sizeof(int), &options));
+}
+
+void test_hashmap_incremental_insert_get(void) {
+    CsHashMap* map = create_incremental_map(sizeof(int));
+    ASSERT_TRUE(map->incremental);
+
+    bool saw_migration = false;
+    int missing = 0;
+    for (int i = 0; i < 5000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(cs_hashmap_insert(map, key, &i), CS_SUCCESS);
+        if (map->old_buckets) saw_migration = true;
+
+        // Toutes les clés restent visibles pendant la migration
+        if (i % 97 == 0) {
+            for (int j = 0; j <= i; j++) {
+                snprintf(key, sizeof(key), "key%d", j);
+                int* value = (int*)cs_hashmap_get(map, key);
+                if (!value || *value != j) missing++;
+            }
+        }
+    }
+    ASSERT_TRUE(saw_migration);
+    ASSERT_EQ(missing, 0);
+    ASSERT_EQ(map->size, 5000);
+    ASSERT_EQ(cs_hashmap_insert(map, "key1234", &(int){0}), CS_CONFLICT);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_incremental_remove_during_migration(void) {
+    CsHashMap* map = create_incremental_map(sizeof(int));
+
+    int i = 0;
+    char key[16];
+    // Insérer jusqu'au déclenchement d'une migration
+    while (!map->old_buckets || map->capacity < 64) {
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+        i++;
+    }
+    int inserted = i;
+
+    // Les suppressions trouvent les clés dans l'ancien comme dans le nouveau tableau
+    for (int j = 0; j < inserted; j += 2) {
+        snprintf(key, sizeof(key), "key%d", j);
+        ASSERT_EQ(cs_hashmap_remove(map, key), CS_SUCCESS);
+    }
+    ASSERT_EQ(map->size, (size_t)(inserted / 2));
+    ASSERT_NULL(map->old_buckets);
+
+    for (int j = 0; j < inserted; j++) {
+        snprintf(key, sizeof(key), "key%d", j);
+        ASSERT_EQ(cs_hashmap_has(map, key), j % 2 == 1);
+    }
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_incremental_resize_and_clear(void) {
+    CsHashMap* map = create_incremental_map(sizeof(int));
+
+    int i = 0;
+    char key[16];
+    while (!map->old_buckets) {
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+        i++;
+    }
+
+    // Un resize explicite termine la migration
+    ASSERT_EQ(cs_hashmap_resize(map, 256), CS_SUCCESS);
+    ASSERT_NULL(map->old_buckets);
+    ASSERT_EQ(map->capacity, 256);
+    for (int j = 0; j < i; j++) {
+        snprintf(key, sizeof(key), "key%d", j);
+        ASSERT_TRUE(cs_hashmap_has(map, key));
+    }
+
+    while (!map->old_buckets) {
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+        i++;
+    }
+
+    // clear libère aussi les entrées pas encore migrées
+    cs_hashmap_clear(map);
+    ASSERT_EQ(map->size, 0);
+    ASSERT_NULL(map->old_buckets);
+    ASSERT_FALSE(cs_hashmap_has(map, "key0"));
+
+    // destroy en cours de migration ne fuit pas
+    while (!map->old_buckets) {
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+        i++;
+    }
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_clear_after_removing_all(void) {
+    CsHashMap* map = create_incremental_map(sizeof(int));
+
+    int count = 0;
+    char key[16];
+    while (!map->old_buckets) {
+        snprintf(key, sizeof(key), "key%d", count);
+        cs_hashmap_insert(map, key, &count);
+        count++;
+    }
+    for (int i = 0; i < count; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_remove(map, key);
+    }
+    ASSERT_EQ(map->size, 0);
+    ASSERT_TRUE(map->order_len > 0);
+
+    // Une map vidée par des suppressions garde des trous dans l'ordre : clear les efface aussi
+    cs_hashmap_clear(map);
+    ASSERT_EQ(map->order_len, 0);
+    ASSERT_NULL(map->old_buckets);
+    CsHashMapIter iter = cs_hashmap_iter_begin(map);
+    ASSERT_FALSE(cs_hashmap_iter_next(&iter, NULL, NULL, NULL));
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests de la disposition des entrées
+// ========================================
+
+void test_hashmap_entry_single_allocation(void) {
+    typedef struct {
+        double x;
+        double y;
+    } Point;
+
+    CsHashMap* map = cs_hashmap_create(sizeof(Point));
+    Point p = {1.5, -2.5};
+    cs_hashmap_insert(map, "point", &p);
+
+    CsHashMapEntry* entry = NULL;
+    for (size_t i = 0; i < map->capacity && !entry; i++) entry = map->buckets[i];
+    ASSERT_NOT_NULL(entry);
+
+    // La clé est stockée juste après la valeur, dans la même allocation
+    ASSERT_TRUE(entry->key == entry->data + sizeof(Point));
+    ASSERT_STR_EQ(entry->key, "point");
+    ASSERT_EQ(entry->key_len, 5);
+    ASSERT_EQ((uintptr_t)entry->data % sizeof(double), 0);
+
+    Point* stored = (Point*)cs_hashmap_get(map, "point");
+    ASSERT_TRUE(stored->x == 1.5 && stored->y == -2.5);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests des lookups par lot
+// ========================================
+
+// Interroge les clés key0..key{2n-1} : seules les clés paires sont présentes
+static void check_batch(CsHashMap* map, int n) {
+    char keys[200][16];
+    const char* key_ptrs[200];
+    void* values[200];
+
+    for (int i = 0; i < 2 * n; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+        key_ptrs[i] = keys[i];
+    }
+
+    ASSERT_EQ(cs_hashmap_get_batch(map, key_ptrs, (size_t)(2 * n), values), (size_t)n);
+    for (int i = 0; i < 2 * n; i++) {
+        if (i % 2 == 0) {
+            ASSERT_NOT_NULL(values[i]);
+            ASSERT_EQ(*(int*)values[i], i);
+            ASSERT_EQ(values[i], cs_hashmap_get(map, keys[i]));
+        } else {
+            ASSERT_NULL(values[i]);
+        }
+    }
+}
+
+static void fill_even_keys(CsHashMap* map, int n) {
+    for (int i = 0; i < 2 * n; i += 2) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+}
+
+void test_hashmap_get_batch(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    fill_even_keys(map, 100);
+    // 200 clés : plusieurs lots complets et un lot partiel
+    check_batch(map, 100);
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_get_batch_swiss(void) {
+    CsHashMap* map = create_swiss_map(sizeof(int));
+    fill_even_keys(map, 100);
+    check_batch(map, 100);
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_get_batch_during_migration(void) {
+    CsHashMap* map = create_incremental_map(sizeof(int));
+    fill_even_keys(map, 100);
+    ASSERT_NOT_NULL(map->old_buckets);
+    check_batch(map, 100);
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_get_batch_edge_cases(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    fill_even_keys(map, 4);
+
+    const char* keys[3] = {"key0", NULL, "key2"};
+    void* values[3] = {NULL, (void*)keys, NULL};
+
+    // Une clé NULL donne une valeur NULL sans interrompre le lot
+    ASSERT_EQ(cs_hashmap_get_batch(map, keys, 3, values), 2);
+    ASSERT_NOT_NULL(values[0]);
+    ASSERT_NULL(values[1]);
+    ASSERT_NOT_NULL(values[2]);
+
+    ASSERT_EQ(cs_hashmap_get_batch(map, keys, 0, values), 0);
+    ASSERT_EQ(cs_hashmap_get_batch(NULL, keys, 3, values), 0);
+    ASSERT_EQ(cs_hashmap_get_batch(map, NULL, 3, values), 0);
+    ASSERT_EQ(cs_hashmap_get_batch(map, keys, 3, NULL), 0);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests de get_or_insert / upsert
+// ========================================
+
+void test_hashmap_get_or_insert(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    bool inserted = false;
+
+    int* value = cs_hashmap_get_or_insert(map, "a", &(int){7}, &inserted);
+    ASSERT_NOT_NULL(value);
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(*value, 7);
+    ASSERT_EQ(map->size, 1);
+
+    // Clé existante : la valeur par défaut est ignorée et le même slot est renvoyé
+    int* again = cs_hashmap_get_or_insert(map, "a", &(int){99}, &inserted);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(again, value);
+    ASSERT_EQ(*again, 7);
+    ASSERT_EQ(map->size, 1);
+
+    // inserted est optionnel
+    ASSERT_NOT_NULL(cs_hashmap_get_or_insert(map, "b", &(int){1}, NULL));
+    ASSERT_EQ(map->size, 2);
+
+    cs_hashmap_destroy(map);
+}
+
+static void count_words(CsHashMap* map) {
+    const char* words[] = {"le", "chat", "le", "chien", "le", "chat"};
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        // valeur par défaut NULL : compteur initialisé à zéro
+        int* count = cs_hashmap_get_or_insert(map, words[i], NULL, NULL);
+        (*count)++;
+    }
+    ASSERT_EQ(map->size, 3);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "le"), 3);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "chat"), 2);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "chien"), 1);
+}
+
+void test_hashmap_get_or_insert_counter(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    count_words(map);
+    cs_hashmap_destroy(map);
+
+    map = create_swiss_map(sizeof(int));
+    count_words(map);
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_get_or_insert_across_resize(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    int* first = cs_hashmap_get_or_insert(map, "first", &(int){1}, NULL);
+
+    for (int i = 0; i < 1000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_get_or_insert(map, key, &i, NULL);
+    }
+
+    // Les entrées ne bougent pas lors des resize, le pointeur reste valide
+    ASSERT_EQ(cs_hashmap_get(map, "first"), first);
+    ASSERT_EQ(*first, 1);
+    ASSERT_EQ(map->size, 1001);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_upsert(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+
+    int* value = cs_hashmap_upsert(map, "a", &(int){1});
+    ASSERT_NOT_NULL(value);
+    ASSERT_EQ(*value, 1);
+
+    // Contrairement à insert, upsert écrase la valeur existante
+    ASSERT_EQ(cs_hashmap_upsert(map, "a", &(int){2}), value);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "a"), 2);
+    ASSERT_EQ(map->size, 1);
+
+    ASSERT_NOT_NULL(cs_hashmap_upsert_n(map, "b\0c", 3, &(int){3}));
+    ASSERT_EQ(*(int*)cs_hashmap_get_n(map, "b\0c", 3), 3);
+    ASSERT_FALSE(cs_hashmap_has(map, "b"));
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_upsert_null(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    bool inserted = true;
+
+    ASSERT_NULL(cs_hashmap_upsert(NULL, "a", &(int){1}));
+    ASSERT_NULL(cs_hashmap_upsert(map, NULL, &(int){1}));
+    ASSERT_NULL(cs_hashmap_upsert(map, "a", NULL));
+    ASSERT_NULL(cs_hashmap_get_or_insert(NULL, "a", NULL, &inserted));
+    ASSERT_FALSE(inserted);
+    ASSERT_NULL(cs_hashmap_get_or_insert(map, NULL, NULL, NULL));
+    ASSERT_EQ(map->size, 0);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests de l'itération
+// ========================================
+
+static void check_insertion_order(CsHashMap* map) {
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+
+    // L'ordre d'insertion est conservé malgré les resize
+    CsHashMapIter iter = cs_hashmap_iter_begin(map);
+    const char* key;
+    size_t key_len;
+    void* value;
+    int expected = 0;
+    while (cs_hashmap_iter_next(&iter, &key, &key_len, &value)) {
+        char expected_key[16];
+        snprintf(expected_key, sizeof(expected_key), "key%d", expected);
+        ASSERT_STR_EQ(key, expected_key);
+        ASSERT_EQ(key_len, strlen(expected_key));
+        ASSERT_EQ(*(int*)value, expected);
+        expected++;
+    }
+    ASSERT_EQ(expected, 100);
+    ASSERT_FALSE(cs_hashmap_iter_next(&iter, &key, &key_len, &value));
+}
+
+void test_hashmap_iter_insertion_order(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    check_insertion_order(map);
+    cs_hashmap_destroy(map);
+
+    map = create_swiss_map(sizeof(int));
+    check_insertion_order(map);
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_iter_empty(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    CsHashMapIter iter = cs_hashmap_iter_begin(map);
+    ASSERT_FALSE(cs_hashmap_iter_next(&iter, NULL, NULL, NULL));
+
+    cs_hashmap_insert(map, "a", &(int){1});
+    cs_hashmap_clear(map);
+    iter = cs_hashmap_iter_begin(map);
+    ASSERT_FALSE(cs_hashmap_iter_next(&iter, NULL, NULL, NULL));
+
+    ASSERT_FALSE(cs_hashmap_iter_next(NULL, NULL, NULL, NULL));
+    iter = cs_hashmap_iter_begin(NULL);
+    ASSERT_FALSE(cs_hashmap_iter_next(&iter, NULL, NULL, NULL));
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_iter_remove_while_iterating(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    for (int i = 0; i < 50; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+
+    // Supprimer l'entrée courante ne perturbe pas l'itérateur
+    CsHashMapIter iter = cs_hashmap_iter_begin(map);
+    const char* key;
+    void* value;
+    int visited = 0;
+    while (cs_hashmap_iter_next(&iter, &key, NULL, &value)) {
+        visited++;
+        if (*(int*)value % 2 == 0) ASSERT_EQ(cs_hashmap_remove(map, key), CS_SUCCESS);
+    }
+    ASSERT_EQ(visited, 50);
+    ASSERT_EQ(map->size, 25);
+
+    iter = cs_hashmap_iter_begin(map);
+    visited = 0;
+    while (cs_hashmap_iter_next(&iter, NULL, NULL, &value)) {
+        ASSERT_EQ(*(int*)value % 2, 1);
+        visited++;
+    }
+    ASSERT_EQ(visited, 25);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_iter_order_after_compaction(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    for (int i = 0; i < 64; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+    for (int i = 0; i < 48; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_remove(map, key);
+    }
+
+    // Le tableau plein et troué est compacté au lieu d'être agrandi
+    size_t order_capacity = map->order_capacity;
+    ASSERT_EQ(map->order_len, order_capacity);
+    cs_hashmap_insert(map, "last", &(int){64});
+    ASSERT_EQ(map->order_capacity, order_capacity);
+    ASSERT_EQ(map->order_len, 17);
+
+    CsHashMapIter iter = cs_hashmap_iter_begin(map);
+    void* value;
+    int expected = 48;
+    while (cs_hashmap_iter_next(&iter, NULL, NULL, &value)) {
+        ASSERT_EQ(*(int*)value, expected);
+        expected++;
+    }
+    ASSERT_EQ(expected, 65);
+
+    // Les suppressions après compaction visent toujours la bonne position
+    ASSERT_EQ(cs_hashmap_remove(map, "key50"), CS_SUCCESS);
+    ASSERT_EQ(cs_hashmap_remove(map, "last"), CS_SUCCESS);
+    ASSERT_EQ(cs_hashmap_for_each(map, NULL, NULL), 0);
+
+    cs_hashmap_destroy(map);
+}
+
+static bool sum_visitor(const char* key, size_t key_len, void* value, void* user_data) {
+    (void)key;
+    (void)key_len;
+    *(int*)user_data += *(int*)value;
+    return true;
+}
+
+static bool stop_at_three(const char* key, size_t key_len, void* value, void* user_data) {
+    (void)key;
+    (void)key_len;
+    (void)user_data;
+    return *(int*)value != 3;
+}
+
+void test_hashmap_for_each(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    for (int i = 1; i <= 10; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+    cs_hashmap_remove(map, "key10");
+
+    int sum = 0;
+    ASSERT_EQ(cs_hashmap_for_each(map, sum_visitor, &sum), 9);
+    ASSERT_EQ(sum, 45);
+
+    // Le visiteur peut interrompre le parcours
+    ASSERT_EQ(cs_hashmap_for_each(map, stop_at_three, NULL), 3);
+
+    ASSERT_EQ(cs_hashmap_for_each(NULL, sum_visitor, &sum), 0);
+    ASSERT_EQ(cs_hashmap_for_each(map, NULL, NULL), 0);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests d'insertion en masse
+// ========================================
+
+#define BULK_KEYS 20000
+
+static char bulk_key_storage[BULK_KEYS][32];
+static const char* bulk_keys[BULK_KEYS];
+static int bulk_values[BULK_KEYS];
+
+static void bulk_fill(size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        snprintf(bulk_key_storage[i], sizeof(bulk_key_storage[i]), "key%zu", i);
+        bulk_keys[i] = bulk_key_storage[i];
+        bulk_values[i] = (int)i;
+    }
+}
+
+void test_hashmap_create_from(void) {
+    bulk_fill(1000);
+    CsHashMap* map = cs_hashmap_create_from(sizeof(int), bulk_keys, bulk_values, 1000);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->size, 1000);
+
+    // Dimensionnée une seule fois : 1000 / 0.75 arrondi à la puissance de deux supérieure
+    ASSERT_EQ(map->capacity, 2048);
+
+    size_t found = 0;
+    for (size_t i = 0; i < 1000; i++) {
+        int* value = cs_hashmap_get(map, bulk_keys[i]);
+        if (value && *value == (int)i) found++;
+    }
+    ASSERT_EQ(found, 1000);
+
+    // L'ordre d'insertion est celui du tableau
+    CsHashMapIter iter = cs_hashmap_iter_begin(map);
+    void* value;
+    int expected = 0;
+    while (cs_hashmap_iter_next(&iter, NULL, NULL, &value)) {
+        if (*(int*)value != expected) break;
+        expected++;
+    }
+    ASSERT_EQ(expected, 1000);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_create_from_duplicates(void) {
+    const char* keys[] = {"a", "b", "a"};
+    int values[] = {1, 2, 3};
+
+    // La première occurrence l'emporte, comme avec cs_hashmap_insert
+    CsHashMap* map = cs_hashmap_create_from(sizeof(int), keys, values, 3);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->size, 2);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "a"), 1);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "b"), 2);
+    cs_hashmap_destroy(map);
+
+    map = cs_hashmap_create_from(sizeof(int), NULL, NULL, 0);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->size, 0);
+    cs_hashmap_destroy(map);
+
+    ASSERT_NULL(cs_hashmap_create_from(0, keys, values, 3));
+    ASSERT_NULL(cs_hashmap_create_from(sizeof(int), NULL, values, 3));
+}
+
+void test_hashmap_insert_bulk_existing(void) {
+    CsHashMapEngine engines[] = {CS_HASHMAP_CHAINED, CS_HASHMAP_SWISS, CS_HASHMAP_ROBIN_HOOD, CS_HASHMAP_CUCKOO};
+    for (size_t e = 0; e < 4; e++) {
+        CsHashMapOptions options = {.engine = engines[e]};
+        CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+        cs_hashmap_insert(map, "key5", &(int){-5});
+
+        // Les clés déjà présentes sont ignorées, les autres sont insérées
+        bulk_fill(100);
+        ASSERT_EQ(cs_hashmap_insert_bulk(map, bulk_keys, bulk_values, 100, NULL), CS_CONFLICT);
+        ASSERT_EQ(map->size, 100);
+        ASSERT_EQ(*(int*)cs_hashmap_get(map, "key5"), -5);
+        ASSERT_EQ(*(int*)cs_hashmap_get(map, "key99"), 99);
+
+        ASSERT_EQ(cs_hashmap_insert_bulk(map, bulk_keys, bulk_values, 100, NULL), CS_CONFLICT);
+        ASSERT_EQ(map->size, 100);
+
+        cs_hashmap_destroy(map);
+    }
+}
+
+void test_hashmap_insert_bulk_unique_threads(void) {
+    bulk_fill(BULK_KEYS);
+    CsHashMapEngine engines[] = {CS_HASHMAP_CHAINED, CS_HASHMAP_SWISS, CS_HASHMAP_ROBIN_HOOD, CS_HASHMAP_CUCKOO};
+    for (size_t e = 0; e < 4; e++) {
+        CsHashMapOptions options = {.engine = engines[e]};
+        CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+
+        // Entrées construites sur 4 threads, sans vérification des doublons
+        CsHashMapBulkOptions bulk = {.unique = true, .threads = 4};
+        ASSERT_EQ(cs_hashmap_insert_bulk(map, bulk_keys, bulk_values, BULK_KEYS, &bulk), CS_SUCCESS);
+        ASSERT_EQ(map->size, BULK_KEYS);
+
+        size_t found = 0;
+        for (size_t i = 0; i < BULK_KEYS; i++) {
+            int* value = cs_hashmap_get(map, bulk_keys[i]);
+            if (value && *value == (int)i) found++;
+        }
+        ASSERT_EQ(found, BULK_KEYS);
+
+        size_t in_order = 0;
+        for (size_t i = 0; i < map->order_len; i++) {
+            if (map->order[i] && *(int*)map->order[i]->data == (int)i) in_order++;
+        }
+        ASSERT_EQ(in_order, BULK_KEYS);
+
+        cs_hashmap_destroy(map);
+    }
+}
+
+void test_hashmap_insert_bulk_null(void) {
+    CsHashMap* map = cs_hashmap_create(sizeof(int));
+    const char* keys[] = {"a", NULL, "c"};
+    int values[] = {1, 2, 3};
+
+    ASSERT_EQ(cs_hashmap_insert_bulk(NULL, keys, values, 3, NULL), CS_NULL_POINTER);
+    ASSERT_EQ(cs_hashmap_insert_bulk(map, NULL, values, 3, NULL), CS_NULL_POINTER);
+    ASSERT_EQ(cs_hashmap_insert_bulk(map, keys, NULL, 3, NULL), CS_NULL_POINTER);
+
+    // Une clé NULL fait échouer tout le lot
+    ASSERT_EQ(cs_hashmap_insert_bulk(map, keys, values, 3, NULL), CS_NULL_POINTER);
+    ASSERT_EQ(map->size, 0);
+    ASSERT_FALSE(cs_hashmap_has(map, "a"));
+
+    ASSERT_EQ(cs_hashmap_insert_bulk(map, NULL, NULL, 0, NULL), CS_SUCCESS);
+    ASSERT_EQ(cs_hashmap_insert_bulk(map, keys, values, 1, NULL), CS_SUCCESS);
+    ASSERT_EQ(map->size, 1);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_insert_bulk_after_remove(void) {
+    bulk_fill(64);
+    CsHashMap* map = cs_hashmap_create_from(sizeof(int), bulk_keys, bulk_values, 32);
+    for (size_t i = 0; i < 32; i++) {
+        cs_hashmap_remove(map, bulk_keys[i]);
+    }
+
+    // Les trous du tableau d'ordre sont compactés avant d'y ajouter le lot
+    ASSERT_EQ(cs_hashmap_insert_bulk(map, bulk_keys + 32, bulk_values + 32, 32, NULL), CS_SUCCESS);
+    ASSERT_EQ(map->size, 32);
+    ASSERT_EQ(map->order_len, 32);
+
+    int expected = 32;
+    CsHashMapIter iter = cs_hashmap_iter_begin(map);
+    void* value;
+    while (cs_hashmap_iter_next(&iter, NULL, NULL, &value)) {
+        if (*(int*)value != expected) break;
+        expected++;
+    }
+    ASSERT_EQ(expected, 64);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests du destructeur et de take
+// ========================================
+
+static int destroyed_values = 0;
+
+static void count_destroyed(void* value) {
+    (void)value;
+    destroyed_values++;
+}
+
+static void free_string(void* value) {
+    free(*(char**)value);
+}
+
+static char* make_string(const char* text) {
+    char* copy = malloc(strlen(text) + 1);
+    strcpy(copy, text);
+    return copy;
+}
+
+void test_hashmap_destructor_calls(void) {
+    CsHashMapEngine engines[] = {CS_HASHMAP_CHAINED, CS_HASHMAP_SWISS, CS_HASHMAP_ROBIN_HOOD, CS_HASHMAP_CUCKOO};
+    for (size_t e = 0; e < 4; e++) {
+        CsHashMapOptions options = {.engine = engines[e], .destructor = count_destroyed};
+        CsHashMap* map = cs_hashmap_create_with_options(sizeof(int), &options);
+        destroyed_values = 0;
+
+        for (int i = 0; i < 10; i++) {
+            char key[16];
+            snprintf(key, sizeof(key), "key%d", i);
+            cs_hashmap_insert(map, key, &i);
+        }
+
+        // Un insert refusé ne touche pas la valeur en place
+        ASSERT_EQ(cs_hashmap_insert(map, "key0", &(int){42}), CS_CONFLICT);
+        ASSERT_EQ(destroyed_values, 0);
+
+        cs_hashmap_remove(map, "key0");
+        ASSERT_EQ(destroyed_values, 1);
+
+        // L'ancienne valeur est détruite avant d'être écrasée
+        cs_hashmap_upsert(map, "key1", &(int){100});
+        ASSERT_EQ(destroyed_values, 2);
+
+        // take rend la valeur à l'appelant sans la détruire
+        int taken = 0;
+        ASSERT_EQ(cs_hashmap_take(map, "key2", &taken), CS_SUCCESS);
+        ASSERT_EQ(taken, 2);
+        ASSERT_EQ(destroyed_values, 2);
+
+        cs_hashmap_clear(map);
+        ASSERT_EQ(destroyed_values, 10);
+
+        cs_hashmap_insert(map, "last", &(int){1});
+        cs_hashmap_destroy(map);
+        ASSERT_EQ(destroyed_values, 11);
+    }
+}
+
+void test_hashmap_destructor_owned_pointers(void) {
+    CsHashMapOptions options = {.destructor = free_string};
+    CsHashMap* map = cs_hashmap_create_with_options(sizeof(char*), &options);
+
+    // Les chaînes allouées appartiennent à la map : aucune fuite sous ASan
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        char* text = make_string(key);
+        cs_hashmap_insert(map, key, &text);
+    }
+    char* replacement = make_string("replacement");
+    cs_hashmap_upsert(map, "key3", &replacement);
+    cs_hashmap_remove(map, "key4");
+
+    // Réécrire une entrée avec sa propre valeur ne la détruit pas
+    ASSERT_NOT_NULL(cs_hashmap_upsert(map, "key5", cs_hashmap_get(map, "key5")));
+    ASSERT_STR_EQ(*(char**)cs_hashmap_get(map, "key5"), "key5");
+
+    // La chaîne prise appartient maintenant à l'appelant
+    char* taken = NULL;
+    ASSERT_EQ(cs_hashmap_take(map, "key3", &taken), CS_SUCCESS);
+    ASSERT_STR_EQ(taken, "replacement");
+    free(taken);
+
+    ASSERT_EQ(map->size, 98);
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_take(void) {
+    CsHashMapEngine engines[] = {CS_HASHMAP_CHAINED, CS_HASHMAP_SWISS, CS_HASHMAP_ROBIN_HOOD, CS_HASHMAP_CUCKOO};
+    for (size_t e = 0; e < 4; e++) {
+        CsHashMapOptions options = {.engine = engines[e]};
+        CsHashMap* map = cs_hashmap_create_with_options(sizeof(double), &options);
+        cs_hashmap_insert(map, "a", &(double){1.5});
+        cs_hashmap_insert_n(map, "b\0c", 3, &(double){2.5});
+        cs_hashmap_insert(map, "d", &(double){3.5});
+
+        double out = 0;
+        ASSERT_EQ(cs_hashmap_take(map, "a", &out), CS_SUCCESS);
+        ASSERT_TRUE(out == 1.5);
+        ASSERT_FALSE(cs_hashmap_has(map, "a"));
+        ASSERT_EQ(map->size, 2);
+
+        ASSERT_EQ(cs_hashmap_take_n(map, "b\0c", 3, &out), CS_SUCCESS);
+        ASSERT_TRUE(out == 2.5);
+
+        // Clé absente : le tampon n'est pas modifié
+        out = -1;
+        ASSERT_EQ(cs_hashmap_take(map, "a", &out), CS_NOT_FOUND);
+        ASSERT_TRUE(out == -1);
+
+        // L'itération saute les entrées prises
+        CsHashMapIter iter = cs_hashmap_iter_begin(map);
+        const char* key;
+        ASSERT_TRUE(cs_hashmap_iter_next(&iter, &key, NULL, NULL));
+        ASSERT_STR_EQ(key, "d");
+        ASSERT_FALSE(cs_hashmap_iter_next(&iter, NULL, NULL, NULL));
+
+        ASSERT_EQ(cs_hashmap_take(NULL, "d", &out), CS_NULL_POINTER);
+        ASSERT_EQ(cs_hashmap_take(map, NULL, &out), CS_NULL_POINTER);
+        ASSERT_EQ(cs_hashmap_take(map, "d", NULL), CS_NULL_POINTER);
+        ASSERT_EQ(map->size, 1);
+
+        cs_hashmap_destroy(map);
+    }
+}
+
+// ========================================
+// Tests du moteur robin hood
+// ========================================
+
+static CsHashMap* create_robin_hood_map(size_t value_size, CsHashFunction hash) {
+    CsHashMapOptions options = {.engine = CS_HASHMAP_ROBIN_HOOD, .hash = hash};
+    return cs_hashmap_create_with_options(value_size, &options);
+}
+
+// Distance à la maison d'après le hash en cache, 0 pour un slot vide
+static size_t robin_hood_distance(const CsHashMap* map, size_t slot) {
+    if (!map->buckets[slot]) return 0;
+    size_t home = (size_t)((map->buckets[slot]->hash * 0x9E3779B97F4A7C15ULL) >> map->shift);
+    return ((slot - home) & (map->capacity - 1)) + 1;
+}
+
+// Invariants : distance stockée exacte et, le long d'un run, jamais plus d'un cran de plus que le slot précédent
+static bool robin_hood_consistent(const CsHashMap* map) {
+    size_t entries = 0;
+    for (size_t i = 0; i < map->capacity; i++) {
+        size_t distance = robin_hood_distance(map, i);
+        if (map->ctrl[i] != distance) return false;
+        if (distance > HASHMAP_ROBIN_HOOD_MAX_DISTANCE + 1) return false;
+        if (distance > robin_hood_distance(map, (i - 1) & (map->capacity - 1)) + 1) return false;
+        if (distance) entries++;
+    }
+    return entries == map->size;
+}
+
+void test_hashmap_robin_hood_create(void) {
+    CsHashMap* map = create_robin_hood_map(sizeof(int), NULL);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->engine, CS_HASHMAP_ROBIN_HOOD);
+    ASSERT_EQ(map->capacity, HASHMAP_DEFAULT_CAPACITY);
+    ASSERT_NOT_NULL(map->ctrl);
+    cs_hashmap_destroy(map);
+
+    CsHashMapOptions options = {.engine = CS_HASHMAP_ROBIN_HOOD, .incremental = true};
+    ASSERT_NULL(cs_hashmap_create_with_options(sizeof(int), &options));
+}
+
+void test_hashmap_robin_hood_insert_get_remove(void) {
+    CsHashMap* map = create_robin_hood_map(sizeof(int), NULL);
+
+    for (int i = 0; i < 1000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(cs_hashmap_insert(map, key, &i), CS_SUCCESS);
+    }
+    ASSERT_EQ(map->size, 1000);
+    ASSERT_EQ(cs_hashmap_insert(map, "key10", &(int){0}), CS_CONFLICT);
+    ASSERT_TRUE(robin_hood_consistent(map));
+
+    for (int i = 0; i < 1000; i += 2) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(cs_hashmap_remove(map, key), CS_SUCCESS);
+    }
+    ASSERT_EQ(map->size, 500);
+    ASSERT_EQ(cs_hashmap_remove(map, "key0"), CS_NOT_FOUND);
+    ASSERT_TRUE(robin_hood_consistent(map));
+
+    int found = 0;
+    for (int i = 0; i < 1000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        int* value = (int*)cs_hashmap_get(map, key);
+        if ((i % 2 == 0 && !value) || (i % 2 == 1 && value && *value == i)) found++;
+    }
+    ASSERT_EQ(found, 1000);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_robin_hood_backward_shift(void) {
+    CsHashMap* map = create_robin_hood_map(sizeof(int), NULL);
+
+    // Aucun tombstone : des cycles insertion/suppression laissent la table vide et à sa taille d'origine
+    for (int cycle = 0; cycle < 10000; cycle++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", cycle);
+        cs_hashmap_insert(map, key, &cycle);
+        if (cycle % 4 != 0) cs_hashmap_remove(map, key);
+    }
+    ASSERT_EQ(map->size, 2500);
+    ASSERT_EQ(map->tombstones, 0);
+    ASSERT_TRUE(robin_hood_consistent(map));
+
+    for (int cycle = 0; cycle < 10000; cycle += 4) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", cycle);
+        cs_hashmap_remove(map, key);
+    }
+    size_t occupied = 0;
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->ctrl[i]) occupied++;
+    }
+    ASSERT_EQ(occupied, 0);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_robin_hood_high_load(void) {
+    // Rempli jusqu'au load factor de 0.9 sans resize, les sondages restent courts
+    size_t capacity = 1 << 14;
+    size_t entries = (size_t)(capacity * HASHMAP_ROBIN_HOOD_MAX_LOAD_FACTOR) - 1;
+    CsHashMap* map = create_robin_hood_map(sizeof(int), NULL);
+    ASSERT_EQ(cs_hashmap_resize(map, capacity), CS_SUCCESS);
+
+    for (size_t i = 0; i < entries; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "key%zu", i);
+        cs_hashmap_insert(map, key, &(int){(int)i});
+    }
+    ASSERT_EQ(map->capacity, capacity);
+    ASSERT_TRUE(robin_hood_consistent(map));
+
+    size_t max_distance = 0;
+    size_t total_distance = 0;
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->ctrl[i] > max_distance) max_distance = map->ctrl[i];
+        total_distance += map->ctrl[i];
+    }
+    ASSERT_TRUE(max_distance < 64);
+    ASSERT_TRUE(total_distance < entries * 8);
+
+    cs_hashmap_destroy(map);
+}
+
+static uint64_t same_hash(const void* key, size_t key_len) {
+    (void)key;
+    (void)key_len;
+    return 7;
+}
+
+void test_hashmap_robin_hood_distance_bound(void) {
+    CsHashMap* map = create_robin_hood_map(sizeof(int), same_hash);
+
+    // Des clés de même hash partagent leur run : au-delà de la borne, l'insertion est refusée
+    int inserted = 0;
+    CsResult result = CS_SUCCESS;
+    while (result == CS_SUCCESS && inserted < 1000) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", inserted);
+        result = cs_hashmap_insert(map, key, &inserted);
+        if (result == CS_SUCCESS) inserted++;
+    }
+    ASSERT_EQ(result, CS_OUT_OF_BOUNDS);
+    ASSERT_EQ(inserted, HASHMAP_ROBIN_HOOD_MAX_DISTANCE + 1);
+    ASSERT_EQ(map->size, HASHMAP_ROBIN_HOOD_MAX_DISTANCE + 1);
+    ASSERT_TRUE(robin_hood_consistent(map));
+    ASSERT_FALSE(cs_hashmap_has(map, "key1000"));
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key42"), 42);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_robin_hood_resize_and_clear(void) {
+    CsHashMap* map = create_robin_hood_map(sizeof(int), NULL);
+
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+
+    // Trop petit pour 100 entrées : arrondi à la capacité minimale utilisable
+    ASSERT_EQ(cs_hashmap_resize(map, 16), CS_SUCCESS);
+    ASSERT_EQ(map->capacity, 128);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key42"), 42);
+    ASSERT_TRUE(robin_hood_consistent(map));
+
+    ASSERT_EQ(cs_hashmap_resize(map, 1000), CS_SUCCESS);
+    ASSERT_EQ(map->capacity, 1024);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key99"), 99);
+
+    cs_hashmap_clear(map);
+    ASSERT_EQ(map->size, 0);
+    ASSERT_FALSE(cs_hashmap_has(map, "key42"));
+    ASSERT_EQ(cs_hashmap_insert(map, "key42", &(int){1}), CS_SUCCESS);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Tests du moteur cuckoo
+// ========================================
+
+static CsHashMap* create_cuckoo_map(size_t value_size, CsHashFunction hash) {
+    CsHashMapOptions options = {.engine = CS_HASHMAP_CUCKOO, .hash = hash};
+    return cs_hashmap_create_with_options(value_size, &options);
+}
+
+// Chaque entrée est dans l'un de ses deux buckets, avec l'empreinte de son hash
+static bool cuckoo_consistent(const CsHashMap* map) {
+    size_t entries = 0;
+    for (size_t i = 0; i < map->capacity; i++) {
+        CsHashMapEntry* entry = map->buckets[i];
+        if (!entry) {
+            if (map->ctrl[i] != 0) return false;
+            continue;
+        }
+        uint64_t hash = entry->hash;
+        size_t primary = (size_t)((hash * 0x9E3779B97F4A7C15ULL) >> map->shift);
+        size_t secondary = (size_t)((((hash >> 32) | (hash << 32)) * 0xC2B2AE3D27D4EB4FULL) >> map->shift);
+        if (secondary == primary) secondary = primary ^ 1;
+
+        size_t bucket = i / HASHMAP_CUCKOO_BUCKET_SIZE;
+        if (bucket != primary && bucket != secondary) return false;
+        if (map->ctrl[i] != ((uint8_t)hash ? (uint8_t)hash : 1)) return false;
+        entries++;
+    }
+    return entries == map->size;
+}
+
+void test_hashmap_cuckoo_create(void) {
+    CsHashMap* map = create_cuckoo_map(sizeof(int), NULL);
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->engine, CS_HASHMAP_CUCKOO);
+    ASSERT_EQ(map->capacity, 2 * HASHMAP_CUCKOO_BUCKET_SIZE);
+    ASSERT_NOT_NULL(map->ctrl);
+    cs_hashmap_destroy(map);
+
+    CsHashMapOptions options = {.engine = CS_HASHMAP_CUCKOO, .incremental = true};
+    ASSERT_NULL(cs_hashmap_create_with_options(sizeof(int), &options));
+}
+
+void test_hashmap_cuckoo_insert_get_remove(void) {
+    CsHashMap* map = create_cuckoo_map(sizeof(int), NULL);
+
+    for (int i = 0; i < 10000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(cs_hashmap_insert(map, key, &i), CS_SUCCESS);
+    }
+    ASSERT_EQ(map->size, 10000);
+    ASSERT_EQ(cs_hashmap_insert(map, "key10", &(int){0}), CS_CONFLICT);
+    ASSERT_TRUE(cuckoo_consistent(map));
+
+    for (int i = 0; i < 10000; i += 2) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(cs_hashmap_remove(map, key), CS_SUCCESS);
+    }
+    ASSERT_EQ(map->size, 5000);
+    ASSERT_EQ(cs_hashmap_remove(map, "key0"), CS_NOT_FOUND);
+    ASSERT_TRUE(cuckoo_consistent(map));
+
+    int found = 0;
+    for (int i = 0; i < 10000; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        int* value = (int*)cs_hashmap_get(map, key);
+        if ((i % 2 == 0 && !value) || (i % 2 == 1 && value && *value == i)) found++;
+    }
+    ASSERT_EQ(found, 10000);
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_cuckoo_high_load(void) {
+    // Les déplacements permettent de remplir la table jusqu'à 0.9 sans la faire grossir
+    size_t capacity = 1 << 14;
+    size_t entries = (size_t)(capacity * HASHMAP_CUCKOO_MAX_LOAD_FACTOR);
+    CsHashMap* map = create_cuckoo_map(sizeof(int), NULL);
+    ASSERT_EQ(cs_hashmap_resize(map, capacity), CS_SUCCESS);
+
+    for (size_t i = 0; i < entries; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "key%zu", i);
+        cs_hashmap_insert(map, key, &(int){(int)i});
+    }
+    ASSERT_EQ(map->size, entries);
+    ASSERT_EQ(map->capacity, capacity);
+    ASSERT_TRUE(cuckoo_consistent(map));
+
+    size_t found = 0;
+    for (size_t i = 0; i < entries; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "key%zu", i);
+        int* value = (int*)cs_hashmap_get(map, key);
+        if (value && *value == (int)i) found++;
+    }
+    ASSERT_EQ(found, entries);
+
+    cs_hashmap_destroy(map);
+}
+
+static uint64_t cuckoo_same_hash(const void* key, size_t key_len) {
+    (void)key;
+    (void)key_len;
+    return 0x123456789ULL;
+}
+
+void test_hashmap_cuckoo_bucket_bound(void) {
+    CsHashMap* map = create_cuckoo_map(sizeof(int), cuckoo_same_hash);
+
+    // Des clés de même hash n'ont que deux buckets : au-delà de leurs slots, l'insertion est refusée
+    int inserted = 0;
+    CsResult result = CS_SUCCESS;
+    while (result == CS_SUCCESS && inserted < 100) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", inserted);
+        result = cs_hashmap_insert(map, key, &inserted);
+        if (result == CS_SUCCESS) inserted++;
+    }
+    ASSERT_EQ(result, CS_OUT_OF_BOUNDS);
+    ASSERT_EQ(inserted, 2 * HASHMAP_CUCKOO_BUCKET_SIZE);
+    ASSERT_TRUE(cuckoo_consistent(map));
+    for (int i = 0; i < inserted; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        ASSERT_EQ(*(int*)cs_hashmap_get(map, key), i);
+    }
+
+    cs_hashmap_destroy(map);
+}
+
+void test_hashmap_cuckoo_resize_and_clear(void) {
+    CsHashMap* map = create_cuckoo_map(sizeof(int), NULL);
+
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        cs_hashmap_insert(map, key, &i);
+    }
+
+    // Trop petit pour 100 entrées : arrondi à la capacité minimale utilisable
+    ASSERT_EQ(cs_hashmap_resize(map, 16), CS_SUCCESS);
+    ASSERT_TRUE(map->capacity >= 128);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key42"), 42);
+    ASSERT_TRUE(cuckoo_consistent(map));
+
+    ASSERT_EQ(cs_hashmap_resize(map, 1000), CS_SUCCESS);
+    ASSERT_EQ(map->capacity, 1024);
+    ASSERT_EQ(*(int*)cs_hashmap_get(map, "key99"), 99);
+
+    cs_hashmap_clear(map);
+    ASSERT_EQ(map->size, 0);
+    ASSERT_FALSE(cs_hashmap_has(map, "key42"));
+    ASSERT_EQ(cs_hashmap_insert(map, "key42", &(int){1}), CS_SUCCESS);
+
+    cs_hashmap_destroy(map);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## HASHMAP TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== CREATION & DESTRUCTION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_create_destroy);
+    RUN_TEST(test_hashmap_create_with_zero_size);
+    RUN_TEST(test_hashmap_create_with_different_types);
+    RUN_TEST(test_hashmap_destroy_null);
+    RUN_TEST(test_hashmap_create_with_capacity);
+
+    printf("\n" COLOR_BLUE "========== INSERT ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_insert_single);
+    RUN_TEST(test_hashmap_insert_multiple);
+    RUN_TEST(test_hashmap_insert_duplicate_key);
+    RUN_TEST(test_hashmap_insert_null_hashmap);
+    RUN_TEST(test_hashmap_insert_null_key);
+    RUN_TEST(test_hashmap_insert_null_value);
+    RUN_TEST(test_hashmap_insert_with_auto_resize);
+
+    printf("\n" COLOR_BLUE "========== GET & HAS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_get_existing_key);
+    RUN_TEST(test_hashmap_get_non_existing_key);
+    RUN_TEST(test_hashmap_get_null_hashmap);
+    RUN_TEST(test_hashmap_get_null_key);
+    RUN_TEST(test_hashmap_has_existing_key);
+    RUN_TEST(test_hashmap_has_non_existing_key);
+    RUN_TEST(test_hashmap_has_null_hashmap);
+    RUN_TEST(test_hashmap_has_null_key);
+
+    printf("\n" COLOR_BLUE "========== REMOVE ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_remove_existing_key);
+    RUN_TEST(test_hashmap_remove_non_existing_key);
+    RUN_TEST(test_hashmap_remove_from_bucket_chain);
+    RUN_TEST(test_hashmap_remove_null_hashmap);
+    RUN_TEST(test_hashmap_remove_null_key);
+
+    printf("\n" COLOR_BLUE "========== CLEAR ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_clear_empty);
+    RUN_TEST(test_hashmap_clear_with_data);
+    RUN_TEST(test_hashmap_clear_null);
+
+    printf("\n" COLOR_BLUE "========== RESIZE ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_resize_increase);
+    RUN_TEST(test_hashmap_resize_decrease);
+    RUN_TEST(test_hashmap_resize_same_capacity);
+    RUN_TEST(test_hashmap_resize_too_large);
+    RUN_TEST(test_hashmap_resize_null_hashmap);
+
+    printf("\n" COLOR_BLUE "========== COMPLEX TYPES ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_with_structs);
+    RUN_TEST(test_hashmap_with_string_values);
+
+    printf("\n" COLOR_BLUE "========== COLLISIONS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_collision_handling);
+
+    printf("\n" COLOR_BLUE "========== STRESS TESTS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_large_dataset);
+    RUN_TEST(test_hashmap_insert_remove_cycle);
+    RUN_TEST(test_hashmap_key_variations);
+    RUN_TEST(test_hashmap_empty_string_key);
+    RUN_TEST(test_hashmap_long_key);
+    RUN_TEST(test_hashmap_overwrite_protection);
+
+
+    printf("\n" COLOR_BLUE "========== SWISS ENGINE ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_swiss_create);
+    RUN_TEST(test_hashmap_create_with_invalid_engine);
+    RUN_TEST(test_hashmap_swiss_insert_get_remove);
+    RUN_TEST(test_hashmap_swiss_tombstone_reuse);
+    RUN_TEST(test_hashmap_swiss_resize_and_clear);
+
+
+    printf("\n" COLOR_BLUE "========== CACHED HASH ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_entries_cache_hash);
+
+
+    printf("\n" COLOR_BLUE "========== BINARY KEYS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_binary_keys);
+    RUN_TEST(test_hashmap_key_slices);
+    RUN_TEST(test_hashmap_binary_keys_swiss);
+    RUN_TEST(test_hashmap_binary_keys_null);
+
+
+    printf("\n" COLOR_BLUE "========== HASH FUNCTIONS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_default_hash);
+    RUN_TEST(test_hashmap_custom_hash);
+
+
+    printf("\n" COLOR_BLUE "========== POWER OF TWO CAPACITY ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_capacity_power_of_two);
+    RUN_TEST(test_hashmap_weak_hash_distribution);
+
+
+    printf("\n" COLOR_BLUE "========== INCREMENTAL RESIZE ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_incremental_rejects_swiss);
+    RUN_TEST(test_hashmap_incremental_insert_get);
+    RUN_TEST(test_hashmap_incremental_remove_during_migration);
+    RUN_TEST(test_hashmap_incremental_resize_and_clear);
+    RUN_TEST(test_hashmap_clear_after_removing_all);
+
+
+    printf("\n" COLOR_BLUE "========== ENTRY LAYOUT ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_entry_single_allocation);
+
+
+    printf("\n" COLOR_BLUE "========== BATCH LOOKUP ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_get_batch);
+    RUN_TEST(test_hashmap_get_batch_swiss);
+    RUN_TEST(test_hashmap_get_batch_during_migration);
+    RUN_TEST(test_hashmap_get_batch_edge_cases);
+
+
+    printf("\n" COLOR_BLUE "========== GET OR INSERT / UPSERT ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_get_or_insert);
+    RUN_TEST(test_hashmap_get_or_insert_counter);
+    RUN_TEST(test_hashmap_get_or_insert_across_resize);
+    RUN_TEST(test_hashmap_upsert);
+    RUN_TEST(test_hashmap_upsert_null);
+
+
+    printf("\n" COLOR_BLUE "========== ITERATION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_iter_insertion_order);
+    RUN_TEST(test_hashmap_iter_empty);
+    RUN_TEST(test_hashmap_iter_remove_while_iterating);
+    RUN_TEST(test_hashmap_iter_order_after_compaction);
+    RUN_TEST(test_hashmap_for_each);
+
+
+    printf("\n" COLOR_BLUE "========== BULK INSERT ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_create_from);
+    RUN_TEST(test_hashmap_create_from_duplicates);
+    RUN_TEST(test_hashmap_insert_bulk_existing);
+    RUN_TEST(test_hashmap_insert_bulk_unique_threads);
+    RUN_TEST(test_hashmap_insert_bulk_null);
+    RUN_TEST(test_hashmap_insert_bulk_after_remove);
+
+
+    printf("\n" COLOR_BLUE "========== DESTRUCTOR / TAKE ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_destructor_calls);
+    RUN_TEST(test_hashmap_destructor_owned_pointers);
+    RUN_TEST(test_hashmap_take);
+
+
+    printf("\n" COLOR_BLUE "========== ROBIN HOOD ENGINE ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_robin_hood_create);
+    RUN_TEST(test_hashmap_robin_hood_insert_get_remove);
+    RUN_TEST(test_hashmap_robin_hood_backward_shift);
+    RUN_TEST(test_hashmap_robin_hood_high_load);
+    RUN_TEST(test_hashmap_robin_hood_distance_bound);
+    RUN_TEST(test_hashmap_robin_hood_resize_and_clear);
+
+
+    printf("\n" COLOR_BLUE "========== CUCKOO ENGINE ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashmap_cuckoo_create);
+    RUN_TEST(test_hashmap_cuckoo_insert_get_remove);
+    RUN_TEST(test_hashmap_cuckoo_high_load);
+    RUN_TEST(test_hashmap_cuckoo_bucket_bound);
+    RUN_TEST(test_hashmap_cuckoo_resize_and_clear);
 
     TEST_SUMMARY();
 
@@ -0,0 +1,251 @@
+#include "cstash/hashmap_typed.h"
+#include "test_framework.h"
+#include <string.h>
+
+static uint64_t hash_int(int key) {
+    return cs_hash_wy(&key, sizeof(key));
+}
+
+static bool eq_int(int a, int b) {
+    return a == b;
+}
+
+static uint64_t hash_string(const char* key) {
+    return cs_hash_wy(key, strlen(key));
+}
+
+static bool eq_string(const char* a, const char* b) {
+    return strcmp(a, b) == 0;
+}
+
+typedef struct {
+    double x;
+    double y;
+} Point;
+
+// Hash constant : toutes les clés partagent la même séquence de sondage
+static uint64_t hash_colliding(int key) {
+    (void)key;
+    return 42;
+}
+
+CS_HASHMAP_DEFINE(IntMap, int, int, hash_int, eq_int)
+CS_HASHMAP_DEFINE(PointMap, const char*, Point, hash_string, eq_string)
+CS_HASHMAP_DEFINE(CollidingMap, int, int, hash_colliding, eq_int)
+
+// ========================================
+// Tests de création
+// ========================================
+
+void test_typed_hashmap_create(void) {
+    IntMap* map = IntMap_create();
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->capacity, HASHMAP_DEFAULT_CAPACITY);
+    ASSERT_EQ(IntMap_size(map), 0);
+    IntMap_destroy(map);
+
+    // Assez de place pour 1000 entrées sous le load factor : aucun resize
+    map = IntMap_create_with_capacity(1000);
+    ASSERT_EQ(map->capacity, 2048);
+    for (int i = 0; i < 1000; i++) IntMap_insert(map, i, i);
+    ASSERT_EQ(map->capacity, 2048);
+    IntMap_destroy(map);
+
+    ASSERT_NULL(IntMap_create_with_capacity(SIZE_MAX));
+    IntMap_destroy(NULL);
+}
+
+// ========================================
+// Tests des opérations
+// ========================================
+
+void test_typed_hashmap_insert_get(void) {
+    IntMap* map = IntMap_create();
+
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_EQ(IntMap_insert(map, i, i * 2), CS_SUCCESS);
+    }
+    ASSERT_EQ(IntMap_size(map), 10000);
+    ASSERT_EQ(IntMap_insert(map, 5, 0), CS_CONFLICT);
+
+    size_t found = 0;
+    for (int i = 0; i < 10000; i++) {
+        int* value = IntMap_get(map, i);
+        if (value && *value == i * 2) found++;
+    }
+    ASSERT_EQ(found, 10000);
+    ASSERT_NULL(IntMap_get(map, -1));
+    ASSERT_FALSE(IntMap_has(map, 10000));
+
+    IntMap_destroy(map);
+}
+
+void test_typed_hashmap_upsert(void) {
+    IntMap* map = IntMap_create();
+
+    int* value = IntMap_upsert(map, 1, 10);
+    ASSERT_EQ(*value, 10);
+    value = IntMap_upsert(map, 1, 20);
+    ASSERT_EQ(*value, 20);
+    ASSERT_EQ(IntMap_size(map), 1);
+
+    // Le pointeur retourné permet la mise à jour en place
+    (*IntMap_get(map, 1))++;
+    ASSERT_EQ(*IntMap_get(map, 1), 21);
+
+    IntMap_destroy(map);
+}
+
+void test_typed_hashmap_remove(void) {
+    IntMap* map = IntMap_create();
+    for (int i = 0; i < 100; i++) IntMap_insert(map, i, i);
+
+    for (int i = 0; i < 100; i += 2) {
+        ASSERT_EQ(IntMap_remove(map, i), CS_SUCCESS);
+    }
+    ASSERT_EQ(IntMap_remove(map, 0), CS_NOT_FOUND);
+    ASSERT_EQ(IntMap_size(map), 50);
+
+    size_t found = 0;
+    for (int i = 1; i < 100; i += 2) {
+        if (IntMap_has(map, i)) found++;
+    }
+    ASSERT_EQ(found, 50);
+    ASSERT_FALSE(IntMap_has(map, 50));
+
+    IntMap_clear(map);
+    ASSERT_EQ(IntMap_size(map), 0);
+    ASSERT_FALSE(IntMap_has(map, 1));
+    ASSERT_EQ(IntMap_insert(map, 1, 1), CS_SUCCESS);
+
+    IntMap_destroy(map);
+}
+
+void test_typed_hashmap_tombstones(void) {
+    CollidingMap* map = CollidingMap_create();
+
+    // Une seule chaîne de sondage : les suppressions au milieu laissent des tombstones
+    for (int i = 0; i < 5; i++) CollidingMap_insert(map, i, i);
+    ASSERT_EQ(CollidingMap_remove(map, 1), CS_SUCCESS);
+    ASSERT_EQ(map->tombstones, 1);
+    ASSERT_EQ(*CollidingMap_get(map, 4), 4);
+
+    // La fin de chaîne redevient vide
+    ASSERT_EQ(CollidingMap_remove(map, 4), CS_SUCCESS);
+    ASSERT_EQ(map->tombstones, 1);
+
+    // Insertions et suppressions répétées : les tombstones sont recyclés ou nettoyés par un rehash
+    for (int round = 0; round < 1000; round++) {
+        CollidingMap_insert(map, 100 + round, round);
+        CollidingMap_remove(map, 100 + round);
+    }
+    ASSERT_EQ(CollidingMap_size(map), 3);
+    ASSERT_EQ(map->capacity, HASHMAP_DEFAULT_CAPACITY);
+    ASSERT_EQ(*CollidingMap_get(map, 3), 3);
+
+    CollidingMap_destroy(map);
+}
+
+void test_typed_hashmap_struct_values(void) {
+    PointMap* map = PointMap_create();
+
+    PointMap_insert(map, "origin", (Point){0.0, 0.0});
+    PointMap_insert(map, "unit", (Point){1.0, 1.0});
+
+    // Les clés chaînes sont comparées par contenu, pas par adresse
+    char key[16];
+    strcpy(key, "unit");
+    Point* point = PointMap_get(map, key);
+    ASSERT_NOT_NULL(point);
+    ASSERT_TRUE(point->x == 1.0 && point->y == 1.0);
+
+    PointMap_upsert(map, "unit", (Point){2.0, 3.0});
+    ASSERT_TRUE(PointMap_get(map, "unit")->y == 3.0);
+
+    PointMap_destroy(map);
+}
+
+void test_typed_hashmap_next(void) {
+    IntMap* map = IntMap_create();
+    for (int i = 1; i <= 100; i++) IntMap_insert(map, i, i);
+    IntMap_remove(map, 50);
+
+    size_t cursor = 0;
+    int key;
+    int* value;
+    int count = 0;
+    int sum = 0;
+    while (IntMap_next(map, &cursor, &key, &value)) {
+        ASSERT_EQ(key, *value);
+        count++;
+        sum += *value;
+    }
+    ASSERT_EQ(count, 99);
+    ASSERT_EQ(sum, 5050 - 50);
+
+    ASSERT_FALSE(IntMap_next(NULL, &cursor, NULL, NULL));
+    IntMap_destroy(map);
+}
+
+void test_typed_hashmap_copy(void) {
+    IntMap* source = IntMap_create();
+    for (int i = 0; i < 16384; i++) IntMap_insert(source, i, i);
+
+    // Les premières clés dans l'ordre des slots ne doivent pas s'empiler en un seul amas dans la copie
+    IntMap* copy = IntMap_create();
+    size_t cursor = 0;
+    int key;
+    int* value;
+    while (IntMap_size(copy) < 2048 && IntMap_next(source, &cursor, &key, &value)) IntMap_insert(copy, key, *value);
+    size_t run = 0;
+    size_t longest_run = 0;
+    for (size_t i = 0; i < copy->capacity; i++) {
+        run = copy->ctrl[i] & 0x80 ? 0 : run + 1;
+        if (run > longest_run) longest_run = run;
+    }
+    ASSERT_TRUE(longest_run < 256);
+
+    while (IntMap_next(source, &cursor, &key, &value)) IntMap_insert(copy, key, *value);
+    ASSERT_EQ(IntMap_size(copy), 16384);
+    for (int i = 0; i < 16384; i++) ASSERT_TRUE(IntMap_has(copy, i));
+
+    IntMap_destroy(copy);
+    IntMap_destroy(source);
+}
+
+void test_typed_hashmap_null(void) {
+    ASSERT_NULL(IntMap_get(NULL, 1));
+    ASSERT_FALSE(IntMap_has(NULL, 1));
+    ASSERT_EQ(IntMap_insert(NULL, 1, 1), CS_NULL_POINTER);
+    ASSERT_NULL(IntMap_upsert(NULL, 1, 1));
+    ASSERT_EQ(IntMap_remove(NULL, 1), CS_NULL_POINTER);
+    ASSERT_EQ(IntMap_size(NULL), 0);
+    IntMap_clear(NULL);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## TYPED HASHMAP TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== CREATION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_typed_hashmap_create);
+
+    printf("\n" COLOR_BLUE "========== OPERATIONS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_typed_hashmap_insert_get);
+    RUN_TEST(test_typed_hashmap_upsert);
+    RUN_TEST(test_typed_hashmap_remove);
+    RUN_TEST(test_typed_hashmap_tombstones);
+    RUN_TEST(test_typed_hashmap_struct_values);
+    RUN_TEST(test_typed_hashmap_next);
+    RUN_TEST(test_typed_hashmap_copy);
+    RUN_TEST(test_typed_hashmap_null);
+
+    TEST_SUMMARY();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,281 @@
+#include "cstash/hashset.h"
+#include "test_framework.h"
+#include <stdio.h>
+#include <string.h>
+
+static void fill_range(CsHashSet* set, size_t from, size_t to) {
+    char key[32];
+    for (size_t i = from; i < to; i++) {
+        snprintf(key, sizeof(key), "key_%zu", i);
+        cs_hashset_add(set, key);
+    }
+}
+
+static size_t count_range(const CsHashSet* set, size_t from, size_t to) {
+    char key[32];
+    size_t found = 0;
+    for (size_t i = from; i < to; i++) {
+        snprintf(key, sizeof(key), "key_%zu", i);
+        if (cs_hashset_contains(set, key)) found++;
+    }
+    return found;
+}
+
+// ========================================
+// Tests du HashSet de chaînes
+// ========================================
+
+void test_hashset_add_contains_remove(void) {
+    CsHashSet* set = cs_hashset_create();
+    ASSERT_NOT_NULL(set);
+    ASSERT_EQ(cs_hashset_size(set), 0);
+
+    ASSERT_EQ(cs_hashset_add(set, "apple"), CS_SUCCESS);
+    ASSERT_EQ(cs_hashset_add(set, "banana"), CS_SUCCESS);
+    ASSERT_EQ(cs_hashset_add(set, "apple"), CS_CONFLICT);
+    ASSERT_EQ(cs_hashset_size(set), 2);
+
+    ASSERT_TRUE(cs_hashset_contains(set, "apple"));
+    ASSERT_FALSE(cs_hashset_contains(set, "cherry"));
+
+    // Clés binaires : l'octet nul fait partie de la clé
+    ASSERT_EQ(cs_hashset_add_n(set, "a\0b", 3), CS_SUCCESS);
+    ASSERT_TRUE(cs_hashset_contains_n(set, "a\0b", 3));
+    ASSERT_FALSE(cs_hashset_contains_n(set, "a\0c", 3));
+
+    ASSERT_EQ(cs_hashset_remove(set, "apple"), CS_SUCCESS);
+    ASSERT_EQ(cs_hashset_remove(set, "apple"), CS_NOT_FOUND);
+    ASSERT_EQ(cs_hashset_remove_n(set, "a\0b", 3), CS_SUCCESS);
+    ASSERT_EQ(cs_hashset_size(set), 1);
+
+    cs_hashset_clear(set);
+    ASSERT_EQ(cs_hashset_size(set), 0);
+    ASSERT_FALSE(cs_hashset_contains(set, "banana"));
+
+    cs_hashset_destroy(set);
+}
+
+void test_hashset_next(void) {
+    CsHashSet* set = cs_hashset_create_with_capacity(100);
+    fill_range(set, 0, 100);
+    cs_hashset_remove(set, "key_50");
+
+    // Ordre d'insertion, les trous laissés par les suppressions sont sautés
+    size_t cursor = 0;
+    size_t visited = 0;
+    const char* key;
+    size_t key_len;
+    char expected[32];
+    while (cs_hashset_next(set, &cursor, &key, &key_len)) {
+        size_t index = visited < 50 ? visited : visited + 1;
+        snprintf(expected, sizeof(expected), "key_%zu", index);
+        ASSERT_STR_EQ(key, expected);
+        ASSERT_EQ(key_len, strlen(expected));
+        visited++;
+    }
+    ASSERT_EQ(visited, 99);
+    ASSERT_FALSE(cs_hashset_next(set, NULL, &key, &key_len));
+
+    cs_hashset_destroy(set);
+}
+
+void test_hashset_operations(void) {
+    CsHashSet* a = cs_hashset_create();
+    CsHashSet* b = cs_hashset_create();
+    fill_range(a, 0, 1000);
+    fill_range(b, 500, 2000);
+
+    CsHashSet* both = cs_hashset_union(a, b);
+    ASSERT_EQ(cs_hashset_size(both), 2000);
+    ASSERT_EQ(count_range(both, 0, 2000), 2000);
+
+    CsHashSet* common = cs_hashset_intersection(a, b);
+    ASSERT_EQ(cs_hashset_size(common), 500);
+    ASSERT_EQ(count_range(common, 500, 1000), 500);
+
+    CsHashSet* only_a = cs_hashset_difference(a, b);
+    ASSERT_EQ(cs_hashset_size(only_a), 500);
+    ASSERT_EQ(count_range(only_a, 0, 500), 500);
+
+    CsHashSet* only_b = cs_hashset_difference(b, a);
+    ASSERT_EQ(cs_hashset_size(only_b), 1000);
+    ASSERT_EQ(count_range(only_b, 1000, 2000), 1000);
+
+    // Les entrées sont inchangées et le résultat est un set indépendant
+    ASSERT_EQ(cs_hashset_size(a), 1000);
+    ASSERT_EQ(cs_hashset_size(b), 1500);
+    ASSERT_EQ(cs_hashset_add(both, "extra"), CS_SUCCESS);
+    ASSERT_FALSE(cs_hashset_contains(a, "extra"));
+
+    cs_hashset_destroy(a);
+    cs_hashset_destroy(b);
+    cs_hashset_destroy(both);
+    cs_hashset_destroy(common);
+    cs_hashset_destroy(only_a);
+    cs_hashset_destroy(only_b);
+}
+
+void test_hashset_operations_edge_cases(void) {
+    CsHashSet* a = cs_hashset_create();
+    CsHashSet* empty = cs_hashset_create();
+    fill_range(a, 0, 100);
+    cs_hashset_remove(a, "key_0");
+
+    CsHashSet* same = cs_hashset_union(a, a);
+    ASSERT_EQ(cs_hashset_size(same), 99);
+    CsHashSet* self = cs_hashset_intersection(a, a);
+    ASSERT_EQ(cs_hashset_size(self), 99);
+    CsHashSet* none = cs_hashset_difference(a, a);
+    ASSERT_EQ(cs_hashset_size(none), 0);
+    CsHashSet* with_empty = cs_hashset_intersection(empty, a);
+    ASSERT_EQ(cs_hashset_size(with_empty), 0);
+    CsHashSet* all = cs_hashset_difference(a, empty);
+    ASSERT_EQ(count_range(all, 1, 100), 99);
+
+    ASSERT_NULL(cs_hashset_union(a, NULL));
+    ASSERT_NULL(cs_hashset_intersection(NULL, a));
+    ASSERT_NULL(cs_hashset_difference(NULL, NULL));
+
+    CsHashSet* sets[] = {a, empty, same, self, none, with_empty, all};
+    for (size_t i = 0; i < sizeof(sets) / sizeof(sets[0]); i++) cs_hashset_destroy(sets[i]);
+}
+
+void test_hashset_null(void) {
+    size_t cursor = 0;
+    ASSERT_EQ(cs_hashset_add(NULL, "a"), CS_NULL_POINTER);
+    ASSERT_EQ(cs_hashset_add_n(NULL, "a", 1), CS_NULL_POINTER);
+    ASSERT_FALSE(cs_hashset_contains(NULL, "a"));
+    ASSERT_EQ(cs_hashset_remove(NULL, "a"), CS_NULL_POINTER);
+    ASSERT_EQ(cs_hashset_size(NULL), 0);
+    ASSERT_FALSE(cs_hashset_next(NULL, &cursor, NULL, NULL));
+    cs_hashset_clear(NULL);
+    cs_hashset_destroy(NULL);
+
+    CsHashSet* set = cs_hashset_create();
+    ASSERT_EQ(cs_hashset_add(set, NULL), CS_NULL_POINTER);
+    ASSERT_FALSE(cs_hashset_contains(set, NULL));
+    ASSERT_EQ(cs_hashset_remove(set, NULL), CS_NULL_POINTER);
+    cs_hashset_destroy(set);
+}
+
+// ========================================
+// Tests du HashSet d'entiers
+// ========================================
+
+void test_int_hashset_add_contains_remove(void) {
+    CsIntHashSet* set = cs_int_hashset_create();
+    ASSERT_NOT_NULL(set);
+    ASSERT_EQ(set->map->slot_size, 8);
+
+    for (uint64_t i = 0; i < 10000; i++) ASSERT_EQ(cs_int_hashset_add(set, i * 3), CS_SUCCESS);
+    ASSERT_EQ(cs_int_hashset_add(set, 0), CS_CONFLICT);
+    ASSERT_EQ(cs_int_hashset_add(set, UINT64_MAX), CS_SUCCESS);
+    ASSERT_EQ(cs_int_hashset_size(set), 10001);
+
+    ASSERT_TRUE(cs_int_hashset_contains(set, 9999 * 3));
+    ASSERT_TRUE(cs_int_hashset_contains(set, UINT64_MAX));
+    ASSERT_FALSE(cs_int_hashset_contains(set, 1));
+
+    ASSERT_EQ(cs_int_hashset_remove(set, 3), CS_SUCCESS);
+    ASSERT_EQ(cs_int_hashset_remove(set, 3), CS_NOT_FOUND);
+    ASSERT_EQ(cs_int_hashset_size(set), 10000);
+
+    size_t cursor = 0;
+    size_t visited = 0;
+    uint64_t key;
+    while (cs_int_hashset_next(set, &cursor, &key)) {
+        if (key == UINT64_MAX || key % 3 == 0) visited++;
+    }
+    ASSERT_EQ(visited, 10000);
+
+    cs_int_hashset_clear(set);
+    ASSERT_EQ(cs_int_hashset_size(set), 0);
+    ASSERT_FALSE(cs_int_hashset_contains(set, 0));
+
+    cs_int_hashset_destroy(set);
+}
+
+void test_int_hashset_operations(void) {
+    // a est créé à la capacité du résultat de l'union : ses slots sont recopiés tels quels
+    CsIntHashSet* a = cs_int_hashset_create_with_capacity(3000);
+    CsIntHashSet* b = cs_int_hashset_create();
+    for (uint64_t i = 0; i < 1000; i++) cs_int_hashset_add(a, i);
+    for (uint64_t i = 500; i < 2000; i++) cs_int_hashset_add(b, i);
+
+    CsIntHashSet* both = cs_int_hashset_union(a, b);
+    ASSERT_EQ(both->map->capacity, a->map->capacity);
+    CsIntHashSet* common = cs_int_hashset_intersection(b, a);
+    CsIntHashSet* only_a = cs_int_hashset_difference(a, b);
+    CsIntHashSet* only_b = cs_int_hashset_difference(b, a);
+
+    size_t in_both = 0;
+    size_t in_common = 0;
+    size_t in_only_a = 0;
+    size_t in_only_b = 0;
+    for (uint64_t i = 0; i < 2000; i++) {
+        if (cs_int_hashset_contains(both, i)) in_both++;
+        if (cs_int_hashset_contains(common, i) && i >= 500 && i < 1000) in_common++;
+        if (cs_int_hashset_contains(only_a, i) && i < 500) in_only_a++;
+        if (cs_int_hashset_contains(only_b, i) && i >= 1000) in_only_b++;
+    }
+    ASSERT_EQ(cs_int_hashset_size(both), 2000);
+    ASSERT_EQ(in_both, 2000);
+    ASSERT_EQ(cs_int_hashset_size(common), 500);
+    ASSERT_EQ(in_common, 500);
+    ASSERT_EQ(cs_int_hashset_size(only_a), 500);
+    ASSERT_EQ(in_only_a, 500);
+    ASSERT_EQ(cs_int_hashset_size(only_b), 1000);
+    ASSERT_EQ(in_only_b, 1000);
+
+    // Avec des tombstones dans a, les clés sont replacées une à une
+    for (uint64_t i = 0; i < 1000; i += 2) cs_int_hashset_remove(a, i);
+    CsIntHashSet* after_removals = cs_int_hashset_union(a, b);
+    ASSERT_EQ(cs_int_hashset_size(after_removals), 1750);
+    ASSERT_FALSE(cs_int_hashset_contains(after_removals, 0));
+    ASSERT_TRUE(cs_int_hashset_contains(after_removals, 1));
+    ASSERT_TRUE(cs_int_hashset_contains(after_removals, 1998));
+
+    ASSERT_NULL(cs_int_hashset_union(a, NULL));
+    ASSERT_NULL(cs_int_hashset_intersection(NULL, b));
+    ASSERT_NULL(cs_int_hashset_difference(NULL, NULL));
+
+    CsIntHashSet* sets[] = {a, b, both, common, only_a, only_b, after_removals};
+    for (size_t i = 0; i < sizeof(sets) / sizeof(sets[0]); i++) cs_int_hashset_destroy(sets[i]);
+}
+
+void test_int_hashset_null(void) {
+    size_t cursor = 0;
+    ASSERT_EQ(cs_int_hashset_add(NULL, 1), CS_NULL_POINTER);
+    ASSERT_FALSE(cs_int_hashset_contains(NULL, 1));
+    ASSERT_EQ(cs_int_hashset_remove(NULL, 1), CS_NULL_POINTER);
+    ASSERT_EQ(cs_int_hashset_size(NULL), 0);
+    ASSERT_FALSE(cs_int_hashset_next(NULL, &cursor, NULL));
+    cs_int_hashset_clear(NULL);
+    cs_int_hashset_destroy(NULL);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## HASHSET TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== STRING KEYS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_hashset_add_contains_remove);
+    RUN_TEST(test_hashset_next);
+    RUN_TEST(test_hashset_operations);
+    RUN_TEST(test_hashset_operations_edge_cases);
+    RUN_TEST(test_hashset_null);
+
+    printf("\n" COLOR_BLUE "========== INTEGER KEYS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_int_hashset_add_contains_remove);
+    RUN_TEST(test_int_hashset_operations);
+    RUN_TEST(test_int_hashset_null);
+
+    TEST_SUMMARY();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,214 @@
+#include "cstash/int_hashmap.h"
+#include "test_framework.h"
+#include <string.h>
+
+typedef struct {
+    uint32_t id;
+    double score;
+} Record;
+
+// ========================================
+// Tests de création
+// ========================================
+
+void test_int_hashmap_create(void) {
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(int));
+    ASSERT_NOT_NULL(map);
+    ASSERT_EQ(map->capacity, HASHMAP_DEFAULT_CAPACITY);
+    ASSERT_EQ(map->slot_size, 16);
+    ASSERT_EQ(cs_int_hashmap_size(map), 0);
+    cs_int_hashmap_destroy(map);
+
+    // Assez de place pour 1000 entrées sous le load factor : aucun resize
+    map = cs_int_hashmap_create_with_capacity(sizeof(int), 1000);
+    ASSERT_EQ(map->capacity, 2048);
+    for (uint64_t i = 0; i < 1000; i++) cs_int_hashmap_insert(map, i, &(int){0});
+    ASSERT_EQ(map->capacity, 2048);
+    cs_int_hashmap_destroy(map);
+
+    ASSERT_NULL(cs_int_hashmap_create_with_capacity(sizeof(int), SIZE_MAX));
+    ASSERT_NULL(cs_int_hashmap_create(SIZE_MAX));
+    cs_int_hashmap_destroy(NULL);
+}
+
+// ========================================
+// Tests des opérations
+// ========================================
+
+void test_int_hashmap_insert_get(void) {
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(uint64_t));
+
+    for (uint64_t i = 0; i < 10000; i++) {
+        uint64_t value = i * 2;
+        ASSERT_EQ(cs_int_hashmap_insert(map, i, &value), CS_SUCCESS);
+    }
+    ASSERT_EQ(cs_int_hashmap_size(map), 10000);
+    ASSERT_EQ(cs_int_hashmap_insert(map, 5, &(uint64_t){0}), CS_CONFLICT);
+
+    size_t found = 0;
+    for (uint64_t i = 0; i < 10000; i++) {
+        uint64_t* value = cs_int_hashmap_get(map, i);
+        if (value && *value == i * 2) found++;
+    }
+    ASSERT_EQ(found, 10000);
+    ASSERT_NULL(cs_int_hashmap_get(map, 10000));
+    ASSERT_FALSE(cs_int_hashmap_has(map, UINT64_MAX));
+
+    cs_int_hashmap_destroy(map);
+}
+
+void test_int_hashmap_full_key_range(void) {
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(int));
+
+    // 0, les extrêmes et des clés uint32_t élargies sont des clés comme les autres
+    uint64_t keys[] = {0, 1, UINT64_MAX, UINT64_MAX - 1, (uint64_t)UINT32_MAX, 1ULL << 32, 1ULL << 63};
+    size_t count = sizeof(keys) / sizeof(keys[0]);
+    for (size_t i = 0; i < count; i++) {
+        int value = (int)i;
+        ASSERT_EQ(cs_int_hashmap_insert(map, keys[i], &value), CS_SUCCESS);
+    }
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(*(int*)cs_int_hashmap_get(map, keys[i]), (int)i);
+    }
+
+    uint32_t id = UINT32_MAX;
+    ASSERT_TRUE(cs_int_hashmap_has(map, id));
+    ASSERT_FALSE(cs_int_hashmap_has(map, 2));
+
+    cs_int_hashmap_destroy(map);
+}
+
+void test_int_hashmap_upsert(void) {
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(Record));
+
+    Record* record = cs_int_hashmap_upsert(map, 7, &(Record){7, 1.5});
+    ASSERT_EQ(record->id, 7);
+    record = cs_int_hashmap_upsert(map, 7, &(Record){7, 2.5});
+    ASSERT_TRUE(record->score == 2.5);
+    ASSERT_EQ(cs_int_hashmap_size(map), 1);
+
+    // Le pointeur retourné permet la mise à jour en place
+    ((Record*)cs_int_hashmap_get(map, 7))->score += 1.0;
+    ASSERT_TRUE(((Record*)cs_int_hashmap_get(map, 7))->score == 3.5);
+
+    // Réécrire une valeur avec elle-même est sans effet
+    record = cs_int_hashmap_get(map, 7);
+    ASSERT_TRUE(cs_int_hashmap_upsert(map, 7, record) == record);
+    ASSERT_TRUE(record->score == 3.5);
+
+    cs_int_hashmap_destroy(map);
+}
+
+void test_int_hashmap_remove_take(void) {
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(int));
+    for (int i = 0; i < 100; i++) cs_int_hashmap_insert(map, (uint64_t)i, &i);
+
+    for (int i = 0; i < 100; i += 2) {
+        ASSERT_EQ(cs_int_hashmap_remove(map, (uint64_t)i), CS_SUCCESS);
+    }
+    ASSERT_EQ(cs_int_hashmap_remove(map, 0), CS_NOT_FOUND);
+    ASSERT_EQ(cs_int_hashmap_size(map), 50);
+
+    int value = 0;
+    ASSERT_EQ(cs_int_hashmap_take(map, 51, &value), CS_SUCCESS);
+    ASSERT_EQ(value, 51);
+    ASSERT_FALSE(cs_int_hashmap_has(map, 51));
+    ASSERT_EQ(cs_int_hashmap_take(map, 51, &value), CS_NOT_FOUND);
+
+    size_t found = 0;
+    for (int i = 1; i < 100; i += 2) {
+        if (cs_int_hashmap_has(map, (uint64_t)i)) found++;
+    }
+    ASSERT_EQ(found, 49);
+
+    cs_int_hashmap_clear(map);
+    ASSERT_EQ(cs_int_hashmap_size(map), 0);
+    ASSERT_FALSE(cs_int_hashmap_has(map, 1));
+    ASSERT_EQ(cs_int_hashmap_insert(map, 1, &value), CS_SUCCESS);
+
+    cs_int_hashmap_destroy(map);
+}
+
+void test_int_hashmap_churn(void) {
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(uint64_t));
+    for (uint64_t i = 0; i < 4; i++) cs_int_hashmap_insert(map, i, &i);
+
+    // Insertions et suppressions répétées : les tombstones sont recyclés ou nettoyés par un rehash
+    for (uint64_t round = 0; round < 10000; round++) {
+        uint64_t key = 1000 + round;
+        cs_int_hashmap_insert(map, key, &key);
+        cs_int_hashmap_remove(map, key);
+    }
+    ASSERT_EQ(cs_int_hashmap_size(map), 4);
+    ASSERT_EQ(map->capacity, HASHMAP_DEFAULT_CAPACITY);
+    for (uint64_t i = 0; i < 4; i++) {
+        ASSERT_EQ(*(uint64_t*)cs_int_hashmap_get(map, i), i);
+    }
+
+    cs_int_hashmap_destroy(map);
+}
+
+void test_int_hashmap_next(void) {
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(uint64_t));
+    for (uint64_t i = 1; i <= 100; i++) cs_int_hashmap_insert(map, i, &i);
+    cs_int_hashmap_remove(map, 50);
+
+    size_t cursor = 0;
+    uint64_t key;
+    void* value;
+    int count = 0;
+    uint64_t sum = 0;
+    while (cs_int_hashmap_next(map, &cursor, &key, &value)) {
+        ASSERT_EQ(key, *(uint64_t*)value);
+        count++;
+        sum += key;
+    }
+    ASSERT_EQ(count, 99);
+    ASSERT_EQ(sum, 5050 - 50);
+
+    ASSERT_FALSE(cs_int_hashmap_next(NULL, &cursor, NULL, NULL));
+    cs_int_hashmap_destroy(map);
+}
+
+void test_int_hashmap_null(void) {
+    int value = 1;
+    CsIntHashMap* map = cs_int_hashmap_create(sizeof(int));
+    ASSERT_EQ(cs_int_hashmap_insert(map, 1, NULL), CS_NULL_POINTER);
+    ASSERT_NULL(cs_int_hashmap_upsert(map, 1, NULL));
+    cs_int_hashmap_destroy(map);
+
+    ASSERT_NULL(cs_int_hashmap_get(NULL, 1));
+    ASSERT_FALSE(cs_int_hashmap_has(NULL, 1));
+    ASSERT_EQ(cs_int_hashmap_insert(NULL, 1, &value), CS_NULL_POINTER);
+    ASSERT_NULL(cs_int_hashmap_upsert(NULL, 1, &value));
+    ASSERT_EQ(cs_int_hashmap_remove(NULL, 1), CS_NULL_POINTER);
+    ASSERT_EQ(cs_int_hashmap_take(NULL, 1, &value), CS_NULL_POINTER);
+    ASSERT_EQ(cs_int_hashmap_size(NULL), 0);
+    cs_int_hashmap_clear(NULL);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## INT HASHMAP TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== CREATION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_int_hashmap_create);
+
+    printf("\n" COLOR_BLUE "========== OPERATIONS ==========" COLOR_RESET "\n");
+    RUN_TEST(test_int_hashmap_insert_get);
+    RUN_TEST(test_int_hashmap_full_key_range);
+    RUN_TEST(test_int_hashmap_upsert);
+    RUN_TEST(test_int_hashmap_remove_take);
+    RUN_TEST(test_int_hashmap_churn);
+    RUN_TEST(test_int_hashmap_next);
+    RUN_TEST(test_int_hashmap_null);
+
+    TEST_SUMMARY();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,193 @@
+#include "cstash/intern_table.h"
+#include "test_framework.h"
+#include <stdio.h>
+#include <string.h>
+
+// ========================================
+// Tests de création
+// ========================================
+
+void test_intern_table_create(void) {
+    CsInternTable* table = cs_intern_table_create();
+    ASSERT_NOT_NULL(table);
+    ASSERT_EQ(cs_intern_table_size(table), 0);
+    ASSERT_EQ(table->arena_bytes, 0);
+    cs_intern_table_destroy(table);
+
+    // Index et tableau des chaînes dimensionnés d'avance : aucune croissance
+    table = cs_intern_table_create_with_capacity(1000);
+    size_t index_capacity = table->index_capacity;
+    char key[32];
+    for (size_t i = 0; i < 1000; i++) {
+        snprintf(key, sizeof(key), "host_%zu", i);
+        cs_intern_table_intern(table, key, NULL);
+    }
+    ASSERT_EQ(table->index_capacity, index_capacity);
+    ASSERT_EQ(table->strings_capacity, 1000);
+    cs_intern_table_destroy(table);
+
+    ASSERT_NULL(cs_intern_table_create_with_capacity(SIZE_MAX));
+    cs_intern_table_destroy(NULL);
+}
+
+// ========================================
+// Tests de l'interning
+// ========================================
+
+void test_intern_table_deduplicates(void) {
+    CsInternTable* table = cs_intern_table_create();
+
+    // Une autre copie de la même chaîne donne le même pointeur canonique et le même ID
+    char first[] = "api.example.com";
+    char second[] = "api.example.com";
+    CsInternId first_id;
+    CsInternId second_id;
+    const char* canonical = cs_intern_table_intern(table, first, &first_id);
+    ASSERT_NOT_NULL(canonical);
+    ASSERT_TRUE(canonical != first);
+    ASSERT_STR_EQ(canonical, "api.example.com");
+    ASSERT_TRUE(cs_intern_table_intern(table, second, &second_id) == canonical);
+    ASSERT_EQ(first_id, second_id);
+
+    CsInternId other_id;
+    const char* other = cs_intern_table_intern(table, "db.example.com", &other_id);
+    ASSERT_TRUE(other != canonical);
+    ASSERT_EQ(first_id, 0);
+    ASSERT_EQ(other_id, 1);
+    ASSERT_EQ(cs_intern_table_size(table), 2);
+
+    cs_intern_table_destroy(table);
+}
+
+void test_intern_table_stable_pointers(void) {
+    CsInternTable* table = cs_intern_table_create();
+    static const char* pointers[100000];
+    char key[32];
+
+    // Des dizaines de chunks et plusieurs croissances de l'index : les pointeurs rendus ne bougent pas
+    for (size_t i = 0; i < 100000; i++) {
+        snprintf(key, sizeof(key), "metric.name.%zu", i);
+        pointers[i] = cs_intern_table_intern(table, key, NULL);
+    }
+    ASSERT_TRUE(table->chunk_count > 10);
+
+    size_t stable = 0;
+    for (size_t i = 0; i < 100000; i++) {
+        snprintf(key, sizeof(key), "metric.name.%zu", i);
+        CsInternId id;
+        const char* canonical = cs_intern_table_intern(table, key, &id);
+        if (canonical == pointers[i] && id == i && strcmp(canonical, key) == 0) stable++;
+    }
+    ASSERT_EQ(stable, 100000);
+    ASSERT_EQ(cs_intern_table_size(table), 100000);
+
+    cs_intern_table_destroy(table);
+}
+
+void test_intern_table_get_find(void) {
+    CsInternTable* table = cs_intern_table_create();
+    CsInternId id;
+    cs_intern_table_intern(table, "alpha", NULL);
+    const char* beta = cs_intern_table_intern(table, "beta", &id);
+
+    size_t len;
+    ASSERT_TRUE(cs_intern_table_get(table, id, &len) == beta);
+    ASSERT_EQ(len, 4);
+    ASSERT_NULL(cs_intern_table_get(table, 2, NULL));
+
+    // find ne copie rien
+    CsInternId found;
+    ASSERT_TRUE(cs_intern_table_find(table, "beta", &found) == beta);
+    ASSERT_EQ(found, id);
+    ASSERT_NULL(cs_intern_table_find(table, "gamma", &found));
+    ASSERT_EQ(cs_intern_table_size(table), 2);
+
+    cs_intern_table_destroy(table);
+}
+
+void test_intern_table_binary_and_long(void) {
+    CsInternTable* table = cs_intern_table_create();
+
+    // Clés binaires et chaîne vide, la copie canonique est terminée par un NUL
+    const char* empty = cs_intern_table_intern(table, "", NULL);
+    ASSERT_STR_EQ(empty, "");
+    const char* binary = cs_intern_table_intern_n(table, "a\0b", 3, NULL);
+    ASSERT_TRUE(cs_intern_table_intern_n(table, "a\0c", 3, NULL) != binary);
+    ASSERT_TRUE(cs_intern_table_find_n(table, "a\0b", 3, NULL) == binary);
+    ASSERT_NULL(cs_intern_table_find(table, "a", NULL));
+    ASSERT_EQ(binary[3], '\0');
+
+    // Une chaîne plus longue qu'un demi-chunk a son propre chunk, le chunk courant continue de servir
+    size_t long_len = INTERN_TABLE_CHUNK_SIZE;
+    char* long_str = malloc(long_len);
+    memset(long_str, 'x', long_len);
+    size_t remaining = table->remaining;
+    const char* canonical = cs_intern_table_intern_n(table, long_str, long_len, NULL);
+    ASSERT_NOT_NULL(canonical);
+    ASSERT_EQ(memcmp(canonical, long_str, long_len), 0);
+    ASSERT_EQ(canonical[long_len], '\0');
+    ASSERT_EQ(table->remaining, remaining);
+    ASSERT_EQ(table->arena_bytes, INTERN_TABLE_CHUNK_SIZE + long_len + 1);
+    free(long_str);
+
+    cs_intern_table_destroy(table);
+}
+
+void test_intern_table_memory(void) {
+    CsInternTable* table = cs_intern_table_create_with_capacity(10000);
+    char key[32];
+    size_t bytes = 0;
+    for (size_t i = 0; i < 10000; i++) {
+        snprintf(key, sizeof(key), "host-%zu.local", i);
+        bytes += strlen(key) + 1;
+        cs_intern_table_intern(table, key, NULL);
+    }
+
+    // Les octets des chaînes sont contigus : au plus un chunk de perte
+    ASSERT_TRUE(table->arena_bytes >= bytes);
+    ASSERT_TRUE(table->arena_bytes < bytes + INTERN_TABLE_CHUNK_SIZE);
+    ASSERT_TRUE(cs_intern_table_memory(table) > table->arena_bytes);
+    ASSERT_EQ(cs_intern_table_memory(NULL), 0);
+
+    cs_intern_table_destroy(table);
+}
+
+void test_intern_table_null(void) {
+    CsInternId id;
+    ASSERT_NULL(cs_intern_table_intern(NULL, "a", &id));
+    ASSERT_NULL(cs_intern_table_intern_n(NULL, "a", 1, &id));
+    ASSERT_NULL(cs_intern_table_find(NULL, "a", &id));
+    ASSERT_NULL(cs_intern_table_get(NULL, 0, NULL));
+    ASSERT_EQ(cs_intern_table_size(NULL), 0);
+
+    CsInternTable* table = cs_intern_table_create();
+    ASSERT_NULL(cs_intern_table_intern(table, NULL, &id));
+    ASSERT_NULL(cs_intern_table_find(table, NULL, &id));
+    ASSERT_EQ(cs_intern_table_size(table), 0);
+    cs_intern_table_destroy(table);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## INTERN TABLE TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== CREATION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_intern_table_create);
+
+    printf("\n" COLOR_BLUE "========== INTERNING ==========" COLOR_RESET "\n");
+    RUN_TEST(test_intern_table_deduplicates);
+    RUN_TEST(test_intern_table_stable_pointers);
+    RUN_TEST(test_intern_table_get_find);
+    RUN_TEST(test_intern_table_binary_and_long);
+    RUN_TEST(test_intern_table_memory);
+    RUN_TEST(test_intern_table_null);
+
+    TEST_SUMMARY();
+
+    return tests_failed > 0 ? 1 : 0;
+}
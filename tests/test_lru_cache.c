@@ -0,0 +1,260 @@
+#include "cstash/lru_cache.h"
+#include "test_framework.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static CsLruCache* create_bounded(size_t max_entries) {
+    CsLruCacheOptions options = {.max_entries = max_entries};
+    return cs_lru_cache_create(sizeof(int), &options);
+}
+
+static int destroyed_values = 0;
+
+static void count_destroyed(void* value) {
+    (void)value;
+    destroyed_values++;
+}
+
+static size_t charge_value(const void* key, size_t key_len, const void* value) {
+    (void)key;
+    (void)key_len;
+    return (size_t)*(const int*)value;
+}
+
+// ========================================
+// Tests de création
+// ========================================
+
+void test_lru_cache_create(void) {
+    CsLruCache* cache = create_bounded(4);
+    ASSERT_NOT_NULL(cache);
+    ASSERT_EQ(cs_lru_cache_size(cache), 0);
+    ASSERT_EQ(cs_lru_cache_hit_rate(cache), 0);
+
+    // Les liens ne décalent pas la valeur : elle reste alignée sur 16 octets comme dans un CsHashMap
+    cs_lru_cache_put(cache, "a", &(int){1});
+    ASSERT_EQ((uintptr_t)cs_lru_cache_peek(cache, "a") % 16, 0);
+    cs_lru_cache_destroy(cache);
+
+    // Une borne au moins, et une taille de valeur non nulle
+    CsLruCacheOptions unbounded = {0};
+    ASSERT_NULL(cs_lru_cache_create(sizeof(int), &unbounded));
+    ASSERT_NULL(cs_lru_cache_create(sizeof(int), NULL));
+    ASSERT_NULL(create_bounded(0));
+    CsLruCacheOptions options = {.max_entries = 4};
+    ASSERT_NULL(cs_lru_cache_create(0, &options));
+    cs_lru_cache_destroy(NULL);
+}
+
+// ========================================
+// Tests de l'éviction
+// ========================================
+
+void test_lru_cache_evicts_least_recent(void) {
+    CsLruCache* cache = create_bounded(3);
+    cs_lru_cache_put(cache, "a", &(int){1});
+    cs_lru_cache_put(cache, "b", &(int){2});
+    cs_lru_cache_put(cache, "c", &(int){3});
+
+    // "a" redevient le plus récent : "b" part à la place
+    ASSERT_EQ(*(int*)cs_lru_cache_get(cache, "a"), 1);
+    ASSERT_EQ(cs_lru_cache_put(cache, "d", &(int){4}), CS_SUCCESS);
+    ASSERT_EQ(cs_lru_cache_size(cache), 3);
+    ASSERT_NULL(cs_lru_cache_peek(cache, "b"));
+    ASSERT_NOT_NULL(cs_lru_cache_peek(cache, "a"));
+    ASSERT_EQ(cache->evictions, 1);
+
+    // peek ne change pas l'ordre : "c" reste le plus ancien
+    cs_lru_cache_peek(cache, "c");
+    cs_lru_cache_put(cache, "e", &(int){5});
+    ASSERT_NULL(cs_lru_cache_peek(cache, "c"));
+    ASSERT_STR_EQ(cache->head->key, "e");
+    ASSERT_STR_EQ(cache->tail->key, "a");
+
+    cs_lru_cache_destroy(cache);
+}
+
+void test_lru_cache_overwrite(void) {
+    CsLruCache* cache = create_bounded(2);
+    cs_lru_cache_put(cache, "a", &(int){1});
+    cs_lru_cache_put(cache, "b", &(int){2});
+
+    // Réécrire "a" le rend le plus récent sans éviction
+    ASSERT_EQ(cs_lru_cache_put(cache, "a", &(int){10}), CS_SUCCESS);
+    ASSERT_EQ(cs_lru_cache_size(cache), 2);
+    ASSERT_EQ(cache->evictions, 0);
+    cs_lru_cache_put(cache, "c", &(int){3});
+    ASSERT_EQ(*(int*)cs_lru_cache_peek(cache, "a"), 10);
+    ASSERT_NULL(cs_lru_cache_peek(cache, "b"));
+
+    // La valeur passée peut venir de l'entrée qui va être évincée
+    int* oldest = cs_lru_cache_peek(cache, "a");
+    cs_lru_cache_get(cache, "c");
+    ASSERT_EQ(cs_lru_cache_put(cache, "d", oldest), CS_SUCCESS);
+    ASSERT_EQ(*(int*)cs_lru_cache_peek(cache, "d"), 10);
+    ASSERT_NULL(cs_lru_cache_peek(cache, "a"));
+
+    cs_lru_cache_destroy(cache);
+}
+
+void test_lru_cache_byte_budget(void) {
+    CsLruCacheOptions options = {.max_bytes = 100, .charge = charge_value};
+    CsLruCache* cache = cs_lru_cache_create(sizeof(int), &options);
+
+    cs_lru_cache_put(cache, "a", &(int){40});
+    cs_lru_cache_put(cache, "b", &(int){40});
+    ASSERT_EQ(cache->bytes, 80);
+
+    // 80 + 30 > 100 : "a" est évincé pour faire de la place
+    cs_lru_cache_put(cache, "c", &(int){30});
+    ASSERT_EQ(cache->bytes, 70);
+    ASSERT_NULL(cs_lru_cache_peek(cache, "a"));
+
+    // Une entrée trop grande à elle seule est refusée sans rien évincer
+    ASSERT_EQ(cs_lru_cache_put(cache, "huge", &(int){101}), CS_OUT_OF_BOUNDS);
+    ASSERT_EQ(cs_lru_cache_size(cache), 2);
+
+    // Une réécriture plus lourde évince les autres entrées si besoin
+    cs_lru_cache_put(cache, "c", &(int){90});
+    ASSERT_EQ(cache->bytes, 90);
+    ASSERT_EQ(cs_lru_cache_size(cache), 1);
+
+    cs_lru_cache_destroy(cache);
+
+    // Charge par défaut : longueur de la clé + taille de la valeur
+    CsLruCacheOptions default_charge = {.max_bytes = 3 * (2 + sizeof(int))};
+    cache = cs_lru_cache_create(sizeof(int), &default_charge);
+    char key[32];
+    for (int i = 10; i < 20; i++) {
+        snprintf(key, sizeof(key), "%d", i);
+        cs_lru_cache_put(cache, key, &i);
+    }
+    ASSERT_EQ(cs_lru_cache_size(cache), 3);
+    ASSERT_EQ(cache->evictions, 7);
+    cs_lru_cache_destroy(cache);
+}
+
+// ========================================
+// Tests des compteurs et du destructeur
+// ========================================
+
+void test_lru_cache_stats(void) {
+    CsLruCache* cache = create_bounded(100);
+    char key[32];
+    for (int i = 0; i < 200; i++) {
+        snprintf(key, sizeof(key), "key_%d", i);
+        cs_lru_cache_put(cache, key, &i);
+    }
+    ASSERT_EQ(cache->evictions, 100);
+
+    // Les 100 dernières clés sont présentes, les 100 premières évincées
+    for (int i = 0; i < 200; i++) {
+        snprintf(key, sizeof(key), "key_%d", i);
+        int* value = cs_lru_cache_get(cache, key);
+        if (value) ASSERT_EQ(*value, i);
+    }
+    ASSERT_EQ(cache->hits, 100);
+    ASSERT_EQ(cache->misses, 100);
+    ASSERT_EQ(cs_lru_cache_hit_rate(cache), 0.5);
+
+    cs_lru_cache_reset_stats(cache);
+    ASSERT_EQ(cache->hits + cache->misses + cache->evictions, 0);
+
+    cs_lru_cache_clear(cache);
+    ASSERT_EQ(cs_lru_cache_size(cache), 0);
+    ASSERT_NULL(cache->head);
+    ASSERT_EQ(cs_lru_cache_put(cache, "again", &(int){1}), CS_SUCCESS);
+
+    cs_lru_cache_destroy(cache);
+}
+
+void test_lru_cache_destructor(void) {
+    CsLruCacheOptions options = {.max_entries = 2, .destructor = count_destroyed};
+    CsLruCache* cache = cs_lru_cache_create(sizeof(int), &options);
+    destroyed_values = 0;
+
+    cs_lru_cache_put(cache, "a", &(int){1});
+    cs_lru_cache_put(cache, "b", &(int){2});
+    cs_lru_cache_put(cache, "c", &(int){3}); // éviction de "a"
+    ASSERT_EQ(destroyed_values, 1);
+    cs_lru_cache_put(cache, "c", &(int){4}); // réécriture
+    ASSERT_EQ(destroyed_values, 2);
+    ASSERT_EQ(cs_lru_cache_remove(cache, "b"), CS_SUCCESS);
+    ASSERT_EQ(cs_lru_cache_remove(cache, "b"), CS_NOT_FOUND);
+    ASSERT_EQ(destroyed_values, 3);
+
+    cs_lru_cache_destroy(cache);
+    ASSERT_EQ(destroyed_values, 4);
+}
+
+static void free_owned(void* value) {
+    free(*(char**)value);
+    destroyed_values++;
+}
+
+void test_lru_cache_put_own_value(void) {
+    CsLruCacheOptions options = {.max_entries = 2, .destructor = free_owned};
+    CsLruCache* cache = cs_lru_cache_create(sizeof(char*), &options);
+    destroyed_values = 0;
+
+    char* owned = malloc(8);
+    cs_lru_cache_put(cache, "a", &owned);
+    cs_lru_cache_put(cache, "b", &(char*){malloc(8)});
+
+    // Réinsérer la valeur stockée elle-même ne la détruit pas, mais rend "a" le plus récent
+    ASSERT_EQ(cs_lru_cache_put(cache, "a", cs_lru_cache_get(cache, "a")), CS_SUCCESS);
+    ASSERT_EQ(destroyed_values, 0);
+    ASSERT_TRUE(*(char**)cs_lru_cache_peek(cache, "a") == owned);
+    ASSERT_STR_EQ(cache->head->key, "a");
+
+    cs_lru_cache_destroy(cache);
+    ASSERT_EQ(destroyed_values, 2);
+}
+
+void test_lru_cache_null(void) {
+    ASSERT_NULL(cs_lru_cache_get(NULL, "a"));
+    ASSERT_NULL(cs_lru_cache_peek(NULL, "a"));
+    ASSERT_EQ(cs_lru_cache_put(NULL, "a", &(int){1}), CS_NULL_POINTER);
+    ASSERT_EQ(cs_lru_cache_remove(NULL, "a"), CS_NULL_POINTER);
+    ASSERT_EQ(cs_lru_cache_size(NULL), 0);
+    ASSERT_EQ(cs_lru_cache_hit_rate(NULL), 0);
+    cs_lru_cache_clear(NULL);
+    cs_lru_cache_reset_stats(NULL);
+
+    CsLruCache* cache = create_bounded(2);
+    ASSERT_EQ(cs_lru_cache_put(cache, NULL, &(int){1}), CS_NULL_POINTER);
+    ASSERT_EQ(cs_lru_cache_put(cache, "a", NULL), CS_NULL_POINTER);
+    ASSERT_NULL(cs_lru_cache_get(cache, NULL));
+    ASSERT_EQ(cache->misses, 0);
+    cs_lru_cache_destroy(cache);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## LRU CACHE TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== CREATION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_lru_cache_create);
+
+    printf("\n" COLOR_BLUE "========== EVICTION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_lru_cache_evicts_least_recent);
+    RUN_TEST(test_lru_cache_overwrite);
+    RUN_TEST(test_lru_cache_byte_budget);
+
+    printf("\n" COLOR_BLUE "========== STATS & DESTRUCTOR ==========" COLOR_RESET "\n");
+    RUN_TEST(test_lru_cache_stats);
+    RUN_TEST(test_lru_cache_destructor);
+    RUN_TEST(test_lru_cache_put_own_value);
+    RUN_TEST(test_lru_cache_null);
+
+    TEST_SUMMARY();
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,321 @@
+// pthread_t n'est pas exposé en -std=c99 strict sans cela
+#define _POSIX_C_SOURCE 200112L
+
+#include "cstash/s3fifo_cache.h"
+#include "test_framework.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define THREADS 4
+
+static CsS3FifoCache* create_bounded(size_t max_entries) {
+    CsS3FifoCacheOptions options = {.max_entries = max_entries};
+    return cs_s3fifo_cache_create(sizeof(int), &options);
+}
+
+static void put_key(CsS3FifoCache* cache, const char* prefix, int i) {
+    char key[32];
+    snprintf(key, sizeof(key), "%s_%d", prefix, i);
+    cs_s3fifo_cache_put(cache, key, &i);
+}
+
+static void* get_key(CsS3FifoCache* cache, const char* prefix, int i) {
+    char key[32];
+    snprintf(key, sizeof(key), "%s_%d", prefix, i);
+    return cs_s3fifo_cache_get(cache, key);
+}
+
+static int destroyed_values = 0;
+
+static void count_destroyed(void* value) {
+    (void)value;
+    destroyed_values++;
+}
+
+// ========================================
+// Tests de création
+// ========================================
+
+void test_s3fifo_cache_create(void) {
+    CsS3FifoCache* cache = create_bounded(100);
+    ASSERT_NOT_NULL(cache);
+    ASSERT_EQ(cs_s3fifo_cache_size(cache), 0);
+    ASSERT_EQ(cache->small_capacity, 10);
+    ASSERT_EQ(cache->ghost_capacity, 90);
+    // La valeur suit les liens de file et garde l'alignement de 16 octets des entrées
+    ASSERT_EQ(cs_s3fifo_cache_put(cache, "a", &(int){1}), CS_SUCCESS);
+    ASSERT_EQ((uintptr_t)cs_s3fifo_cache_lookup(cache, "a") % 16, 0);
+    cs_s3fifo_cache_destroy(cache);
+
+    // La file small garde au moins une entrée
+    cache = create_bounded(1);
+    ASSERT_NOT_NULL(cache);
+    ASSERT_EQ(cache->small_capacity, 1);
+    ASSERT_EQ(cs_s3fifo_cache_put(cache, "a", &(int){1}), CS_SUCCESS);
+    ASSERT_EQ(cs_s3fifo_cache_put(cache, "b", &(int){2}), CS_SUCCESS);
+    ASSERT_EQ(cs_s3fifo_cache_size(cache), 1);
+    cs_s3fifo_cache_destroy(cache);
+
+    CsS3FifoCacheOptions bad_fraction = {.max_entries = 10, .small_fraction = 1.5};
+    ASSERT_NULL(cs_s3fifo_cache_create(sizeof(int), &bad_fraction));
+    CsS3FifoCacheOptions unbounded = {0};
+    ASSERT_NULL(cs_s3fifo_cache_create(sizeof(int), &unbounded));
+    ASSERT_NULL(cs_s3fifo_cache_create(sizeof(int), NULL));
+    CsS3FifoCacheOptions options = {.max_entries = 4};
+    ASSERT_NULL(cs_s3fifo_cache_create(0, &options));
+    cs_s3fifo_cache_destroy(NULL);
+}
+
+// ========================================
+// Tests de l'éviction
+// ========================================
+
+void test_s3fifo_cache_small_queue(void) {
+    CsS3FifoCache* cache = create_bounded(10);
+    for (int i = 0; i < 10; i++) put_key(cache, "key", i);
+    ASSERT_EQ(cache->small.size, 10);
+    ASSERT_EQ(cache->main.size, 0);
+
+    // key_0 a servi : il passe dans main au lieu d'être évincé, key_1 part à sa place
+    ASSERT_NOT_NULL(get_key(cache, "key", 0));
+    put_key(cache, "key", 10);
+    ASSERT_EQ(cs_s3fifo_cache_size(cache), 10);
+    ASSERT_EQ(cache->evictions, 1);
+    ASSERT_EQ(cache->main.size, 1);
+    ASSERT_NOT_NULL(get_key(cache, "key", 0));
+    ASSERT_NULL(get_key(cache, "key", 1));
+
+    // Un succès ne touche pas aux files, seulement au compteur d'accès de l'entrée
+    CsHashMapEntry* oldest = cache->small.oldest;
+    for (int i = 0; i < 10; i++) get_key(cache, "key", 5);
+    ASSERT_TRUE(cache->small.oldest == oldest);
+
+    cs_s3fifo_cache_destroy(cache);
+}
+
+void test_s3fifo_cache_scan_resistance(void) {
+    CsS3FifoCache* cache = create_bounded(100);
+    for (int i = 0; i < 50; i++) put_key(cache, "hot", i);
+    for (int i = 0; i < 50; i++) get_key(cache, "hot", i);
+
+    // Un parcours de 1000 clés lues une seule fois ne chasse aucune clé chaude
+    for (int i = 0; i < 1000; i++) {
+        if (!get_key(cache, "scan", i)) put_key(cache, "scan", i);
+    }
+    ASSERT_EQ(cs_s3fifo_cache_size(cache), 100);
+    ASSERT_EQ(cache->main.size, 50);
+    for (int i = 0; i < 50; i++) ASSERT_NOT_NULL(get_key(cache, "hot", i));
+
+    cs_s3fifo_cache_destroy(cache);
+}
+
+void test_s3fifo_cache_ghosts(void) {
+    CsS3FifoCache* cache = create_bounded(10);
+    for (int i = 0; i < 11; i++) put_key(cache, "key", i);
+
+    // key_0 est sorti de small sans servir, son fantôme le renvoie directement dans main
+    ASSERT_NULL(get_key(cache, "key", 0));
+    ASSERT_EQ(cs_int_hashmap_size(cache->ghosts), 1);
+    put_key(cache, "key", 0);
+    ASSERT_EQ(cache->main.size, 1);
+    ASSERT_EQ(cs_int_hashmap_size(cache->ghosts), 1); // key_1 évincé à son tour
+
+    // Il y a autant de fantômes que d'entrées dans main, les plus anciens sont oubliés
+    for (int i = 100; i < 200; i++) put_key(cache, "key", i);
+    ASSERT_EQ(cs_int_hashmap_size(cache->ghosts), cache->ghost_capacity);
+    put_key(cache, "key", 1);
+    ASSERT_EQ(cache->small.size, 9);
+
+    cs_s3fifo_cache_destroy(cache);
+}
+
+// ========================================
+// Tests des compteurs et du destructeur
+// ========================================
+
+void test_s3fifo_cache_stats(void) {
+    CsS3FifoCache* cache = create_bounded(100);
+    for (int i = 0; i < 200; i++) put_key(cache, "key", i);
+    ASSERT_EQ(cache->evictions, 100);
+
+    // Sans accès, S3-FIFO se comporte comme une FIFO : les 100 dernières clés restent
+    for (int i = 0; i < 200; i++) {
+        int* value = get_key(cache, "key", i);
+        if (value) ASSERT_EQ(*value, i);
+    }
+    ASSERT_EQ(cache->hits, 100);
+    ASSERT_EQ(cache->misses, 100);
+    ASSERT_EQ(cs_s3fifo_cache_hit_rate(cache), 0.5);
+
+    // lookup compte l'accès mais pas le succès
+    ASSERT_NOT_NULL(cs_s3fifo_cache_lookup(cache, "key_199"));
+    ASSERT_TRUE(cs_s3fifo_cache_contains(cache, "key_199"));
+    ASSERT_FALSE(cs_s3fifo_cache_contains(cache, "key_0"));
+    ASSERT_EQ(cache->hits, 100);
+
+    cs_s3fifo_cache_reset_stats(cache);
+    ASSERT_EQ(cache->hits + cache->misses + cache->evictions, 0);
+
+    cs_s3fifo_cache_clear(cache);
+    ASSERT_EQ(cs_s3fifo_cache_size(cache), 0);
+    ASSERT_EQ(cs_int_hashmap_size(cache->ghosts), 0);
+    ASSERT_NULL(cache->small.oldest);
+    ASSERT_EQ(cs_s3fifo_cache_put(cache, "again", &(int){1}), CS_SUCCESS);
+
+    cs_s3fifo_cache_destroy(cache);
+}
+
+void test_s3fifo_cache_destructor(void) {
+    CsS3FifoCacheOptions options = {.max_entries = 2, .destructor = count_destroyed};
+    CsS3FifoCache* cache = cs_s3fifo_cache_create(sizeof(int), &options);
+    destroyed_values = 0;
+
+    cs_s3fifo_cache_put(cache, "a", &(int){1});
+    cs_s3fifo_cache_put(cache, "b", &(int){2});
+    cs_s3fifo_cache_put(cache, "c", &(int){3}); // éviction de "a"
+    ASSERT_EQ(destroyed_values, 1);
+    cs_s3fifo_cache_put(cache, "c", &(int){4}); // réécriture
+    ASSERT_EQ(destroyed_values, 2);
+    ASSERT_EQ(*(int*)cs_s3fifo_cache_lookup(cache, "c"), 4);
+    ASSERT_EQ(cs_s3fifo_cache_remove(cache, "b"), CS_SUCCESS);
+    ASSERT_EQ(cs_s3fifo_cache_remove(cache, "b"), CS_NOT_FOUND);
+    ASSERT_EQ(destroyed_values, 3);
+
+    cs_s3fifo_cache_destroy(cache);
+    ASSERT_EQ(destroyed_values, 4);
+}
+
+static void free_owned(void* value) {
+    free(*(char**)value);
+    destroyed_values++;
+}
+
+void test_s3fifo_cache_put_own_value(void) {
+    CsS3FifoCacheOptions options = {.max_entries = 2, .destructor = free_owned};
+    CsS3FifoCache* cache = cs_s3fifo_cache_create(sizeof(char*), &options);
+    destroyed_values = 0;
+
+    char* owned = malloc(8);
+    cs_s3fifo_cache_put(cache, "a", &owned);
+
+    // Réinsérer la valeur stockée elle-même ne la détruit pas
+    ASSERT_EQ(cs_s3fifo_cache_put(cache, "a", cs_s3fifo_cache_get(cache, "a")), CS_SUCCESS);
+    ASSERT_EQ(destroyed_values, 0);
+    ASSERT_TRUE(*(char**)cs_s3fifo_cache_lookup(cache, "a") == owned);
+
+    cs_s3fifo_cache_destroy(cache);
+    ASSERT_EQ(destroyed_values, 1);
+}
+
+void test_s3fifo_cache_binary_keys(void) {
+    CsS3FifoCache* cache = create_bounded(4);
+    ASSERT_EQ(cs_s3fifo_cache_put_n(cache, "a\0b", 3, &(int){1}), CS_SUCCESS);
+    ASSERT_EQ(cs_s3fifo_cache_put_n(cache, "a\0c", 3, &(int){2}), CS_SUCCESS);
+
+    ASSERT_TRUE(cs_s3fifo_cache_contains_n(cache, "a\0b", 3));
+    ASSERT_FALSE(cs_s3fifo_cache_contains(cache, "a"));
+    ASSERT_EQ(*(int*)cs_s3fifo_cache_get_n(cache, "a\0c", 3), 2);
+    ASSERT_EQ(cs_s3fifo_cache_remove_n(cache, "a\0b", 3), CS_SUCCESS);
+    ASSERT_EQ(cs_s3fifo_cache_remove_n(cache, "a\0b", 3), CS_NOT_FOUND);
+    ASSERT_FALSE(cs_s3fifo_cache_contains_n(cache, "a\0b", 3));
+    ASSERT_EQ(cs_s3fifo_cache_size(cache), 1);
+    ASSERT_EQ(cache->small.size, 1);
+
+    cs_s3fifo_cache_destroy(cache);
+}
+
+// ========================================
+// Tests de lecture concurrente
+// ========================================
+
+static void* lookup_worker(void* arg) {
+    CsS3FifoCache* cache = arg;
+    char key[32];
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 64; i++) {
+            snprintf(key, sizeof(key), "key_%d", i);
+            int* value = cs_s3fifo_cache_lookup(cache, key);
+            if (!value || *value != i) return (void*)1;
+        }
+    }
+    return NULL;
+}
+
+void test_s3fifo_cache_concurrent_lookup(void) {
+    CsS3FifoCache* cache = create_bounded(64);
+    for (int i = 0; i < 64; i++) put_key(cache, "key", i);
+    CsHashMapEntry* oldest = cache->small.oldest;
+
+    pthread_t threads[THREADS];
+    for (int t = 0; t < THREADS; t++) pthread_create(&threads[t], NULL, lookup_worker, cache);
+    for (int t = 0; t < THREADS; t++) {
+        void* failed = NULL;
+        pthread_join(threads[t], &failed);
+        ASSERT_NULL(failed);
+    }
+
+    // Les lecteurs n'ont écrit que les compteurs d'accès, saturés
+    ASSERT_TRUE(cache->small.oldest == oldest);
+    ASSERT_EQ(cache->hits, 0);
+    for (CsHashMapEntry* entry = cache->small.oldest; entry; entry = ((CsS3FifoLinks*)entry->data)->newer) {
+        ASSERT_EQ(((CsS3FifoLinks*)entry->data)->freq, S3FIFO_MAX_FREQ);
+    }
+
+    cs_s3fifo_cache_destroy(cache);
+}
+
+void test_s3fifo_cache_null(void) {
+    ASSERT_NULL(cs_s3fifo_cache_get(NULL, "a"));
+    ASSERT_NULL(cs_s3fifo_cache_lookup(NULL, "a"));
+    ASSERT_FALSE(cs_s3fifo_cache_contains(NULL, "a"));
+    ASSERT_EQ(cs_s3fifo_cache_put(NULL, "a", &(int){1}), CS_NULL_POINTER);
+    ASSERT_EQ(cs_s3fifo_cache_remove(NULL, "a"), CS_NULL_POINTER);
+    ASSERT_EQ(cs_s3fifo_cache_remove_n(NULL, "a", 1), CS_NULL_POINTER);
+    ASSERT_FALSE(cs_s3fifo_cache_contains_n(NULL, "a", 1));
+    ASSERT_EQ(cs_s3fifo_cache_size(NULL), 0);
+    ASSERT_EQ(cs_s3fifo_cache_hit_rate(NULL), 0);
+    cs_s3fifo_cache_clear(NULL);
+    cs_s3fifo_cache_reset_stats(NULL);
+
+    CsS3FifoCache* cache = create_bounded(2);
+    ASSERT_EQ(cs_s3fifo_cache_put(cache, NULL, &(int){1}), CS_NULL_POINTER);
+    ASSERT_EQ(cs_s3fifo_cache_put(cache, "a", NULL), CS_NULL_POINTER);
+    ASSERT_NULL(cs_s3fifo_cache_get(cache, NULL));
+    ASSERT_EQ(cache->misses, 0);
+    cs_s3fifo_cache_destroy(cache);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(void) {
+    TEST_INIT();
+
+    printf("\n" COLOR_MAGENTA "########## S3-FIFO CACHE TESTS ##########" COLOR_RESET "\n");
+
+    printf("\n" COLOR_BLUE "========== CREATION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_s3fifo_cache_create);
+
+    printf("\n" COLOR_BLUE "========== EVICTION ==========" COLOR_RESET "\n");
+    RUN_TEST(test_s3fifo_cache_small_queue);
+    RUN_TEST(test_s3fifo_cache_scan_resistance);
+    RUN_TEST(test_s3fifo_cache_ghosts);
+
+    printf("\n" COLOR_BLUE "========== STATS & DESTRUCTOR ==========" COLOR_RESET "\n");
+    RUN_TEST(test_s3fifo_cache_stats);
+    RUN_TEST(test_s3fifo_cache_destructor);
+    RUN_TEST(test_s3fifo_cache_put_own_value);
+    RUN_TEST(test_s3fifo_cache_binary_keys);
+
+    printf("\n" COLOR_BLUE "========== CONCURRENCY ==========" COLOR_RESET "\n");
+    RUN_TEST(test_s3fifo_cache_concurrent_lookup);
+    RUN_TEST(test_s3fifo_cache_null);
+
+    TEST_SUMMARY();
+
+    return tests_failed > 0 ? 1 : 0;
+}